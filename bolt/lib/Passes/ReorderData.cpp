@@ -16,6 +16,7 @@
 // - estimate temporal locality by looking at CFG?
 
 #include "bolt/Passes/ReorderData.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/MapVector.h"
 #include <algorithm>
 
@@ -100,6 +101,21 @@ namespace {
 
 static constexpr uint16_t MinAlignment = 16;
 
+// Granularities used to estimate the cache and TLB footprint of hot data.
+static constexpr uint64_t CacheLineSize = 64;
+static constexpr uint64_t PageSize = 4096;
+
+/// Count the distinct \p Unit sized blocks that the [Start, Start + Size)
+/// ranges in \p Ranges touch.
+uint64_t countSpannedUnits(ArrayRef<std::pair<uint64_t, uint64_t>> Ranges,
+                           uint64_t Unit) {
+  DenseSet<uint64_t> Units;
+  for (const auto &[Start, Size] : Ranges)
+    for (uint64_t U = Start / Unit, E = (Start + Size - 1) / Unit; U <= E; ++U)
+      Units.insert(U);
+  return Units.size();
+}
+
 bool isSupported(const BinarySection &BS) { return BS.isData() && !BS.isTLS(); }
 
 bool filterSymbol(const BinaryData *BD) {
@@ -338,6 +354,8 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
   unsigned NumReordered = 0;
   uint64_t Offset = 0;
   uint64_t Count = 0;
+  // Input and output ranges of the objects that have memory events.
+  std::vector<std::pair<uint64_t, uint64_t>> OldHotRanges, NewHotRanges;
 
   // Get the total count just for stats
   uint64_t TotalCount = 0;
@@ -389,6 +407,11 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
       }
     }
 
+    if (Begin->second && BD->getSize()) {
+      OldHotRanges.emplace_back(BD->getAddress(), BD->getSize());
+      NewHotRanges.emplace_back(Offset, BD->getSize());
+    }
+
     Offset += BD->getSize();
     Count += Begin->second;
     NewOrder.push_back(BD);
@@ -399,6 +422,14 @@ void ReorderData::setSectionOrder(BinaryContext &BC,
   BC.outs() << "BOLT-INFO: reorder-data: " << Count << "/" << TotalCount
             << format(" (%.1f%%)", 100.0 * Count / TotalCount) << " events, "
             << Offset << " hot bytes\n";
+  // The estimate for the new layout assumes the output section starts on a
+  // page boundary.
+  BC.outs() << "BOLT-INFO: reorder-data: hot objects span "
+            << countSpannedUnits(OldHotRanges, CacheLineSize) << " -> "
+            << countSpannedUnits(NewHotRanges, CacheLineSize)
+            << " cache lines, " << countSpannedUnits(OldHotRanges, PageSize)
+            << " -> " << countSpannedUnits(NewHotRanges, PageSize)
+            << " pages\n";
 }
 
 bool ReorderData::markUnmoveableSymbols(BinaryContext &BC,
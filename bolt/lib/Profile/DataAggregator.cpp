@@ -1409,6 +1409,11 @@ uint64_t DataAggregator::parseLBRSample(const PerfBranchSample &Sample,
   // LBRs are stored in reverse execution order. NextPC refers to the next
   // recorded executed PC.
   uint64_t NextPC = opts::UseEventPC ? Sample.PC : 0;
+  // Function lookups dominate aggregation time. Each address is looked up
+  // once: the function containing NextPC is carried over from the previous
+  // entry, where NextPC was that entry's From address.
+  const BinaryFunction *NextFunc =
+      NextPC ? getBinaryFunctionContainingAddress(NextPC) : nullptr;
   uint32_t NumEntry = 0;
   for (const LBREntry &LBR : Sample.LBR) {
     ++NumEntry;
@@ -1420,12 +1425,14 @@ uint64_t DataAggregator::parseLBRSample(const PerfBranchSample &Sample,
     // chronological order)
     if (NeedsSkylakeFix && NumEntry <= 2)
       continue;
+    const BinaryFunction *FromFunc =
+        getBinaryFunctionContainingAddress(LBR.From);
+    const BinaryFunction *ToFunc = getBinaryFunctionContainingAddress(LBR.To);
     if (NextPC) {
       // Record fall-through trace.
       const uint64_t TraceFrom = LBR.To;
       const uint64_t TraceTo = NextPC;
-      const BinaryFunction *TraceBF =
-          getBinaryFunctionContainingAddress(TraceFrom);
+      const BinaryFunction *TraceBF = ToFunc;
       if (TraceBF && TraceBF->containsAddress(TraceTo)) {
         FTInfo &Info = FallthroughLBRs[Trace(TraceFrom, TraceTo)];
         if (TraceBF->containsAddress(LBR.From))
@@ -1433,9 +1440,7 @@ uint64_t DataAggregator::parseLBRSample(const PerfBranchSample &Sample,
         else
           ++Info.ExternCount;
       } else {
-        const BinaryFunction *ToFunc =
-            getBinaryFunctionContainingAddress(TraceTo);
-        if (TraceBF && ToFunc) {
+        if (TraceBF && NextFunc) {
           LLVM_DEBUG({
             dbgs() << "Invalid trace starting in " << TraceBF->getPrintName()
                    << formatv(" @ {0:x}", TraceFrom - TraceBF->getAddress())
@@ -1444,14 +1449,14 @@ uint64_t DataAggregator::parseLBRSample(const PerfBranchSample &Sample,
           ++NumInvalidTraces;
         } else {
           LLVM_DEBUG({
+            const uint64_t FromBase = TraceBF ? TraceBF->getAddress() : 0;
+            const uint64_t ToBase = NextFunc ? NextFunc->getAddress() : 0;
             dbgs() << "Out of range trace starting in "
                    << (TraceBF ? TraceBF->getPrintName() : "None")
-                   << formatv(" @ {0:x}",
-                              TraceFrom - (TraceBF ? TraceBF->getAddress() : 0))
+                   << formatv(" @ {0:x}", TraceFrom - FromBase)
                    << " and ending in "
-                   << (ToFunc ? ToFunc->getPrintName() : "None")
-                   << formatv(" @ {0:x}\n",
-                              TraceTo - (ToFunc ? ToFunc->getAddress() : 0));
+                   << (NextFunc ? NextFunc->getPrintName() : "None")
+                   << formatv(" @ {0:x}\n", TraceTo - ToBase);
           });
           ++NumLongRangeTraces;
         }
@@ -1459,9 +1464,10 @@ uint64_t DataAggregator::parseLBRSample(const PerfBranchSample &Sample,
       ++NumTraces;
     }
     NextPC = LBR.From;
+    NextFunc = FromFunc;
 
-    uint64_t From = getBinaryFunctionContainingAddress(LBR.From) ? LBR.From : 0;
-    uint64_t To = getBinaryFunctionContainingAddress(LBR.To) ? LBR.To : 0;
+    uint64_t From = FromFunc ? LBR.From : 0;
+    uint64_t To = ToFunc ? LBR.To : 0;
     if (!From && !To)
       continue;
     TakenBranchInfo &Info = BranchLBRs[Trace(From, To)];
@@ -8,11 +8,20 @@
 
 #include "index/Background.h"
 #include "support/Logger.h"
+#include "support/Trace.h"
 #include <optional>
 
 namespace clang {
 namespace clangd {
 
+// Number of tasks waiting in the queue and being run by workers.
+static constexpr trace::Metric QueueSize("background_queue_size",
+                                         trace::Metric::Value, "state");
+// Time spent running each background task, in milliseconds.
+static constexpr trace::Metric TaskLatency("background_task_latency",
+                                           trace::Metric::Distribution,
+                                           "task");
+
 static std::atomic<bool> PreventStarvation = {false};
 
 void BackgroundQueue::preventThreadStarvationInTests() {
@@ -40,7 +49,12 @@ void BackgroundQueue::work(std::function<void()> OnIdle) {
     if (Task->ThreadPri != llvm::ThreadPriority::Default &&
         !PreventStarvation.load())
       llvm::set_thread_priority(Task->ThreadPri);
-    Task->Run();
+    {
+      trace::Span Tracer("BackgroundTask", TaskLatency);
+      SPAN_ATTACH(Tracer, "Tag", Task->Tag);
+      SPAN_ATTACH(Tracer, "Priority", static_cast<int64_t>(Task->QueuePri));
+      Task->Run();
+    }
     if (Task->ThreadPri != llvm::ThreadPriority::Default)
       llvm::set_thread_priority(llvm::ThreadPriority::Default);
 
@@ -143,6 +157,8 @@ bool BackgroundQueue::blockUntilIdleForTest(
 void BackgroundQueue::notifyProgress() const {
   dlog("Queue: {0}/{1} ({2} active). Last idle at {3}", Stat.Completed,
        Stat.Enqueued, Stat.Active, Stat.LastIdle);
+  QueueSize.record(Queue.size(), "queued");
+  QueueSize.record(Stat.Active, "active");
   if (OnProgress)
     OnProgress(Stat);
 }
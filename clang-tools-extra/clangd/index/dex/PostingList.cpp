@@ -98,11 +98,21 @@ private:
   }
 
   /// Advances CurrentChunk to the chunk which might contain ID.
+  ///
+  /// Gallops forward from the current chunk before binary searching, so the
+  /// cost is logarithmic in the distance skipped rather than in the number of
+  /// remaining chunks. Intersections mostly make short jumps.
   void advanceToChunk(DocID ID) {
     if ((CurrentChunk != Chunks.end() - 1) &&
         ((CurrentChunk + 1)->Head <= ID)) {
+      auto First = CurrentChunk + 1;
+      size_t Remaining = Chunks.end() - First;
+      size_t Bound = 1;
+      while (Bound < Remaining && First[Bound].Head <= ID)
+        Bound *= 2;
       CurrentChunk =
-          std::partition_point(CurrentChunk + 1, Chunks.end(),
+          std::partition_point(First + Bound / 2,
+                               First + std::min(Bound, Remaining),
                                [&](const Chunk &C) { return C.Head < ID; });
       --CurrentChunk;
       DecompressedChunk = CurrentChunk->decompress();
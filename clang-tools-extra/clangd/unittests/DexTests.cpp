@@ -65,6 +65,29 @@ TEST(DexIterators, DocumentIterator) {
   EXPECT_TRUE(DocIterator->reachedEnd());
 }
 
+TEST(DexIterators, DocumentIteratorManyChunks) {
+  std::vector<DocID> Docs;
+  for (DocID I = 0; I < 100000; I += 3)
+    Docs.push_back(I);
+  const PostingList L(Docs);
+  auto DocIterator = L.iterator();
+
+  // Short jumps within and across neighbouring chunks.
+  for (DocID Target : {1u, 2u, 3u, 100u, 101u, 300u, 1000u}) {
+    DocIterator->advanceTo(Target);
+    ASSERT_FALSE(DocIterator->reachedEnd());
+    EXPECT_EQ(DocIterator->peek(), (Target + 2) / 3 * 3);
+  }
+  // Long jumps across many chunks.
+  for (DocID Target : {50000u, 50001u, 99998u, 99999u}) {
+    DocIterator->advanceTo(Target);
+    ASSERT_FALSE(DocIterator->reachedEnd());
+    EXPECT_EQ(DocIterator->peek(), (Target + 2) / 3 * 3);
+  }
+  DocIterator->advanceTo(100000);
+  EXPECT_TRUE(DocIterator->reachedEnd());
+}
+
 TEST(DexIterators, AndTwoLists) {
   Corpus C{10000};
   const PostingList L0({0, 5, 7, 10, 42, 320, 9000});
@@ -720,6 +720,11 @@ class SourceManager : public RefCountedBase<SourceManager> {
   /// expansion.
   SmallVector<SrcMgr::SLocEntry, 0> LocalSLocEntryTable;
 
+  /// The starting offsets of the entries in LocalSLocEntryTable, kept in a
+  /// separate dense array so that FileID lookups search contiguous offsets
+  /// instead of striding over whole SLocEntries.
+  SmallVector<SourceLocation::UIntTy, 0> LocalLocOffsetTable;
+
   /// The table of SLocEntries that are loaded from other modules.
   ///
   /// Negative FileIDs are indexes into this table. To get from ID to an index,
@@ -21,6 +21,7 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -123,6 +124,10 @@ class Compilation {
   /// class Command and the exit status of the corresponding child process.
   std::function<void(const Command &, int)> PostCallback;
 
+  /// Serializes logging, diagnostics and PostCallback when jobs are run in
+  /// parallel.
+  mutable std::mutex ExecuteMutex;
+
   /// Whether we're compiling for diagnostic purposes.
   bool ForDiagnostics = false;
 
@@ -313,7 +318,8 @@ public:
   int ExecuteCommand(const Command &C, const Command *&FailingCommand,
                      bool LogOnly = false) const;
 
-  /// ExecuteJob - Execute a single job.
+  /// ExecuteJobs - Execute a list of jobs, in parallel when requested with
+  /// -fparallel-jobs= and the jobs don't depend on each other.
   ///
   /// \param FailingCommands - For non-zero results, this will be a vector of
   /// failing commands and their associated result code.
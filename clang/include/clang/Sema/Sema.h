@@ -11051,6 +11051,11 @@ public:
   /// The number of SFINAE diagnostics that have been trapped.
   unsigned NumSFINAEErrors;
 
+  /// The number of pending implicit instantiations performed so far, and the
+  /// largest number of them that were queued at once.
+  unsigned NumPendingInstantiationsPerformed = 0;
+  size_t MaxPendingInstantiationsQueueDepth = 0;
+
   ArrayRef<sema::FunctionScopeInfo *> getFunctionScopes() const {
     return llvm::ArrayRef(FunctionScopes.begin() + FunctionScopesStart,
                           FunctionScopes.end());
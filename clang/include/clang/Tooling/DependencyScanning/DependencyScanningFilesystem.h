@@ -220,9 +220,16 @@ public:
   CacheShard &getShardForFilename(StringRef Filename) const;
   CacheShard &getShardForUID(llvm::sys::fs::UniqueID UID) const;
 
+  /// Sets the directory in which scanned directive tokens are persisted
+  /// across processes, keyed by a hash of the file contents. An empty path
+  /// (the default) disables the on-disk cache.
+  void setDirectivesCacheDir(StringRef Dir) { DirectivesCacheDir = Dir.str(); }
+  StringRef getDirectivesCacheDir() const { return DirectivesCacheDir; }
+
 private:
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
+  std::string DirectivesCacheDir;
 };
 
 /// This class is a local cache, that caches the 'stat' and 'open' calls to the
@@ -17,6 +17,7 @@
 #include "Program.h"
 #include "clang/AST/Expr.h"
 #include "clang/Basic/TargetInfo.h"
+#include "llvm/Support/TimeProfiler.h"
 
 using namespace clang;
 using namespace clang::interp;
@@ -263,6 +264,9 @@ const Function *Context::getOrCreateFunction(const FunctionDecl *FD) {
     return Func;
 
   if (!Func || WasNotDefined) {
+    llvm::TimeTraceScope TimeScope("InterpCompileFunction", [FD] {
+      return FD->getQualifiedNameAsString();
+    });
     if (auto F = Compiler<ByteCodeEmitter>(*this, *P).compileFunc(FD))
       Func = F;
   }
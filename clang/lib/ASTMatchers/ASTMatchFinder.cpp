@@ -1047,18 +1047,26 @@ private:
     const bool EnableCheckProfiling = Options.CheckProfiling.has_value();
     TimeBucketRegion Timer;
     auto &Matchers = this->Matchers->DeclOrStmt;
+    // Whether DynNode is ignored only depends on the traversal kind, and most
+    // matchers share one, so compute it at most once per kind. Index 0 is for
+    // matchers that don't set a traversal kind.
+    std::optional<bool> IsIgnored[3];
     for (unsigned short I : Filter) {
       auto &MP = Matchers[I];
       if (EnableCheckProfiling)
         Timer.setBucket(&TimeByBucket[MP.second->getID()]);
       BoundNodesTreeBuilder Builder;
 
-      {
-        TraversalKindScope RAII(getASTContext(), MP.first.getTraversalKind());
-        if (getASTContext().getParentMapContext().traverseIgnored(DynNode) !=
-            DynNode)
-          continue;
+      std::optional<TraversalKind> TK = MP.first.getTraversalKind();
+      std::optional<bool> &Ignored = IsIgnored[TK ? *TK + 1 : 0];
+      if (!Ignored) {
+        TraversalKindScope RAII(getASTContext(), TK);
+        Ignored =
+            getASTContext().getParentMapContext().traverseIgnored(DynNode) !=
+            DynNode;
       }
+      if (*Ignored)
+        continue;
 
       CurMatchRAII RAII(*this, MP.second, DynNode);
       if (MP.first.matches(DynNode, this, &Builder)) {
@@ -24,6 +24,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/YAMLParser.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Triple.h"
@@ -515,6 +516,8 @@ llvm::Expected<ASTUnit *> CrossTranslationUnitContext::loadExternalAST(
   //        translation units contains decls with the same lookup name an
   //        error will be returned.
 
+  llvm::TimeTraceScope TimeScope("CTULoadExternalAST", LookupName);
+
   // Try to get the value from the heavily cached storage.
   llvm::Expected<ASTUnit *> Unit = ASTStorage.getASTUnitForFunction(
       LookupName, CrossTUDir, IndexName, DisplayCTUProgress);
@@ -733,6 +736,9 @@ CrossTranslationUnitContext::importDefinitionImpl(const T *D, ASTUnit *Unit) {
          "ASTContext of Decl and the unit should match.");
   ASTImporter &Importer = getOrCreateASTImporter(Unit);
 
+  llvm::TimeTraceScope TimeScope("CTUImportDefinition", [D] {
+    return D->getQualifiedNameAsString();
+  });
   auto ToDeclOrError = Importer.Import(D);
   if (!ToDeclOrError) {
     handleAllErrors(ToDeclOrError.takeError(), [&](const ASTImportError &IE) {
@@ -21,9 +21,13 @@
 #include "llvm/Option/OptSpecifier.h"
 #include "llvm/Option/Option.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Triple.h"
 #include <cassert>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -165,6 +169,7 @@ int Compilation::ExecuteCommand(const Command &C,
                                 bool LogOnly) const {
   if ((getDriver().CCPrintOptions ||
        getArgs().hasArg(options::OPT_v)) && !getDriver().CCGenDiagnostics) {
+    std::lock_guard<std::mutex> Lock(ExecuteMutex);
     raw_ostream *OS = &llvm::errs();
     std::unique_ptr<llvm::raw_fd_ostream> OwnedStream;
 
@@ -197,6 +202,7 @@ int Compilation::ExecuteCommand(const Command &C,
   std::string Error;
   bool ExecutionFailed;
   int Res = C.Execute(Redirects, &Error, &ExecutionFailed);
+  std::lock_guard<std::mutex> Lock(ExecuteMutex);
   if (PostCallback)
     PostCallback(C, Res);
   if (!Error.empty()) {
@@ -239,6 +245,39 @@ static bool InputsOk(const Command &C,
   return !ActionFailed(&C.getSource(), FailingCommands);
 }
 
+// Return true if the action of \p Dep is among the inputs of \p A.
+static bool DependsOn(const Action *A, const Action *Dep) {
+  for (const auto *AI : A->inputs())
+    if (AI == Dep || DependsOn(AI, Dep))
+      return true;
+  return false;
+}
+
+// Return true if \p C must not run concurrently with \p Dep, which comes
+// before it in the job list. Several commands may be created for one action,
+// e.g. objcopy after the assembler for -gsplit-dwarf, and they run in order
+// on the same files.
+static bool DependsOn(const Command &C, const Command &Dep) {
+  if (&C.getSource() == &Dep.getSource() ||
+      DependsOn(&C.getSource(), &Dep.getSource()))
+    return true;
+  const std::vector<std::string> &Outputs = Dep.getOutputFilenames();
+  return llvm::any_of(C.getInputInfos(), [&](const InputInfo &II) {
+    return II.isFilename() && llvm::is_contained(Outputs, II.getFilename());
+  });
+}
+
+// Return the number of jobs to run in parallel, as requested by
+// -fparallel-jobs=. The value was validated when the jobs were built.
+static unsigned getParallelJobs(const llvm::opt::ArgList &Args) {
+  Arg *A = Args.getLastArg(options::OPT_fparallel_jobs_EQ);
+  if (!A)
+    return 1;
+  std::optional<llvm::ThreadPoolStrategy> S =
+      llvm::get_threadpool_strategy(A->getValue());
+  return S ? S->compute_thread_count() : 1;
+}
+
 void Compilation::ExecuteJobs(const JobList &Jobs,
                               FailingCommandList &FailingCommands,
                               bool LogOnly) const {
@@ -246,16 +285,50 @@ void Compilation::ExecuteJobs(const JobList &Jobs,
   // inputs on the command line even one of them failed.
   // In all but CLMode, execute all the jobs unless the necessary inputs for the
   // job is missing due to previous failures.
-  for (const auto &Job : Jobs) {
-    if (!InputsOk(Job, FailingCommands))
-      continue;
-    const Command *FailingCommand = nullptr;
-    if (int Res = ExecuteCommand(Job, FailingCommand, LogOnly)) {
-      FailingCommands.push_back(std::make_pair(Res, FailingCommand));
-      // Bail as soon as one command fails in cl driver mode.
-      if (TheDriver.IsCLMode())
-        return;
+  unsigned ParallelJobs = getParallelJobs(getArgs());
+  if (ParallelJobs <= 1 || LogOnly || TheDriver.IsCLMode() ||
+      llvm::any_of(Jobs, [](const Command &J) { return J.InProcess; })) {
+    for (const auto &Job : Jobs) {
+      if (!InputsOk(Job, FailingCommands))
+        continue;
+      const Command *FailingCommand = nullptr;
+      if (int Res = ExecuteCommand(Job, FailingCommand, LogOnly)) {
+        FailingCommands.push_back(std::make_pair(Res, FailingCommand));
+        // Bail as soon as one command fails in cl driver mode.
+        if (TheDriver.IsCLMode())
+          return;
+      }
     }
+    return;
+  }
+
+  // Run the jobs in waves: a wave extends over the following jobs in order
+  // until one of them depends on a job in the wave. Failures are
+  // recorded in job order once the wave is done, so that the later waves, and
+  // the diagnostics, see the same results as the sequential execution.
+  llvm::DefaultThreadPool Pool(llvm::hardware_concurrency(ParallelJobs));
+  auto I = Jobs.begin(), E = Jobs.end();
+  while (I != E) {
+    SmallVector<const Command *, 8> Wave;
+    for (; I != E; ++I) {
+      if (llvm::any_of(Wave,
+                       [&](const Command *W) { return DependsOn(*I, *W); }))
+        break;
+      if (InputsOk(*I, FailingCommands))
+        Wave.push_back(&*I);
+    }
+
+    SmallVector<std::pair<int, const Command *>, 8> Results(Wave.size());
+    for (size_t J = 0; J != Wave.size(); ++J)
+      Pool.async([&, J] {
+        Results[J].first =
+            ExecuteCommand(*Wave[J], Results[J].second, LogOnly);
+      });
+    Pool.wait();
+
+    for (const auto &Result : Results)
+      if (Result.first)
+        FailingCommands.push_back(Result);
   }
 }
 
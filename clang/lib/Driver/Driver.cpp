@@ -89,6 +89,7 @@
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Regex.h"
 #include "llvm/Support/StringSaver.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Host.h"
@@ -4967,6 +4968,12 @@ void Driver::BuildJobs(Compilation &C) const {
     for (auto &J : C.getJobs())
       J.InProcess = false;
 
+  // Diagnose a bad -fparallel-jobs= value before any job runs.
+  if (Arg *A = C.getArgs().getLastArg(options::OPT_fparallel_jobs_EQ))
+    if (!llvm::get_threadpool_strategy(A->getValue()))
+      Diag(diag::err_drv_invalid_int_value)
+          << A->getAsString(C.getArgs()) << A->getValue();
+
   if (CCPrintProcessStats) {
     C.setPostCallback([=](const Command &Cmd, int Res) {
       std::optional<llvm::sys::ProcessStatistics> ProcStat =
@@ -896,6 +896,16 @@ static void RenderDebugInfoCompressionArgs(const ArgList &Args,
       if (llvm::compression::zstd::isAvailable()) {
         CmdArgs.push_back(
             Args.MakeArgString("--compress-debug-sections=" + Twine(Value)));
+        if (const Arg *TA = Args.getLastArg(options::OPT_gz_threads_EQ)) {
+          unsigned Threads;
+          if (StringRef(TA->getValue()).getAsInteger(10, Threads) ||
+              Threads == 0)
+            D.Diag(diag::err_drv_invalid_int_value)
+                << TA->getAsString(Args) << TA->getValue();
+          else
+            CmdArgs.push_back(Args.MakeArgString(
+                "--compress-debug-sections-threads=" + Twine(Threads)));
+        }
       } else {
         D.Diag(diag::warn_debug_compression_unavailable) << "zstd";
       }
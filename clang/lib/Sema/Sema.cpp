@@ -608,6 +608,9 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumPendingInstantiationsPerformed
+               << " pending instantiations performed, at most "
+               << MaxPendingInstantiationsQueueDepth << " queued at once.\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
@@ -5608,6 +5608,14 @@ void Sema::InstantiateVariableDefinition(SourceLocation PointOfInstantiation,
   PrettyDeclStackTraceEntry CrashInfo(Context, Var, SourceLocation(),
                                       "instantiating variable definition");
 
+  llvm::TimeTraceScope TimeScope("InstantiateVariable", [&]() {
+    std::string Name;
+    llvm::raw_string_ostream OS(Name);
+    Var->getNameForDiagnostic(OS, getPrintingPolicy(),
+                              /*Qualified=*/true);
+    return Name;
+  });
+
   // If we're performing recursive template instantiation, create our own
   // queue of pending implicit instantiations that we will instantiate later,
   // while we're still within our own instantiation context.
@@ -6365,6 +6373,11 @@ void Sema::PerformPendingInstantiations(bool LocalOnly) {
       Inst = PendingLocalImplicitInstantiations.front();
       PendingLocalImplicitInstantiations.pop_front();
     }
+    ++NumPendingInstantiationsPerformed;
+    MaxPendingInstantiationsQueueDepth = std::max<size_t>(
+        MaxPendingInstantiationsQueueDepth,
+        PendingInstantiations.size() +
+            PendingLocalImplicitInstantiations.size() + 1);
 
     // Instantiate function definitions
     if (FunctionDecl *Function = dyn_cast<FunctionDecl>(Inst.first)) {
@@ -4512,6 +4512,7 @@ ASTReader::ASTReadResult ASTReader::ReadAST(StringRef FileName, ModuleKind Type,
   // Preload source locations and interesting indentifiers.
   for (ImportedModule &M : Loaded) {
     ModuleFile &F = *M.Mod;
+    llvm::TimeTraceScope Scope2("Preload Identifiers", F.ModuleName);
 
     // Map the original source file ID into the ID space of the current
     // compilation.
@@ -8141,9 +8142,10 @@ void ASTReader::PrintStats() {
       llvm::count(DeclsLoaded.materialized(), (Decl *)nullptr);
   unsigned NumIdentifiersLoaded =
       IdentifiersLoaded.size() -
-      llvm::count(IdentifiersLoaded, (IdentifierInfo *)nullptr);
+      llvm::count(IdentifiersLoaded.materialized(), (IdentifierInfo *)nullptr);
   unsigned NumMacrosLoaded =
-      MacrosLoaded.size() - llvm::count(MacrosLoaded, (MacroInfo *)nullptr);
+      MacrosLoaded.size() -
+      llvm::count(MacrosLoaded.materialized(), (MacroInfo *)nullptr);
   unsigned NumSelectorsLoaded =
       SelectorsLoaded.size() - llvm::count(SelectorsLoaded, Selector());
 
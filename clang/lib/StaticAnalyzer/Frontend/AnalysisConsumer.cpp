@@ -39,6 +39,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 #include <memory>
@@ -675,6 +676,9 @@ void AnalysisConsumer::HandleCode(Decl *D, AnalysisMode Mode,
     MaxCFGSize.updateMax(DeclCFG->size());
 
   DisplayFunction(D, Mode, IMode);
+  llvm::TimeTraceScope TimeScope("HandleCode", [D] {
+    return AnalysisDeclContext::getFunctionName(D);
+  });
   BugReporter BR(*Mgr);
   BR.setAnalysisEntryPoint(D);
 
@@ -718,6 +722,7 @@ void AnalysisConsumer::RunPathSensitiveChecks(Decl *D,
   if (!Mgr->getAnalysisDeclContext(D)->getAnalysis<RelaxedLiveVariables>())
     return;
 
+  llvm::TimeTraceScope TimeScope("PathSensitiveAnalysis");
   ExprEngine Eng(CTU, *Mgr, VisitedCallees, &FunctionSummaries, IMode);
 
   // Execute the worklist algorithm.
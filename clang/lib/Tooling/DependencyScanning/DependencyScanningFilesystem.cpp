@@ -7,9 +7,16 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "clang/Basic/TokenKinds.h"
+#include "clang/Basic/Version.h"
+#include "llvm/Support/DataExtractor.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/Threading.h"
+#include "llvm/Support/xxhash.h"
 #include <optional>
 
 using namespace clang;
@@ -41,6 +48,141 @@ DependencyScanningWorkerFilesystem::readFile(StringRef Filename) {
   return TentativeEntry(Stat, std::move(Buffer));
 }
 
+/// Every directives cache entry starts with this magic, the format version
+/// and the version of the compiler that wrote it. Bump the format version
+/// whenever the layout of the entries changes.
+static constexpr StringLiteral DirectivesCacheMagic = "CLDDCACH";
+static constexpr uint32_t DirectivesCacheFormatVersion = 1;
+
+/// Token kinds and directive kinds change between compilers, so entries are
+/// only valid for the exact compiler that wrote them.
+static StringRef getDirectivesCacheCompilerVersion() {
+  static const std::string Version = getClangFullRepositoryVersion();
+  return Version;
+}
+
+/// Returns the path of the on-disk directives cache entry for \p Source.
+/// The name covers the compiler as well, so that different compilers sharing
+/// a cache directory don't overwrite each other's entries.
+static std::string getDirectivesCachePath(StringRef CacheDir,
+                                          StringRef Source) {
+  static const uint64_t CompilerHash = llvm::xxh3_64bits(
+      llvm::arrayRefFromStringRef(getDirectivesCacheCompilerVersion()));
+  llvm::XXH128_hash_t Hash = llvm::xxh3_128bits(llvm::arrayRefFromStringRef(
+      Source));
+  SmallString<128> Path(CacheDir);
+  llvm::sys::path::append(
+      Path, llvm::formatv("{0:x-16}{1:x-16}-{2}-{3:x-16}-v{4}.deps",
+                          Hash.high64, Hash.low64, Source.size(), CompilerHash,
+                          DirectivesCacheFormatVersion)
+                .str());
+  return std::string(Path);
+}
+
+/// Reads the directive tokens of \p Source from the cache entry at \p Path.
+/// Returns false if the entry doesn't exist, was written by another compiler
+/// or format version, or doesn't match \p Source.
+static bool
+readDirectivesCache(StringRef Path, StringRef Source,
+                    SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
+                    SmallVectorImpl<dependency_directives_scan::Directive>
+                        &Directives) {
+  using namespace dependency_directives_scan;
+  auto MB = llvm::MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                        /*RequiresNullTerminator=*/false);
+  if (!MB)
+    return false;
+
+  llvm::DataExtractor DE((*MB)->getBuffer(), /*IsLittleEndian=*/true,
+                         /*AddressSize=*/8);
+  llvm::DataExtractor::Cursor C(0);
+  SmallVector<std::pair<DirectiveKind, std::pair<uint32_t, uint32_t>>, 64>
+      DirectiveInfos;
+
+  StringRef CompilerVersion = getDirectivesCacheCompilerVersion();
+  bool Valid =
+      DE.getBytes(C, DirectivesCacheMagic.size()) == DirectivesCacheMagic &&
+      DE.getU32(C) == DirectivesCacheFormatVersion &&
+      DE.getU32(C) == CompilerVersion.size() &&
+      DE.getBytes(C, CompilerVersion.size()) == CompilerVersion;
+
+  uint32_t NumTokens = Valid ? DE.getU32(C) : 0;
+  for (uint32_t I = 0; C && Valid && I != NumTokens; ++I) {
+    uint32_t Offset = DE.getU32(C);
+    uint32_t Length = DE.getU32(C);
+    uint16_t Kind = DE.getU16(C);
+    uint16_t Flags = DE.getU16(C);
+    Valid = Kind < tok::NUM_TOKENS && Offset <= Source.size() &&
+            Length <= Source.size() - Offset;
+    Tokens.emplace_back(Offset, Length, static_cast<tok::TokenKind>(Kind),
+                        Flags);
+  }
+  uint32_t NumDirectives = DE.getU32(C);
+  for (uint32_t I = 0; C && Valid && I != NumDirectives; ++I) {
+    uint8_t Kind = DE.getU8(C);
+    uint32_t First = DE.getU32(C);
+    uint32_t Count = DE.getU32(C);
+    Valid = Kind <= pp_eof && First <= Tokens.size() &&
+            Count <= Tokens.size() - First;
+    DirectiveInfos.push_back(
+        {static_cast<DirectiveKind>(Kind), {First, Count}});
+  }
+  Valid &= C && DE.eof(C);
+  llvm::consumeError(C.takeError());
+  if (!Valid) {
+    Tokens.clear();
+    return false;
+  }
+
+  // Only form the token ArrayRefs once Tokens is no longer growing.
+  for (const auto &[Kind, Range] : DirectiveInfos)
+    Directives.emplace_back(
+        Kind, ArrayRef<Token>(Tokens).slice(Range.first, Range.second));
+  return true;
+}
+
+/// Persists the directive tokens scanned from a file at \p Path. Failures are
+/// ignored; they only cost a rescan in a later process.
+static void
+writeDirectivesCache(StringRef Path,
+                     ArrayRef<dependency_directives_scan::Token> Tokens,
+                     ArrayRef<dependency_directives_scan::Directive>
+                         Directives) {
+  if (llvm::sys::fs::create_directories(llvm::sys::path::parent_path(Path)))
+    return;
+  auto Temp = llvm::sys::fs::TempFile::create(Path + ".tmp%%%%%%%");
+  if (!Temp) {
+    llvm::consumeError(Temp.takeError());
+    return;
+  }
+  {
+    llvm::raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+    llvm::support::endian::Writer W(OS, llvm::endianness::little);
+    StringRef CompilerVersion = getDirectivesCacheCompilerVersion();
+    OS << DirectivesCacheMagic;
+    W.write<uint32_t>(DirectivesCacheFormatVersion);
+    W.write<uint32_t>(CompilerVersion.size());
+    OS << CompilerVersion;
+    W.write<uint32_t>(Tokens.size());
+    for (const dependency_directives_scan::Token &T : Tokens) {
+      W.write<uint32_t>(T.Offset);
+      W.write<uint32_t>(T.Length);
+      W.write<uint16_t>(T.Kind);
+      W.write<uint16_t>(T.Flags);
+    }
+    W.write<uint32_t>(Directives.size());
+    for (const dependency_directives_scan::Directive &D : Directives) {
+      W.write<uint8_t>(D.Kind);
+      W.write<uint32_t>(D.Tokens.empty() ? 0 : D.Tokens.data() - Tokens.data());
+      W.write<uint32_t>(D.Tokens.size());
+    }
+  }
+  if (llvm::Error E = Temp->keep(Path)) {
+    llvm::consumeError(std::move(E));
+    llvm::consumeError(Temp->discard());
+  }
+}
+
 bool DependencyScanningWorkerFilesystem::ensureDirectiveTokensArePopulated(
     EntryRef Ref) {
   auto &Entry = Ref.Entry;
@@ -62,10 +204,24 @@ bool DependencyScanningWorkerFilesystem::ensureDirectiveTokensArePopulated(
     return true;
 
   SmallVector<dependency_directives_scan::Directive, 64> Directives;
+  StringRef Source = Contents->Original->getBuffer();
+
+  // Reuse the directives scanned by an earlier process, if any.
+  std::string CachePath;
+  if (StringRef CacheDir = SharedCache.getDirectivesCacheDir();
+      !CacheDir.empty()) {
+    CachePath = getDirectivesCachePath(CacheDir, Source);
+    if (readDirectivesCache(CachePath, Source, Contents->DepDirectiveTokens,
+                            Directives)) {
+      Contents->DepDirectives.store(
+          new std::optional<DependencyDirectivesTy>(std::move(Directives)));
+      return true;
+    }
+  }
+
   // Scan the file for preprocessor directives that might affect the
   // dependencies.
-  if (scanSourceForDependencyDirectives(Contents->Original->getBuffer(),
-                                        Contents->DepDirectiveTokens,
+  if (scanSourceForDependencyDirectives(Source, Contents->DepDirectiveTokens,
                                         Directives)) {
     Contents->DepDirectiveTokens.clear();
     // FIXME: Propagate the diagnostic if desired by the client.
@@ -73,6 +229,9 @@ bool DependencyScanningWorkerFilesystem::ensureDirectiveTokensArePopulated(
     return false;
   }
 
+  if (!CachePath.empty())
+    writeDirectivesCache(CachePath, Contents->DepDirectiveTokens, Directives);
+
   // This function performed double-checked locking using `DepDirectives`.
   // Assigning it must be the last thing this function does, otherwise other
   // threads may skip the critical section (`DepDirectives != nullptr`), leading
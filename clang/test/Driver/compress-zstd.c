@@ -5,3 +5,13 @@
 
 // CHECK: {{"-cc1(as)?".* "--compress-debug-sections=zstd"}}
 // CHECK: "--compress-debug-sections=zstd"
+
+// RUN: %clang -### --target=x86_64-unknown-linux-gnu -gz=zstd -gz-threads=8 -c %s 2>&1 | \
+// RUN:   FileCheck %s --check-prefix=THREADS
+// RUN: %clang -### --target=x86_64-unknown-linux-gnu -gz=zstd -gz-threads=8 -x assembler -c %s 2>&1 | \
+// RUN:   FileCheck %s --check-prefix=THREADS
+// THREADS: {{"-cc1(as)?".* "--compress-debug-sections=zstd" "--compress-debug-sections-threads=8"}}
+
+// RUN: not %clang -### --target=x86_64-unknown-linux-gnu -gz=zstd -gz-threads=0 -c %s 2>&1 | \
+// RUN:   FileCheck %s --check-prefix=THREADS-ZERO
+// THREADS-ZERO: error: invalid integral value '0' in '-gz-threads=0'
@@ -0,0 +1,19 @@
+// With -fno-integrated-as -gsplit-dwarf, the objcopy commands that split the
+// object file share the assembler's action. They must not run in the same
+// wave as the assembler, or concurrently with each other.
+// REQUIRES: x86-registered-target, system-linux
+
+// RUN: rm -rf %t && mkdir %t && cd %t
+// RUN: cp %s a.c && cp %s b.c
+// RUN: %clang --target=x86_64-unknown-linux-gnu -fparallel-jobs=8 \
+// RUN:   -fno-integrated-as -gsplit-dwarf -g -c a.c b.c
+// RUN: llvm-readelf -S a.o | FileCheck --check-prefix=OBJ %s
+// RUN: llvm-readelf -S b.o | FileCheck --check-prefix=OBJ %s
+// RUN: llvm-readelf -S a.dwo | FileCheck --check-prefix=DWO %s
+// RUN: llvm-readelf -S b.dwo | FileCheck --check-prefix=DWO %s
+
+// OBJ:     .debug_
+// OBJ-NOT: .dwo
+// DWO:     .debug_info.dwo
+
+int f(int x) { return x + 1; }
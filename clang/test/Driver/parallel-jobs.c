@@ -0,0 +1,20 @@
+// -fparallel-jobs= is handled by the driver and not passed to the jobs.
+// RUN: %clang -### -fparallel-jobs=4 -c %s %s 2>&1 \
+// RUN:   | FileCheck --check-prefix=CHECK-JOBS %s
+// CHECK-JOBS-NOT: argument unused
+// CHECK-JOBS-NOT: "-fparallel-jobs=4"
+
+// RUN: not %clang -### -fparallel-jobs=x -c %s 2>&1 \
+// RUN:   | FileCheck --check-prefix=CHECK-INVALID %s
+// CHECK-INVALID: error: invalid integral value 'x' in '-fparallel-jobs=x'
+
+// A failure doesn't stop the compilation of the other inputs.
+// RUN: not %clang -fparallel-jobs=2 -fsyntax-only -DFAIL %s %s 2>&1 \
+// RUN:   | FileCheck --check-prefix=CHECK-FAIL %s
+// CHECK-FAIL-COUNT-2: error: failed
+
+// RUN: %clang -fparallel-jobs=2 -fsyntax-only %s %s
+
+#ifdef FAIL
+#error failed
+#endif
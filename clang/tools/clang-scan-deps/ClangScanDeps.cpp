@@ -78,6 +78,7 @@ static ScanningOutputFormat Format = ScanningOutputFormat::Make;
 static ScanningOptimizations OptimizeArgs;
 static std::string ModuleFilesDir;
 static bool EagerLoadModules;
+static std::string DirectivesCacheDir;
 static unsigned NumThreads = 0;
 static std::string CompilationDB;
 static std::string ModuleName;
@@ -181,6 +182,9 @@ static void ParseArgs(int argc, char **argv) {
 
   EagerLoadModules = Args.hasArg(OPT_eager_load_pcm);
 
+  if (const llvm::opt::Arg *A = Args.getLastArg(OPT_directives_cache_dir_EQ))
+    DirectivesCacheDir = A->getValue();
+
   if (const llvm::opt::Arg *A = Args.getLastArg(OPT_j)) {
     StringRef S{A->getValue()};
     if (!llvm::to_integer(S, NumThreads, 0)) {
@@ -1003,6 +1007,7 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
 
   DependencyScanningService Service(ScanMode, Format, OptimizeArgs,
                                     EagerLoadModules);
+  Service.getSharedCache().setDirectivesCacheDir(DirectivesCacheDir);
 
   llvm::Timer T;
   T.startTimer();
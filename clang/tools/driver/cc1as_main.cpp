@@ -106,6 +106,7 @@ struct AssemblerInvocation {
   llvm::SmallVector<std::pair<std::string, std::string>, 0> DebugPrefixMap;
   llvm::DebugCompressionType CompressDebugSections =
       llvm::DebugCompressionType::None;
+  unsigned CompressDebugSectionsThreads = 1;
   std::string MainFileName;
   std::string SplitDwarfOutput;
 
@@ -282,6 +283,8 @@ bool AssemblerInvocation::CreateFromArgs(AssemblerInvocation &Opts,
             .Case("zstd", llvm::DebugCompressionType::Zstd)
             .Default(llvm::DebugCompressionType::None);
   }
+  Opts.CompressDebugSectionsThreads = getLastArgIntValue(
+      Args, OPT_compress_debug_sections_threads_EQ, 1, Diags);
 
   Opts.RelaxELFRelocations = !Args.hasArg(OPT_mrelax_relocations_no);
   if (auto *DwarfFormatArg = Args.getLastArg(OPT_gdwarf64, OPT_gdwarf32))
@@ -432,6 +435,7 @@ static bool ExecuteAssemblerImpl(AssemblerInvocation &Opts,
   MCOptions.MCSaveTempLabels = Opts.SaveTemporaryLabels;
   MCOptions.X86RelaxRelocations = Opts.RelaxELFRelocations;
   MCOptions.CompressDebugSections = Opts.CompressDebugSections;
+  MCOptions.CompressDebugSectionsThreads = Opts.CompressDebugSectionsThreads;
   MCOptions.AsSecureLogFile = Opts.AsSecureLogFile;
 
   std::unique_ptr<MCAsmInfo> MAI(
@@ -666,6 +666,36 @@ TEST_F(SourceManagerTest, isBeforeInTranslationUnitWithMacroInInclude) {
   EXPECT_TRUE(SourceMgr.isBeforeInTranslationUnit(Macros[10].Loc, Macros[11].Loc));
 }
 
+TEST_F(SourceManagerTest, getFileIDOfManyExpansions) {
+  std::unique_ptr<llvm::MemoryBuffer> Buf =
+      llvm::MemoryBuffer::getMemBuffer("int x;");
+  FileID MainFileID = SourceMgr.createFileID(std::move(Buf));
+  SourceMgr.setMainFileID(MainFileID);
+  SourceLocation Spelling = SourceMgr.getLocForStartOfFile(MainFileID);
+
+  // Create expansions of varying lengths so that the FileID lookup has to
+  // search a large table, and remember where each one starts.
+  std::vector<std::pair<SourceLocation, FileID>> Expansions;
+  for (unsigned I = 0; I != 1000; ++I) {
+    unsigned Length = 1 + I % 7;
+    SourceLocation Loc = SourceMgr.createExpansionLoc(
+        Spelling, Spelling, Spelling, Length);
+    FileID FID = SourceManagerTestHelper::makeFileID(
+        SourceMgr.local_sloc_entry_size() - 1);
+    Expansions.push_back({Loc, FID});
+  }
+
+  // Query far apart entries alternately so that the one-entry lookup cache
+  // and the short linear scan don't find them.
+  for (unsigned I = 0, E = Expansions.size(); I != E; ++I) {
+    unsigned J = I % 2 ? I : E - 1 - I;
+    auto [Loc, FID] = Expansions[J];
+    EXPECT_EQ(SourceMgr.getFileID(Loc), FID);
+    EXPECT_EQ(SourceMgr.getFileID(Loc.getLocWithOffset(J % 7)), FID);
+  }
+  EXPECT_EQ(SourceMgr.getFileID(Spelling), MainFileID);
+}
+
 TEST_F(SourceManagerTest, isMainFile) {
   const char *Source = "int x;";
 
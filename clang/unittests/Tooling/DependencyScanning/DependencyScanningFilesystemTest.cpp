@@ -9,6 +9,7 @@
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
 #include "gtest/gtest.h"
 
 using namespace clang::tooling::dependencies;
@@ -174,3 +175,65 @@ TEST(DependencyScanningFilesystem, CacheStatOnExists) {
   EXPECT_EQ(InstrumentingFS->NumStatusCalls, 2u);
   EXPECT_EQ(InstrumentingFS->NumExistsCalls, 0u);
 }
+
+TEST(DependencyScanningFilesystem, DirectivesCache) {
+  llvm::unittest::TempDir CacheDir("directives-cache", /*Unique=*/true);
+  auto InMemoryFS = llvm::makeIntrusiveRefCnt<llvm::vfs::InMemoryFileSystem>();
+  InMemoryFS->setCurrentWorkingDirectory("/");
+  InMemoryFS->addFile("/foo.h", 0,
+                      llvm::MemoryBuffer::getMemBuffer(
+                          "#include \"bar.h\"\nint x;\n#define FOO 1\n"));
+
+  auto ScanDirectives = [&](DependencyScanningFilesystemSharedCache &Cache) {
+    DependencyScanningWorkerFilesystem DepFS(Cache, InMemoryFS);
+    auto Entry = DepFS.getOrCreateFileSystemEntry("/foo.h");
+    EXPECT_TRUE(Entry);
+    EXPECT_TRUE(DepFS.ensureDirectiveTokensArePopulated(*Entry));
+    std::vector<std::pair<clang::dependency_directives_scan::DirectiveKind,
+                          unsigned>>
+        Result;
+    for (const auto &D : *Entry->getDirectiveTokens())
+      Result.push_back({D.Kind, D.Tokens.size()});
+    return Result;
+  };
+
+  // The first scan populates the on-disk cache and the second one, done with
+  // a fresh shared cache as in a later process, reads it back.
+  DependencyScanningFilesystemSharedCache FirstCache;
+  FirstCache.setDirectivesCacheDir(CacheDir.path());
+  auto Scanned = ScanDirectives(FirstCache);
+
+  std::error_code EC;
+  llvm::sys::fs::directory_iterator It(CacheDir.path(), EC);
+  ASSERT_FALSE(EC);
+  EXPECT_NE(It, llvm::sys::fs::directory_iterator());
+
+  DependencyScanningFilesystemSharedCache SecondCache;
+  SecondCache.setDirectivesCacheDir(CacheDir.path());
+  EXPECT_EQ(ScanDirectives(SecondCache), Scanned);
+  ASSERT_GE(Scanned.size(), 2u);
+  EXPECT_EQ(Scanned[0].first, clang::dependency_directives_scan::pp_include);
+  EXPECT_EQ(Scanned[1].first, clang::dependency_directives_scan::pp_define);
+
+  // An entry written by another format version is not used; the file is
+  // rescanned and the entry rewritten.
+  std::string EntryPath = It->path();
+  auto ReadEntry = [&] {
+    auto MB = llvm::MemoryBuffer::getFile(EntryPath);
+    EXPECT_TRUE(MB);
+    return MB ? (*MB)->getBuffer().str() : std::string();
+  };
+  std::string Entry = ReadEntry();
+  ASSERT_GT(Entry.size(), 12u);
+  std::string Stale = Entry;
+  Stale[8] ^= 0xff;
+  {
+    llvm::raw_fd_ostream OS(EntryPath, EC);
+    ASSERT_FALSE(EC);
+    OS << Stale;
+  }
+  DependencyScanningFilesystemSharedCache ThirdCache;
+  ThirdCache.setDirectivesCacheDir(CacheDir.path());
+  EXPECT_EQ(ScanDirectives(ThirdCache), Scanned);
+  EXPECT_EQ(ReadEntry(), Entry);
+}
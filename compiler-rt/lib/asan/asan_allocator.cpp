@@ -330,6 +330,7 @@ QuarantineCache *GetQuarantineCache(AsanThreadLocalMallocStorage *ms) {
 void AllocatorOptions::SetFrom(const Flags *f, const CommonFlags *cf) {
   quarantine_size_mb = f->quarantine_size_mb;
   thread_local_quarantine_size_kb = f->thread_local_quarantine_size_kb;
+  quarantine_max_chunk_size_kb = Max(f->quarantine_max_chunk_size_kb, 0);
   min_redzone = f->redzone;
   max_redzone = f->max_redzone;
   may_return_null = cf->allocator_may_return_null;
@@ -340,6 +341,7 @@ void AllocatorOptions::SetFrom(const Flags *f, const CommonFlags *cf) {
 void AllocatorOptions::CopyTo(Flags *f, CommonFlags *cf) {
   f->quarantine_size_mb = quarantine_size_mb;
   f->thread_local_quarantine_size_kb = thread_local_quarantine_size_kb;
+  f->quarantine_max_chunk_size_kb = quarantine_max_chunk_size_kb;
   f->redzone = min_redzone;
   f->max_redzone = max_redzone;
   cf->allocator_may_return_null = may_return_null;
@@ -380,7 +382,8 @@ struct Allocator {
   void SharedInitCode(const AllocatorOptions &options) {
     CheckOptions(options);
     quarantine.Init((uptr)options.quarantine_size_mb << 20,
-                    (uptr)options.thread_local_quarantine_size_kb << 10);
+                    (uptr)options.thread_local_quarantine_size_kb << 10,
+                    (uptr)options.quarantine_max_chunk_size_kb << 10);
     atomic_store(&alloc_dealloc_mismatch, options.alloc_dealloc_mismatch,
                  memory_order_release);
     atomic_store(&min_redzone, options.min_redzone, memory_order_release);
@@ -444,6 +447,7 @@ struct Allocator {
     options->quarantine_size_mb = quarantine.GetMaxSize() >> 20;
     options->thread_local_quarantine_size_kb =
         quarantine.GetMaxCacheSize() >> 10;
+    options->quarantine_max_chunk_size_kb = quarantine.GetMaxChunkSize() >> 10;
     options->min_redzone = atomic_load(&min_redzone, memory_order_acquire);
     options->max_redzone = atomic_load(&max_redzone, memory_order_acquire);
     options->may_return_null = AllocatorMayReturnNull();
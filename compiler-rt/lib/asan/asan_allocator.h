@@ -34,6 +34,7 @@ class AsanChunk;
 struct AllocatorOptions {
   u32 quarantine_size_mb;
   u32 thread_local_quarantine_size_kb;
+  u32 quarantine_max_chunk_size_kb;
   u16 min_redzone;
   u16 max_redzone;
   u8 may_return_null;
@@ -134,9 +134,10 @@ struct ChunkHeader {
   // 3-rd 4 bytes
   u32 timestamp_ms;
   // 4-th 4 bytes
-  // Note only 1 bit is needed for this flag if we need space in the future for
-  // more fields.
-  u32 from_memalign;
+  // 30 bits available if we need space in the future for more fields.
+  u32 from_memalign : 1;
+  // Set if the allocation is recorded in the profile, see sample_alloc_bytes.
+  u32 sampled : 1;
   // 5-th and 6-th 4 bytes
   // The max size of an allocation is 2^40 (kMaxAllowedMallocSize), so this
   // could be shrunk to kMaxAllowedMallocBits if we need space in the future for
@@ -218,6 +219,21 @@ AllocatorCache *GetAllocatorCache(MemprofThreadLocalMallocStorage *ms) {
   return &ms->allocator_cache;
 }
 
+bool AllocationSampler::ShouldSample(uptr size, uptr interval) {
+  if (bytes_until_sample > size) {
+    bytes_until_sample -= size;
+    return false;
+  }
+  if (!rand_state)
+    rand_state = static_cast<u32>(NanoTime()) | 1;
+  // Rand() only yields 16 bits at a time. Drawing the next interval from
+  // [1, 2 * interval] keeps the mean while avoiding aliasing with periodic
+  // allocation patterns.
+  u64 r = (static_cast<u64>(Rand(&rand_state)) << 16) | Rand(&rand_state);
+  bytes_until_sample = 1 + r % (2 * static_cast<u64>(interval));
+  return true;
+}
+
 // Accumulates the access count from the shadow for the given pointer and size.
 u64 GetShadowCount(uptr p, u32 size) {
   u64 *shadow = (u64 *)MEM_TO_SHADOW(p);
@@ -283,6 +299,7 @@ struct Allocator {
   MemprofAllocator allocator;
   StaticSpinMutex fallback_mutex;
   AllocatorCache fallback_allocator_cache;
+  AllocationSampler fallback_sampler;
 
   uptr max_user_defined_malloc_size;
 
@@ -385,7 +402,7 @@ struct Allocator {
           Allocator *A = (Allocator *)alloc;
           MemprofChunk *m =
               A->GetMemprofChunk((void *)chunk, user_requested_size);
-          if (!m)
+          if (!m || !m->sampled)
             return;
           uptr user_beg = ((uptr)m) + kChunkHeaderSize;
           MemInfoBlock newMIB = CreateNewMIB(user_beg, m, user_requested_size);
@@ -446,13 +463,19 @@ struct Allocator {
 
     MemprofThread *t = GetCurrentThread();
     void *allocated;
+    bool sampled = true;
+    const int sample_bytes = flags()->sample_alloc_bytes;
     if (t) {
       AllocatorCache *cache = GetAllocatorCache(&t->malloc_storage());
       allocated = allocator.Allocate(cache, needed_size, 8);
+      if (sample_bytes > 0)
+        sampled = t->malloc_storage().sampler.ShouldSample(size, sample_bytes);
     } else {
       SpinMutexLock l(&fallback_mutex);
       AllocatorCache *cache = &fallback_allocator_cache;
       allocated = allocator.Allocate(cache, needed_size, 8);
+      if (sample_bytes > 0)
+        sampled = fallback_sampler.ShouldSample(size, sample_bytes);
     }
     if (UNLIKELY(!allocated)) {
       SetAllocatorOutOfMemory();
@@ -472,16 +495,21 @@ struct Allocator {
     uptr chunk_beg = user_beg - kChunkHeaderSize;
     MemprofChunk *m = reinterpret_cast<MemprofChunk *>(chunk_beg);
     m->from_memalign = alloc_beg != chunk_beg;
+    m->sampled = sampled;
     CHECK(size);
 
-    m->cpu_id = GetCpuId();
-    m->timestamp_ms = GetTimestamp();
-    m->alloc_context_id = StackDepotPut(*stack);
-
-    uptr size_rounded_down_to_granularity =
-        RoundDownTo(size, SHADOW_GRANULARITY);
-    if (size_rounded_down_to_granularity)
-      ClearShadow(user_beg, size_rounded_down_to_granularity);
+    // The shadow of unsampled allocations is never read, so neither it nor
+    // the allocation context needs to be set up.
+    if (sampled) {
+      m->cpu_id = GetCpuId();
+      m->timestamp_ms = GetTimestamp();
+      m->alloc_context_id = StackDepotPut(*stack);
+
+      uptr size_rounded_down_to_granularity =
+          RoundDownTo(size, SHADOW_GRANULARITY);
+      if (size_rounded_down_to_granularity)
+        ClearShadow(user_beg, size_rounded_down_to_granularity);
+    }
 
     MemprofStats &thread_stats = GetCurrentThreadStats();
     thread_stats.mallocs++;
@@ -515,7 +543,7 @@ struct Allocator {
 
     u64 user_requested_size =
         atomic_exchange(&m->user_requested_size, 0, memory_order_acquire);
-    if (memprof_inited && atomic_load_relaxed(&constructed) &&
+    if (m->sampled && memprof_inited && atomic_load_relaxed(&constructed) &&
         !atomic_load_relaxed(&destructing)) {
       MemInfoBlock newMIB = this->CreateNewMIB(p, m, user_requested_size);
       InsertOrMerge(m->alloc_context_id, newMIB, MIBMap);
@@ -76,8 +76,20 @@ using MemprofAllocatorASVT =
 using MemprofAllocator = MemprofAllocatorASVT<LocalAddressSpaceView>;
 using AllocatorCache = MemprofAllocator::AllocatorCache;
 
+// Picks the allocations to profile when the sample_alloc_bytes flag is set.
+// Zero-initialized state samples the first allocation.
+struct AllocationSampler {
+  uptr bytes_until_sample;
+  u32 rand_state;
+
+  // Returns whether an allocation of \p size bytes should be profiled, so
+  // that on average one allocation is sampled every \p interval bytes.
+  bool ShouldSample(uptr size, uptr interval);
+};
+
 struct MemprofThreadLocalMallocStorage {
   AllocatorCache allocator_cache;
+  AllocationSampler sampler;
   void CommitBack();
 
 private:
@@ -298,19 +298,22 @@ uptr internal_wcsnlen(const wchar_t *s, uptr maxlen) {
 bool mem_is_zero(const char *beg, uptr size) {
   CHECK_LE(size, 1ULL << FIRST_32_SECOND_64(30, 40));  // Sanity check.
   const char *end = beg + size;
+  uptr all = 0;
+  if (size < sizeof(uptr)) {
+    for (const char *mem = beg; mem < end; mem++) all |= *mem;
+    return all == 0;
+  }
+  // Cover the unaligned head and tail with one word load each. They may
+  // overlap the aligned words, which is harmless for an OR.
+  typedef ALIGNED(1) uptr uuptr;
+  all = *(const uuptr *)beg | *(const uuptr *)(end - sizeof(uptr));
   uptr *aligned_beg = (uptr *)RoundUpTo((uptr)beg, sizeof(uptr));
   uptr *aligned_end = (uptr *)RoundDownTo((uptr)end, sizeof(uptr));
-  uptr all = 0;
-  // Prologue.
-  for (const char *mem = beg; mem < (char*)aligned_beg && mem < end; mem++)
-    all |= *mem;
-  // Aligned loop.
+  // Aligned loop, unrolled so that the loads are independent of each other.
+  for (; aligned_beg + 4 <= aligned_end; aligned_beg += 4)
+    all |= aligned_beg[0] | aligned_beg[1] | aligned_beg[2] | aligned_beg[3];
   for (; aligned_beg < aligned_end; aligned_beg++)
     all |= *aligned_beg;
-  // Epilogue.
-  if ((char *)aligned_end >= beg) {
-    for (const char *mem = (char *)aligned_end; mem < end; mem++) all |= *mem;
-  }
   return all == 0;
 }
 
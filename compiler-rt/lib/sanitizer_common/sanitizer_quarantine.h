@@ -77,7 +77,9 @@ class Quarantine {
       : cache_(LINKER_INITIALIZED) {
   }
 
-  void Init(uptr size, uptr cache_size) {
+  // Chunks larger than max_chunk_size, if it is not zero, bypass the
+  // quarantine, so that a few large chunks do not evict many small ones.
+  void Init(uptr size, uptr cache_size, uptr max_chunk_size = 0) {
     // Thread local quarantine size can be zero only when global quarantine size
     // is zero (it allows us to perform just one atomic read per Put() call).
     CHECK((size == 0 && cache_size == 0) || cache_size != 0);
@@ -85,6 +87,7 @@ class Quarantine {
     atomic_store_relaxed(&max_size_, size);
     atomic_store_relaxed(&min_size_, size / 10 * 9);  // 90% of max size.
     atomic_store_relaxed(&max_cache_size_, cache_size);
+    atomic_store_relaxed(&max_chunk_size_, max_chunk_size);
 
     cache_mutex_.Init();
     recycle_mutex_.Init();
@@ -92,10 +95,13 @@ class Quarantine {
 
   uptr GetMaxSize() const { return atomic_load_relaxed(&max_size_); }
   uptr GetMaxCacheSize() const { return atomic_load_relaxed(&max_cache_size_); }
+  uptr GetMaxChunkSize() const { return atomic_load_relaxed(&max_chunk_size_); }
 
   void Put(Cache *c, Callback cb, Node *ptr, uptr size) {
     uptr max_cache_size = GetMaxCacheSize();
-    if (max_cache_size && size <= GetMaxSize()) {
+    uptr max_chunk_size = GetMaxChunkSize();
+    if (max_cache_size && size <= GetMaxSize() &&
+        (max_chunk_size == 0 || size <= max_chunk_size)) {
       cb.PreQuarantine(ptr);
       c->Enqueue(cb, ptr, size);
     } else {
@@ -127,8 +133,10 @@ class Quarantine {
 
   void PrintStats() const {
     // It assumes that the world is stopped, just as the allocator's PrintStats.
-    Printf("Quarantine limits: global: %zdMb; thread local: %zdKb\n",
-           GetMaxSize() >> 20, GetMaxCacheSize() >> 10);
+    Printf("Quarantine limits: global: %zdMb; thread local: %zdKb; "
+           "chunk: %zdKb\n",
+           GetMaxSize() >> 20, GetMaxCacheSize() >> 10,
+           GetMaxChunkSize() >> 10);
     cache_.PrintStats();
   }
 
@@ -138,6 +146,7 @@ class Quarantine {
   atomic_uintptr_t max_size_;
   atomic_uintptr_t min_size_;
   atomic_uintptr_t max_cache_size_;
+  atomic_uintptr_t max_chunk_size_;
   char pad1_[kCacheLineSize];
   StaticSpinMutex cache_mutex_;
   StaticSpinMutex recycle_mutex_;
@@ -176,4 +176,31 @@ TEST(SanitizerCommon, QuarantineCacheMergeBatchesALotOfBatches) {
   DeallocateCache(&to_deallocate);
 }
 
+static uptr num_passed_through;
+
+struct PutCallback : QuarantineCallback {
+  void PreQuarantine(void *m) {}
+  void RecyclePassThrough(void *m) { num_passed_through++; }
+};
+
+TEST(SanitizerCommon, QuarantineMaxChunkSize) {
+  typedef Quarantine<PutCallback, void> TestQuarantine;
+  static TestQuarantine quarantine(LINKER_INITIALIZED);
+  quarantine.Init(1 << 20, 64 << 10, /*max_chunk_size=*/1024);
+  num_passed_through = 0;
+
+  TestQuarantine::Cache cache;
+  quarantine.Put(&cache, PutCallback(), kFakePtr, 1024);
+  EXPECT_EQ(0UL, num_passed_through);
+  EXPECT_EQ(1024 + sizeof(QuarantineBatch), cache.Size());
+
+  // Larger chunks bypass the quarantine.
+  quarantine.Put(&cache, PutCallback(), kFakePtr, 1025);
+  EXPECT_EQ(1UL, num_passed_through);
+  EXPECT_EQ(1024 + sizeof(QuarantineBatch), cache.Size());
+
+  while (QuarantineBatch *batch = cache.DequeueBatch())
+    cb.Deallocate(batch);
+}
+
 }  // namespace __sanitizer
@@ -175,6 +175,11 @@ struct ThreadState {
 
   atomic_sint32_t pending_signals;
 
+  // Memory access sampling (see the access_sampling flag). On the fast path
+  // only accesses with access_sampling_left == 0 are checked.
+  u32 access_sampling_period;
+  u32 access_sampling_left;
+
   VectorClock clock;
 
   // This is a slow path flag. On fast path, fast_state.GetIgnoreBit() is read.
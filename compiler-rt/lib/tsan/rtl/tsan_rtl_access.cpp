@@ -400,6 +400,20 @@ char* DumpShadow(char* buf, RawShadow raw) {
   return buf;
 }
 
+// Returns true if the access should not be checked because of access
+// sampling. Not checking also means not storing it in the shadow, so later
+// accesses can't race with it.
+ALWAYS_INLINE bool SkipSampledAccess(ThreadState* thr) {
+  if (LIKELY(thr->access_sampling_period == 0))
+    return false;
+  if (thr->access_sampling_left != 0) {
+    thr->access_sampling_left--;
+    return true;
+  }
+  thr->access_sampling_left = thr->access_sampling_period - 1;
+  return false;
+}
+
 // TryTrace* and TraceRestart* functions allow to turn memory access and func
 // entry/exit callbacks into leaf functions with all associated performance
 // benefits. These hottest callbacks do only 2 slow path calls: report a race
@@ -437,6 +451,8 @@ ALWAYS_INLINE USED void MemoryAccess(ThreadState* thr, uptr pc, uptr addr,
     return;
   if (UNLIKELY(fast_state.GetIgnoreBit()))
     return;
+  if (UNLIKELY(SkipSampledAccess(thr)))
+    return;
   if (!TryTraceMemoryAccess(thr, pc, addr, size, typ))
     return TraceRestartMemoryAccess(thr, pc, addr, size, typ);
   CheckRaces(thr, shadow_mem, cur, shadow, access, typ);
@@ -457,6 +473,8 @@ ALWAYS_INLINE USED void MemoryAccess16(ThreadState* thr, uptr pc, uptr addr,
   FastState fast_state = thr->fast_state;
   if (UNLIKELY(fast_state.GetIgnoreBit()))
     return;
+  if (UNLIKELY(SkipSampledAccess(thr)))
+    return;
   Shadow cur(fast_state, 0, 8, typ);
   RawShadow* shadow_mem = MemToShadow(addr);
   bool traced = false;
@@ -494,6 +512,8 @@ ALWAYS_INLINE USED void UnalignedMemoryAccess(ThreadState* thr, uptr pc,
   FastState fast_state = thr->fast_state;
   if (UNLIKELY(fast_state.GetIgnoreBit()))
     return;
+  if (UNLIKELY(SkipSampledAccess(thr)))
+    return;
   RawShadow* shadow_mem = MemToShadow(addr);
   bool traced = false;
   uptr size1 = Min<uptr>(size, RoundUp(addr + 1, kShadowCell) - addr);
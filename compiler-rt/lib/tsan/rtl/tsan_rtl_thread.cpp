@@ -160,6 +160,9 @@ void ThreadStart(ThreadState *thr, Tid tid, tid_t os_id,
   }
   Free(thr->tctx->sync);
 
+  if (flags()->access_sampling > 1)
+    thr->access_sampling_period = flags()->access_sampling;
+
 #if !SANITIZER_GO
   thr->is_inited = true;
 #endif
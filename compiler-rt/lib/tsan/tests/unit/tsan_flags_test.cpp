@@ -49,6 +49,7 @@ static const char *options1 =
   " memory_limit_mb=666"
   " stop_on_start=0"
   " running_on_valgrind=0"
+  " access_sampling=7"
   " history_size=5"
   " io_sync=1"
   " die_after_fork=true"
@@ -72,6 +73,7 @@ static const char *options2 =
   " memory_limit_mb=456"
   " stop_on_start=true"
   " running_on_valgrind=true"
+  " access_sampling=0"
   " history_size=6"
   " io_sync=2"
   " die_after_fork=false"
@@ -95,6 +97,7 @@ void VerifyOptions1(Flags *f) {
   EXPECT_EQ(f->memory_limit_mb, 666);
   EXPECT_EQ(f->stop_on_start, 0);
   EXPECT_EQ(f->running_on_valgrind, 0);
+  EXPECT_EQ(f->access_sampling, 7);
   EXPECT_EQ(f->history_size, (uptr)5);
   EXPECT_EQ(f->io_sync, 1);
   EXPECT_EQ(f->die_after_fork, true);
@@ -118,6 +121,7 @@ void VerifyOptions2(Flags *f) {
   EXPECT_EQ(f->memory_limit_mb, 456);
   EXPECT_EQ(f->stop_on_start, true);
   EXPECT_EQ(f->running_on_valgrind, true);
+  EXPECT_EQ(f->access_sampling, 0);
   EXPECT_EQ(f->history_size, 6ul);
   EXPECT_EQ(f->io_sync, 2);
   EXPECT_EQ(f->die_after_fork, false);
@@ -0,0 +1,28 @@
+// Check that sample_alloc_bytes limits the allocations recorded in the
+// profile. With a large interval at most one allocation of the loop is
+// sampled.
+
+// RUN: %clangxx_memprof -O0 %s -o %t
+// RUN: %env_memprof_opts=print_text=true:log_path=stdout %run %t | FileCheck %s --check-prefix=ALL
+// RUN: %env_memprof_opts=print_text=true:log_path=stdout:sample_alloc_bytes=1000000000 %run %t | FileCheck %s --check-prefix=SAMPLED
+
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char **argv) {
+  for (int i = 0; i < 100; i++) {
+    char *x = (char *)malloc(10);
+    memset(x, 0, 10);
+    free(x);
+  }
+  return 0;
+}
+
+// ALL: Memory allocation stack id = [[ID:[0-9]+]]
+// ALL-NEXT: alloc_count 100,
+
+// With an interval far above what the program allocates, only the first
+// allocation can be sampled: the loop's context is either missing or has a
+// single allocation. The profile is still written.
+// SAMPLED: Recorded MIBs (incl. live on exit):
+// SAMPLED-NOT: alloc_count {{([2-9]|[1-9][0-9]+)}},
@@ -16,6 +16,7 @@
 #include "flang/Optimizer/Builder/FIRBuilder.h"
 #include "flang/Optimizer/Builder/HLFIRTools.h"
 #include "flang/Optimizer/Dialect/FIROps.h"
+#include "flang/Optimizer/Dialect/FIROpsSupport.h"
 #include "flang/Optimizer/Dialect/FIRType.h"
 #include "flang/Optimizer/HLFIR/HLFIRDialect.h"
 #include "flang/Optimizer/HLFIR/HLFIROps.h"
@@ -29,6 +30,7 @@
 #include "mlir/Support/LLVM.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 #include "llvm/ADT/TypeSwitch.h"
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <mlir/Analysis/AliasAnalysis.h>
@@ -271,6 +273,22 @@ static bool areIdenticalOrDisjointSlices(mlir::Value ref1, mlir::Value ref2) {
     return false;
   };
 
+  // With constant bounds, the elements of a triplet are within
+  // [min(lb, ub), max(lb, ub)] whatever the stride, e.g.:
+  //   1:10 does not overlap with 11:20
+  // Likewise, distinct constant scalar subscripts select disjoint slices.
+  auto constantBoundsAreDisjoint = [](mlir::Value lb1, mlir::Value ub1,
+                                      mlir::Value lb2, mlir::Value ub2) {
+    std::optional<std::int64_t> cLb1 = fir::getIntIfConstant(lb1);
+    std::optional<std::int64_t> cUb1 = fir::getIntIfConstant(ub1);
+    std::optional<std::int64_t> cLb2 = fir::getIntIfConstant(lb2);
+    std::optional<std::int64_t> cUb2 = fir::getIntIfConstant(ub2);
+    if (!cLb1 || !cUb1 || !cLb2 || !cUb2)
+      return false;
+    return std::max(*cLb1, *cUb1) < std::min(*cLb2, *cUb2) ||
+           std::max(*cLb2, *cUb2) < std::min(*cLb1, *cUb1);
+  };
+
   des1It = des1.getIndices().begin();
   des2It = des2.getIndices().begin();
   for (bool isTriplet : des1.getIsTriplet()) {
@@ -283,11 +301,15 @@ static bool areIdenticalOrDisjointSlices(mlir::Value ref1, mlir::Value ref2) {
       ++des1It;
       ++des2It;
       if (displacedByConstant(des1Ub, des2Lb) ||
-          displacedByConstant(des2Ub, des1Lb))
+          displacedByConstant(des2Ub, des1Lb) ||
+          constantBoundsAreDisjoint(des1Lb, des1Ub, des2Lb, des2Ub))
         return true;
     } else {
-      ++des1It;
-      ++des2It;
+      mlir::Value des1Index = *des1It++;
+      mlir::Value des2Index = *des2It++;
+      if (constantBoundsAreDisjoint(des1Index, des1Index, des2Index,
+                                    des2Index))
+        return true;
     }
   }
 
@@ -15,6 +15,7 @@
 #include "environment.h"
 #include "tools.h"
 #include "utf.h"
+#include <cstring>
 
 namespace Fortran::runtime::io {
 
@@ -94,21 +95,21 @@ RT_API_ATTRS bool EmitRepeated(CONTEXT &to, char ch, std::size_t n) {
   if (n <= 0) {
     return true;
   }
+  // Emit in chunks; padding and "*" overflow fields would otherwise cost a
+  // call per character.
+  char buffer[64];
+  std::size_t chunk{n < sizeof buffer ? n : sizeof buffer};
+  std::memset(buffer, ch, chunk);
   ConnectionState &connection{to.GetConnectionState()};
-  if (connection.internalIoCharKind <= 1 &&
-      connection.access != Access::Stream) {
-    // faster path, no encoding needed
-    while (n-- > 0) {
-      if (!to.Emit(&ch, 1)) {
-        return false;
-      }
-    }
-  } else {
-    while (n-- > 0) {
-      if (!EmitEncoded(to, &ch, 1)) {
-        return false;
-      }
+  bool noEncoding{connection.internalIoCharKind <= 1 &&
+      connection.access != Access::Stream};
+  while (n > 0) {
+    std::size_t chars{n < chunk ? n : chunk};
+    if (noEncoding ? !to.Emit(buffer, chars)
+                   : !EmitEncoded(to, buffer, chars)) {
+      return false;
     }
+    n -= chars;
   }
   return true;
 }
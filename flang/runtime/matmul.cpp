@@ -73,10 +73,27 @@ private:
 //   DO 1 I = 1, NROWS
 //    DO 1 J = 1, NCOLS
 //   1 RES(I,J) = 0
-//   DO 2 K = 1, N
-//    DO 2 J = 1, NCOLS
+//   DO 2 J = 1, NCOLS
+//    DO 2 K = 1, N, 4
 //     DO 2 I = 1, NROWS
-//   2  RES(I,J) = RES(I,J) + X(I,K)*Y(K,J) ! loop-invariant last term
+//      RES(I,J) = RES(I,J) + X(I,K)*Y(K,J) ! loop-invariant last terms
+//      ...
+//   2  RES(I,J) = RES(I,J) + X(I,K+3)*Y(K+3,J)
+// Unrolling K by four loads and stores each RES(I,J) once per four
+// products instead of once per product. Every element still accumulates
+// its products one at a time in increasing K order, so results are
+// unchanged.
+template <typename XT, bool X_HAS_STRIDED_COLUMNS>
+inline RT_API_ATTRS const XT *NextColumn(
+    const XT *column, SubscriptValue rows, std::size_t xColumnByteStride) {
+  if constexpr (!X_HAS_STRIDED_COLUMNS) {
+    return column + rows;
+  } else {
+    return reinterpret_cast<const XT *>(
+        reinterpret_cast<const char *>(column) + xColumnByteStride);
+  }
+}
+
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT,
     bool X_HAS_STRIDED_COLUMNS, bool Y_HAS_STRIDED_COLUMNS>
 inline RT_API_ATTRS void MatrixTimesMatrix(
@@ -86,27 +103,44 @@ inline RT_API_ATTRS void MatrixTimesMatrix(
     std::size_t yColumnByteStride = 0) {
   using ResultType = CppTypeFor<RCAT, RKIND>;
   std::memset(product, 0, rows * cols * sizeof *product);
-  const XT *RESTRICT xp0{x};
-  for (SubscriptValue k{0}; k < n; ++k) {
-    ResultType *RESTRICT p{product};
-    for (SubscriptValue j{0}; j < cols; ++j) {
-      const XT *RESTRICT xp{xp0};
-      ResultType yv;
-      if constexpr (!Y_HAS_STRIDED_COLUMNS) {
-        yv = static_cast<ResultType>(y[k + j * n]);
-      } else {
-        yv = static_cast<ResultType>(reinterpret_cast<const YT *>(
-            reinterpret_cast<const char *>(y) + j * yColumnByteStride)[k]);
-      }
+  ResultType *RESTRICT p{product};
+  for (SubscriptValue j{0}; j < cols; ++j, p += rows) {
+    const YT *RESTRICT yColumn;
+    if constexpr (!Y_HAS_STRIDED_COLUMNS) {
+      yColumn = y + j * n;
+    } else {
+      yColumn = reinterpret_cast<const YT *>(
+          reinterpret_cast<const char *>(y) + j * yColumnByteStride);
+    }
+    const XT *RESTRICT xp0{x};
+    SubscriptValue k{0};
+    for (; k + 4 <= n; k += 4) {
+      const XT *RESTRICT xp1{
+          NextColumn<XT, X_HAS_STRIDED_COLUMNS>(xp0, rows, xColumnByteStride)};
+      const XT *RESTRICT xp2{
+          NextColumn<XT, X_HAS_STRIDED_COLUMNS>(xp1, rows, xColumnByteStride)};
+      const XT *RESTRICT xp3{
+          NextColumn<XT, X_HAS_STRIDED_COLUMNS>(xp2, rows, xColumnByteStride)};
+      auto yv0{static_cast<ResultType>(yColumn[k])};
+      auto yv1{static_cast<ResultType>(yColumn[k + 1])};
+      auto yv2{static_cast<ResultType>(yColumn[k + 2])};
+      auto yv3{static_cast<ResultType>(yColumn[k + 3])};
       for (SubscriptValue i{0}; i < rows; ++i) {
-        *p++ += static_cast<ResultType>(*xp++) * yv;
+        ResultType sum{p[i]};
+        sum += static_cast<ResultType>(xp0[i]) * yv0;
+        sum += static_cast<ResultType>(xp1[i]) * yv1;
+        sum += static_cast<ResultType>(xp2[i]) * yv2;
+        sum += static_cast<ResultType>(xp3[i]) * yv3;
+        p[i] = sum;
       }
+      xp0 = NextColumn<XT, X_HAS_STRIDED_COLUMNS>(xp3, rows, xColumnByteStride);
     }
-    if constexpr (!X_HAS_STRIDED_COLUMNS) {
-      xp0 += rows;
-    } else {
-      xp0 = reinterpret_cast<const XT *>(
-          reinterpret_cast<const char *>(xp0) + xColumnByteStride);
+    for (; k < n; ++k) {
+      auto yv{static_cast<ResultType>(yColumn[k])};
+      for (SubscriptValue i{0}; i < rows; ++i) {
+        p[i] += static_cast<ResultType>(xp0[i]) * yv;
+      }
+      xp0 = NextColumn<XT, X_HAS_STRIDED_COLUMNS>(xp0, rows, xColumnByteStride);
     }
   }
 }
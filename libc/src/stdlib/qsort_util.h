@@ -15,7 +15,10 @@
 
 namespace LIBC_NAMESPACE::internal {
 
-// A simple quicksort implementation using the Hoare partition scheme.
+// An introsort implementation: quicksort using the Hoare partition scheme and
+// a median-of-three pivot, with insertion sort for small ranges and heapsort
+// once the recursion gets too deep, which bounds the worst case to
+// O(n log n).
 
 using Compare = int(const void *, const void *);
 using CompareWithState = int(const void *, const void *, void *);
@@ -134,17 +137,90 @@ static size_t partition(const Array &array) {
   }
 }
 
+// Moves the median of the first, middle and last elements to the middle, where
+// partition() picks its pivot.
+LIBC_INLINE void move_median_to_middle(const Array &array) {
+  const size_t last = array.size() - 1;
+  const size_t mid = array.size() / 2;
+  if (array.elem_compare(mid, array.get(0)) < 0)
+    array.swap(0, mid);
+  if (array.elem_compare(last, array.get(mid)) < 0) {
+    array.swap(mid, last);
+    if (array.elem_compare(mid, array.get(0)) < 0)
+      array.swap(0, mid);
+  }
+}
+
+LIBC_INLINE void insertion_sort(const Array &array) {
+  for (size_t i = 1; i < array.size(); ++i) {
+    for (size_t j = i; j > 0 && array.elem_compare(j - 1, array.get(j)) > 0;
+         --j)
+      array.swap(j - 1, j);
+  }
+}
+
+LIBC_INLINE void sift_down(const Array &array, size_t root, size_t end) {
+  while (true) {
+    size_t child = 2 * root + 1;
+    if (child >= end)
+      return;
+    if (child + 1 < end && array.elem_compare(child, array.get(child + 1)) < 0)
+      ++child;
+    if (array.elem_compare(root, array.get(child)) >= 0)
+      return;
+    array.swap(root, child);
+    root = child;
+  }
+}
+
+LIBC_INLINE void heap_sort(const Array &array) {
+  const size_t array_size = array.size();
+  for (size_t i = array_size / 2; i-- > 0;)
+    sift_down(array, i, array_size);
+  for (size_t end = array_size; end-- > 1;) {
+    array.swap(0, end);
+    sift_down(array, 0, end);
+  }
+}
+
+// Ranges up to this size are sorted by insertion sort.
+LIBC_INLINE_VAR constexpr size_t INSERTION_SORT_THRESHOLD = 16;
+
+LIBC_INLINE void introsort(const Array &array, size_t depth_limit) {
+  // Recurse into the smaller part and iterate on the larger one, so that the
+  // stack depth stays logarithmic.
+  size_t begin = 0;
+  size_t size = array.size();
+  while (size > INSERTION_SORT_THRESHOLD) {
+    const Array range = array.make_array(begin, size);
+    if (depth_limit == 0) {
+      heap_sort(range);
+      return;
+    }
+    --depth_limit;
+    move_median_to_middle(range);
+    const size_t split_index = partition(range);
+    if (split_index < size - split_index) {
+      introsort(range.make_array(0, split_index), depth_limit);
+      begin += split_index;
+      size -= split_index;
+    } else {
+      introsort(range.make_array(split_index, size - split_index),
+                depth_limit);
+      size = split_index;
+    }
+  }
+  insertion_sort(array.make_array(begin, size));
+}
+
 LIBC_INLINE void quicksort(const Array &array) {
   const size_t array_size = array.size();
   if (array_size <= 1)
     return;
-  size_t split_index = partition(array);
-  if (array_size <= 2) {
-    // The partition operation sorts the two element array.
-    return;
-  }
-  quicksort(array.make_array(0, split_index));
-  quicksort(array.make_array(split_index, array.size() - split_index));
+  size_t depth_limit = 0;
+  for (size_t n = array_size; n > 1; n >>= 1)
+    depth_limit += 2;
+  introsort(array, depth_limit);
 }
 
 } // namespace LIBC_NAMESPACE::internal
@@ -15,12 +15,51 @@
 
 namespace LIBC_NAMESPACE {
 
+// Computes the maximal suffix of the needle for the Two-Way algorithm. With
+// 'reverse' set, the alphabet order is inverted. Returns the position preceding
+// the suffix (possibly SIZE_MAX, i.e. -1) and stores its period in 'period'.
+template <typename Comp>
+LIBC_INLINE constexpr size_t memmem_maximal_suffix(const unsigned char *n,
+                                                   size_t n_len, bool reverse,
+                                                   size_t &period,
+                                                   Comp &&comp) {
+  // 'ip' is one before the candidate suffix, 'jp' the start of the suffix it
+  // is compared against.
+  size_t ip = static_cast<size_t>(-1);
+  size_t jp = 0;
+  size_t k = 1;
+  size_t p = 1;
+  while (jp + k < n_len) {
+    int c = comp(n[ip + k], n[jp + k]);
+    if (reverse)
+      c = -c;
+    if (c == 0) {
+      if (k == p) {
+        jp += p;
+        k = 1;
+      } else {
+        ++k;
+      }
+    } else if (c > 0) {
+      jp += k;
+      k = 1;
+      p = jp - ip;
+    } else {
+      ip = jp++;
+      k = p = 1;
+    }
+  }
+  period = p;
+  return ip;
+}
+
+// Crochemore-Perrin Two-Way string matching. Runs in linear time and constant
+// space, and only needs 'comp' to order bytes consistently, so it works for
+// case-insensitive comparators as well.
 template <typename Comp>
 LIBC_INLINE constexpr static void *
 inline_memmem(const void *haystack, size_t haystack_len, const void *needle,
               size_t needle_len, Comp &&comp) {
-  // TODO: simple brute force implementation. This can be
-  // improved upon using well known string matching algorithms.
   if (!needle_len)
     return const_cast<void *>(haystack);
 
@@ -29,12 +68,56 @@ inline_memmem(const void *haystack, size_t haystack_len, const void *needle,
 
   const unsigned char *h = static_cast<const unsigned char *>(haystack);
   const unsigned char *n = static_cast<const unsigned char *>(needle);
-  for (size_t i = 0; i <= (haystack_len - needle_len); ++i) {
-    size_t j = 0;
-    for (; j < needle_len && !comp(h[i + j], n[j]); ++j)
+
+  if (needle_len == 1) {
+    for (size_t i = 0; i < haystack_len; ++i)
+      if (!comp(h[i], n[0]))
+        return const_cast<unsigned char *>(h + i);
+    return nullptr;
+  }
+
+  // Critical factorization: the later of the two maximal suffixes.
+  size_t period = 0;
+  size_t reverse_period = 0;
+  size_t split = memmem_maximal_suffix(n, needle_len, false, period, comp);
+  size_t reverse_split =
+      memmem_maximal_suffix(n, needle_len, true, reverse_period, comp);
+  if (reverse_split + 1 > split + 1) {
+    split = reverse_split;
+    period = reverse_period;
+  }
+
+  // If the prefix up to the split repeats with 'period', matched bytes can be
+  // remembered across shifts. Otherwise any shift larger than both halves is
+  // safe.
+  size_t memory_reset = needle_len - period;
+  for (size_t i = 0; i < split + 1; ++i) {
+    if (comp(n[i], n[i + period])) {
+      memory_reset = 0;
+      size_t right = needle_len - split - 1;
+      period = (split > right ? split : right) + 1;
+      break;
+    }
+  }
+
+  size_t memory = 0;
+  for (size_t pos = 0; pos <= haystack_len - needle_len;) {
+    // Match the right half, left to right.
+    size_t k = split + 1 > memory ? split + 1 : memory;
+    for (; k < needle_len && !comp(h[pos + k], n[k]); ++k)
+      ;
+    if (k < needle_len) {
+      pos += k - split;
+      memory = 0;
+      continue;
+    }
+    // Match the left half, right to left.
+    for (k = split + 1; k > memory && !comp(h[pos + k - 1], n[k - 1]); --k)
       ;
-    if (j == needle_len)
-      return const_cast<unsigned char *>(h + i);
+    if (k <= memory)
+      return const_cast<unsigned char *>(h + pos);
+    pos += period;
+    memory = memory_reset;
   }
   return nullptr;
 }
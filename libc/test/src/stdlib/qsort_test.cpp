@@ -263,3 +263,16 @@ TEST(LlvmLibcQSortTest, SingleElementArray) {
 
   ASSERT_LE(array[0], ELEM);
 }
+
+TEST(LlvmLibcQsortTest, OrganPipeArray) {
+  // Ascending then descending, a pattern that degrades plain quicksort.
+  constexpr size_t ARRAY_SIZE = 4096;
+  static int array[ARRAY_SIZE];
+  for (size_t i = 0; i < ARRAY_SIZE; ++i)
+    array[i] = int(i < ARRAY_SIZE / 2 ? i : ARRAY_SIZE - i);
+
+  LIBC_NAMESPACE::qsort(array, ARRAY_SIZE, sizeof(int), int_compare);
+
+  for (size_t i = 0; i + 1 < ARRAY_SIZE; ++i)
+    ASSERT_LE(array[i], array[i + 1]);
+}
@@ -126,4 +126,55 @@ TEST(LlvmLibcMemmemTest, ReturnNullIfInadequateHaystackLength) {
     ASSERT_EQ(result, static_cast<void *>(nullptr));
   }
 }
+
+TEST(LlvmLibcMemmemTest, PeriodicNeedle) {
+  {
+    char h[] = {'a', 'b', 'a', 'b', 'a', 'a', 'b', 'a', 'b', 'a', 'b', 'c'};
+    char n[] = {'a', 'b', 'a', 'b', 'c'};
+    void *result = LIBC_NAMESPACE::memmem(h, sizeof(h), n, sizeof(n));
+    ASSERT_EQ(static_cast<char *>(result), h + 7);
+  }
+  {
+    char h[] = {'a', 'a', 'a', 'a', 'b', 'a', 'a', 'a', 'a', 'a', 'b'};
+    char n[] = {'a', 'a', 'a', 'a', 'a', 'b'};
+    void *result = LIBC_NAMESPACE::memmem(h, sizeof(h), n, sizeof(n));
+    ASSERT_EQ(static_cast<char *>(result), h + 5);
+  }
+}
+
+TEST(LlvmLibcMemmemTest, LongHaystackWithoutMatch) {
+  // Brute force needs quadratic time on this input.
+  char h[4096];
+  char n[256];
+  for (size_t i = 0; i < sizeof(h); ++i)
+    h[i] = 'a';
+  for (size_t i = 0; i < sizeof(n); ++i)
+    n[i] = 'a';
+  n[sizeof(n) - 1] = 'b';
+  void *result = LIBC_NAMESPACE::memmem(h, sizeof(h), n, sizeof(n));
+  ASSERT_EQ(result, static_cast<void *>(nullptr));
+  h[sizeof(h) - 1] = 'b';
+  result = LIBC_NAMESPACE::memmem(h, sizeof(h), n, sizeof(n));
+  ASSERT_EQ(static_cast<char *>(result), h + sizeof(h) - sizeof(n));
+}
+
+TEST(LlvmLibcMemmemTest, RepeatedByteNeedle) {
+  // Neither buffer is null terminated, so reading past either one is caught
+  // by the sanitizers.
+  {
+    char h[] = {'b', 'a', 'b', 'a', 'a'};
+    char n[] = {'a', 'a'};
+    void *result = LIBC_NAMESPACE::memmem(h, sizeof(h), n, sizeof(n));
+    ASSERT_EQ(static_cast<char *>(result), h + 3);
+  }
+  {
+    char h[] = {'a', 'a', 'a', 'b', 'a', 'a', 'a', 'a', 'a'};
+    char n[] = {'a', 'a', 'a', 'a'};
+    void *result = LIBC_NAMESPACE::memmem(h, sizeof(h), n, sizeof(n));
+    ASSERT_EQ(static_cast<char *>(result), h + 4);
+    result = LIBC_NAMESPACE::memmem(h, 4, n, sizeof(n));
+    ASSERT_EQ(result, static_cast<void *>(nullptr));
+  }
+}
+
 } // namespace LIBC_NAMESPACE
@@ -112,3 +112,10 @@ TEST(LlvmLibcStrStrTest, MorphedNeedle) {
   ASSERT_STREQ(LIBC_NAMESPACE::strstr(haystack, "tire"), nullptr);
   ASSERT_STREQ(LIBC_NAMESPACE::strstr(haystack, "timo"), nullptr);
 }
+
+TEST(LlvmLibcStrStrTest, RepeatedCharacterNeedle) {
+  const char *haystack = "abaabaaab";
+  ASSERT_STREQ(LIBC_NAMESPACE::strstr(haystack, "aa"), "aabaaab");
+  ASSERT_STREQ(LIBC_NAMESPACE::strstr(haystack, "aaa"), "aaab");
+  ASSERT_STREQ(LIBC_NAMESPACE::strstr(haystack, "aaaa"), nullptr);
+}
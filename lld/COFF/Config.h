@@ -147,6 +147,7 @@ struct Configuration {
   int pdbPageSize = 4096;
   llvm::SmallString<128> pdbPath;
   llvm::SmallString<128> pdbSourcePath;
+  llvm::StringRef ghashCacheDir;
   std::vector<llvm::StringRef> argv;
 
   // Symbols in this set are considered as live by the garbage collector.
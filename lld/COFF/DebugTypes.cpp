@@ -26,10 +26,14 @@
 #include "llvm/DebugInfo/PDB/Native/PDBFile.h"
 #include "llvm/DebugInfo/PDB/Native/TpiHashing.h"
 #include "llvm/DebugInfo/PDB/Native/TpiStream.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/xxhash.h"
 
 using namespace llvm;
 using namespace llvm::codeview;
@@ -582,6 +586,76 @@ void PrecompSource::registerMapping() {
 // Parellel GHash type merging implementation.
 //===----------------------------------------------------------------------===//
 
+// Objects that were not compiled with -gcodeview-ghash (e.g. by MSVC) have no
+// .debug$H section, so their global hashes would be recomputed on every link.
+// With /ghashcache:<dir>, the hashes are stored in <dir> under a name derived
+// from the contents of .debug$T so that later links can simply load them.
+static std::string getGHashCachePath(StringRef dir,
+                                     ArrayRef<uint8_t> debugTypes) {
+  SmallString<128> path(dir);
+  sys::path::append(path, formatv("{0:x-16}-{1}.ghash",
+                                  xxh3_64bits(debugTypes), debugTypes.size()));
+  return std::string(path);
+}
+
+// A cache entry starts with a header identifying the format and the number of
+// hashes, so that truncated or foreign files are not mistaken for hashes.
+static constexpr char ghashCacheMagic[8] = {'L', 'L', 'D', 'G',
+                                            'H', 'S', 'H', '1'};
+
+static std::vector<GloballyHashedType> readGHashCache(StringRef path,
+                                                      size_t numTypes) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+      MemoryBuffer::getFile(path, /*IsText=*/false,
+                            /*RequiresNullTerminator=*/false);
+  if (!mbOrErr)
+    return {};
+  StringRef buf = (*mbOrErr)->getBuffer();
+  const size_t headerSize = sizeof(ghashCacheMagic) + sizeof(uint64_t);
+  if (buf.size() < headerSize ||
+      !buf.starts_with(StringRef(ghashCacheMagic, sizeof(ghashCacheMagic))) ||
+      support::endian::read64le(buf.data() + sizeof(ghashCacheMagic)) !=
+          numTypes ||
+      buf.size() - headerSize != numTypes * sizeof(GloballyHashedType)) {
+    log("ignoring invalid GHASH cache file " + path);
+    return {};
+  }
+  std::vector<GloballyHashedType> hashes(numTypes);
+  memcpy(hashes.data(), buf.data() + headerSize,
+         numTypes * sizeof(GloballyHashedType));
+  return hashes;
+}
+
+static void writeGHashCache(StringRef path,
+                            ArrayRef<GloballyHashedType> hashes) {
+  if (std::error_code ec =
+          sys::fs::create_directories(sys::path::parent_path(path))) {
+    warn("cannot create GHASH cache directory for " + path + ": " +
+         ec.message());
+    return;
+  }
+  // Write to a temporary file and rename it into place so that concurrent
+  // links never observe a partially written cache entry.
+  Expected<sys::fs::TempFile> temp =
+      sys::fs::TempFile::create(path + "-%%%%%%.tmp");
+  if (!temp) {
+    warn("cannot create GHASH cache file for " + path + ": " +
+         toString(temp.takeError()));
+    return;
+  }
+  {
+    raw_fd_ostream os(temp->FD, /*shouldClose=*/false);
+    os.write(ghashCacheMagic, sizeof(ghashCacheMagic));
+    support::endian::write<uint64_t>(os, hashes.size(),
+                                     llvm::endianness::little);
+    os.write(reinterpret_cast<const char *>(hashes.data()),
+             hashes.size() * sizeof(GloballyHashedType));
+  }
+  if (Error e = temp->keep(path))
+    warn("cannot write GHASH cache file " + path + ": " +
+         toString(std::move(e)));
+}
+
 void TpiSource::loadGHashes() {
   if (std::optional<ArrayRef<uint8_t>> debugH = getDebugH(file)) {
     ghashes = getHashesFromDebugH(*debugH);
@@ -590,7 +664,27 @@ void TpiSource::loadGHashes() {
     CVTypeArray types;
     BinaryStreamReader reader(file->debugTypes, llvm::endianness::little);
     cantFail(reader.readArray(types, reader.getLength()));
-    assignGHashesFromVector(GloballyHashedType::hashTypes(types));
+
+    std::string cachePath;
+    if (!ctx.config.ghashCacheDir.empty()) {
+      cachePath = getGHashCachePath(ctx.config.ghashCacheDir, file->debugTypes);
+      // Walking the record prefixes is cheap compared to hashing the records.
+      size_t numTypes = std::distance(types.begin(), types.end());
+      std::vector<GloballyHashedType> hashVec =
+          readGHashCache(cachePath, numTypes);
+      if (!hashVec.empty()) {
+        log("loaded GHASHes for " + toString(file) + " from " + cachePath);
+        assignGHashesFromVector(std::move(hashVec));
+        fillIsItemIndexFromDebugT();
+        return;
+      }
+    }
+
+    std::vector<GloballyHashedType> hashVec =
+        GloballyHashedType::hashTypes(types);
+    if (!cachePath.empty() && !hashVec.empty())
+      writeGHashCache(cachePath, hashVec);
+    assignGHashesFromVector(std::move(hashVec));
   }
 
   fillIsItemIndexFromDebugT();
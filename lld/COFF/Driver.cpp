@@ -1692,6 +1692,7 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
 
     if (auto *arg = args.getLastArg(OPT_pdb_source_path))
       config->pdbSourcePath = arg->getValue();
+    config->ghashCacheDir = args.getLastArgValue(OPT_ghashcache);
   }
 
   // Handle /pdbstripped
@@ -246,6 +246,7 @@ void ErrorHandler::warn(const Twine &msg) {
     return;
 
   std::lock_guard<std::mutex> lock(mu);
+  ++warningCount;
   reportDiagnostic(getLocation(msg), Colors::MAGENTA, "warning", msg);
   sep = getSeparator(msg);
 }
@@ -0,0 +1,65 @@
+//===- LinkProfile.cpp ----------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lld/Common/LinkProfile.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include <tuple>
+
+using namespace lld;
+using namespace llvm;
+
+void LinkProfile::add(StringRef phase, StringRef name,
+                      std::chrono::nanoseconds time, uint64_t bytes) {
+  std::string key = (phase + Twine('\0') + name).str();
+  std::lock_guard<std::mutex> lock(mu);
+  Record &r = records[key];
+  r.time += time;
+  r.bytes += bytes;
+  ++r.count;
+}
+
+// Quote a CSV field if it contains a character with special meaning.
+static void writeField(raw_ostream &os, StringRef s) {
+  if (s.find_first_of(",\"\n") == StringRef::npos) {
+    os << s;
+    return;
+  }
+  os << '"';
+  for (char c : s) {
+    if (c == '"')
+      os << '"';
+    os << c;
+  }
+  os << '"';
+}
+
+void LinkProfile::write(raw_ostream &os) const {
+  std::lock_guard<std::mutex> lock(mu);
+  std::vector<const StringMapEntry<Record> *> v;
+  for (const StringMapEntry<Record> &e : records)
+    v.push_back(&e);
+  llvm::sort(v, [](const StringMapEntry<Record> *a,
+                   const StringMapEntry<Record> *b) {
+    return std::make_tuple(b->second.time, a->first()) <
+           std::make_tuple(a->second.time, b->first());
+  });
+
+  os << "phase,name,milliseconds,bytes,count\n";
+  for (const StringMapEntry<Record> *e : v) {
+    auto [phase, name] = e->first().split('\0');
+    const Record &r = e->second;
+    writeField(os, phase);
+    os << ',';
+    writeField(os, name);
+    os << ',' << format("%.3f", r.time.count() / 1e6) << ',' << r.bytes << ','
+       << r.count << '\n';
+  }
+}
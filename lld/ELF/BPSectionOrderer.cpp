@@ -0,0 +1,343 @@
+//===- BPSectionOrderer.cpp -----------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Balanced Partitioning (llvm/Support/BalancedPartitioning.h) orders
+// "function nodes" so that nodes sharing many "utility nodes" are placed close
+// to each other. This file builds those nodes from input sections in two
+// ways:
+//
+// - For startup, every temporal profile trace is cut into exponentially
+//   growing windows of the functions it executes, and a section gets a
+//   utility node for each window it appears in. Sections executed together
+//   early during startup end up on the same pages.
+//
+// - For compression, a section gets a utility node for each hash of a short
+//   window of its contents (and of its relocation targets). Similar sections
+//   end up next to each other, which helps Lempel-Ziv compressors.
+//
+//===----------------------------------------------------------------------===//
+
+#include "BPSectionOrderer.h"
+#include "Config.h"
+#include "InputFiles.h"
+#include "InputSection.h"
+#include "Symbols.h"
+#include "lld/Common/CommonLinkerContext.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ProfileData/InstrProfReader.h"
+#include "llvm/Support/BalancedPartitioning.h"
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/xxhash.h"
+
+using namespace llvm;
+using namespace llvm::ELF;
+using namespace lld;
+using namespace lld::elf;
+
+using UtilityNodes = SmallVector<BPFunctionNode::UtilityNodeT>;
+
+// Strip the suffixes added by ThinLTO promotion and -funique-internal-linkage-
+// names so that symbol names match the names recorded in the profile.
+static StringRef getRootSymbol(StringRef name) {
+  auto [p0, s0] = name.rsplit(".llvm.");
+  auto [p1, s1] = p0.rsplit(".__uniq.");
+  return p1;
+}
+
+static uint64_t getRelocHash(const Relocation &rel) {
+  // Relocations to the same symbol with the same addend look the same to a
+  // compressor once they are resolved, regardless of where they are.
+  uint64_t hash = rel.sym ? xxh3_64bits(getRootSymbol(rel.sym->getName())) : 0;
+  return hash ^ (uint64_t(rel.addend) * 0x9e3779b97f4a7c15) ^ rel.type;
+}
+
+// Returns true if the order of the section relative to other sections of the
+// same kind is observable at run time. Initializers and finalizers without a
+// priority run in input order, so these sections must keep it.
+static bool isOrderSensitive(const InputSection *sec) {
+  if (sec->type == SHT_INIT_ARRAY || sec->type == SHT_FINI_ARRAY ||
+      sec->type == SHT_PREINIT_ARRAY)
+    return true;
+  StringRef name = sec->name;
+  if (name == ".init" || name == ".fini")
+    return true;
+  for (StringRef prefix : {".ctors", ".dtors"})
+    if (name.consume_front(prefix) && (name.empty() || name[0] == '.'))
+      return true;
+  return false;
+}
+
+static SmallVector<std::pair<unsigned, UtilityNodes>> getUnsForCompression(
+    ArrayRef<const InputSection *> sections, ArrayRef<unsigned> sectionIdxs,
+    DenseMap<unsigned, SmallVector<unsigned>> *duplicateSectionIdxs,
+    BPFunctionNode::UtilityNodeT &maxUN) {
+  TimeTraceScope timeScope("Build nodes for compression");
+
+  SmallVector<std::pair<unsigned, SmallVector<uint64_t>>> sectionHashes;
+  sectionHashes.reserve(sectionIdxs.size());
+  SmallVector<uint64_t> hashes;
+  for (unsigned sectionIdx : sectionIdxs) {
+    const InputSection *isec = sections[sectionIdx];
+    ArrayRef<uint8_t> data = isec->content();
+    constexpr unsigned windowSize = 4;
+    for (size_t i = 0; i < data.size(); ++i)
+      hashes.push_back(xxh3_64bits(data.drop_front(i).take_front(windowSize)));
+    for (const Relocation &rel : isec->relocs())
+      hashes.push_back(getRelocHash(rel));
+
+    llvm::sort(hashes);
+    hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+    sectionHashes.emplace_back(sectionIdx, hashes);
+    hashes.clear();
+  }
+
+  DenseMap<uint64_t, unsigned> hashFrequency;
+  for (auto &[sectionIdx, hashes] : sectionHashes)
+    for (uint64_t hash : hashes)
+      ++hashFrequency[hash];
+
+  if (duplicateSectionIdxs) {
+    // Merge sections that are nearly identical. They will be placed next to
+    // their representative, so they don't need to be partitioned.
+    SmallVector<std::pair<unsigned, SmallVector<uint64_t>>> newSectionHashes;
+    DenseMap<uint64_t, unsigned> wholeHashToSectionIdx;
+    for (auto &[sectionIdx, hashes] : sectionHashes) {
+      uint64_t wholeHash = 0;
+      for (uint64_t hash : hashes)
+        if (hashFrequency[hash] > 5)
+          wholeHash ^= hash;
+      auto [it, inserted] =
+          wholeHashToSectionIdx.try_emplace(wholeHash, sectionIdx);
+      if (inserted)
+        newSectionHashes.emplace_back(sectionIdx, std::move(hashes));
+      else
+        (*duplicateSectionIdxs)[it->second].push_back(sectionIdx);
+    }
+    sectionHashes = std::move(newSectionHashes);
+
+    hashFrequency.clear();
+    for (auto &[sectionIdx, hashes] : sectionHashes)
+      for (uint64_t hash : hashes)
+        ++hashFrequency[hash];
+  }
+
+  // Filter out rare and common hashes and assign each remaining hash a
+  // utility node that doesn't conflict with the startup utility nodes.
+  DenseMap<uint64_t, BPFunctionNode::UtilityNodeT> hashToUN;
+  for (auto &[hash, frequency] : hashFrequency) {
+    if (frequency <= 1 || frequency * 2 > sectionHashes.size())
+      continue;
+    hashToUN[hash] = ++maxUN;
+  }
+
+  SmallVector<std::pair<unsigned, UtilityNodes>> sectionUns;
+  for (auto &[sectionIdx, hashes] : sectionHashes) {
+    UtilityNodes uns;
+    for (uint64_t hash : hashes) {
+      auto it = hashToUN.find(hash);
+      if (it != hashToUN.end())
+        uns.push_back(it->second);
+    }
+    sectionUns.emplace_back(sectionIdx, std::move(uns));
+  }
+  return sectionUns;
+}
+
+DenseMap<const InputSectionBase *, int> elf::runBalancedPartitioning(
+    StringRef profilePath, bool forFunctionCompression, bool forDataCompression,
+    bool compressionSortStartupFunctions, bool verbose) {
+  // Collect the sections that can be reordered, and the names of the symbols
+  // defined in them.
+  SmallVector<const InputSection *> sections;
+  DenseMap<const InputSection *, unsigned> sectionToIdx;
+  StringMap<DenseSet<unsigned>> symbolToSectionIdxs;
+  for (ELFFileBase *file : ctx.objectFiles) {
+    for (Symbol *sym : file->getSymbols()) {
+      auto *d = dyn_cast<Defined>(sym);
+      if (!d || d->file != file)
+        continue;
+      auto *sec = dyn_cast_or_null<InputSection>(d->section);
+      if (!sec || !sec->isLive() || sec->size == 0 ||
+          !(sec->flags & SHF_ALLOC) || sec->type == SHT_NOBITS ||
+          isOrderSensitive(sec))
+        continue;
+      auto [it, inserted] = sectionToIdx.try_emplace(sec, sections.size());
+      if (inserted)
+        sections.push_back(sec);
+      symbolToSectionIdxs[getRootSymbol(d->getName())].insert(it->second);
+    }
+  }
+
+  BPFunctionNode::UtilityNodeT maxUN = 0;
+  DenseMap<unsigned, UtilityNodes> startupSectionIdxUNs;
+  // Used to define the initial order for startup functions.
+  DenseMap<unsigned, size_t> sectionIdxToTimestamp;
+  std::unique_ptr<InstrProfReader> reader;
+  if (!profilePath.empty()) {
+    std::optional<MemoryBufferRef> mb = readFile(profilePath);
+    if (!mb)
+      return {};
+    auto readerOrErr = IndexedInstrProfReader::create(
+        MemoryBuffer::getMemBuffer(*mb, /*RequiresNullTerminator=*/false));
+    if (Error e = readerOrErr.takeError()) {
+      error(profilePath + ": " + toString(std::move(e)));
+      return {};
+    }
+    reader = std::move(*readerOrErr);
+    if (Error e = reader->readHeader()) {
+      error(profilePath + ": " + toString(std::move(e)));
+      return {};
+    }
+
+    DenseMap<unsigned, BPFunctionNode::UtilityNodeT> sectionIdxToFirstUN;
+    for (const TemporalProfTraceTy &trace : reader->getTemporalProfTraces()) {
+      uint64_t currentSize = 0, cutoffSize = 1;
+      size_t cutoffTimestamp = 1;
+      ArrayRef<uint64_t> names = trace.FunctionNameRefs;
+      for (size_t timestamp = 0; timestamp < names.size(); ++timestamp) {
+        auto [filename, funcName] = getParsedIRPGOName(
+            reader->getSymtab().getFuncOrVarName(names[timestamp]));
+        auto it = symbolToSectionIdxs.find(getRootSymbol(funcName));
+        if (it == symbolToSectionIdxs.end())
+          continue;
+        const DenseSet<unsigned> &sectionIdxs = it->second;
+        // If the same symbol is found in multiple sections, they might be
+        // identical, so we arbitrarily use the size from the first section.
+        currentSize += sections[*sectionIdxs.begin()]->getSize();
+
+        // Since BalancedPartitioning is sensitive to the initial order, we
+        // need to explicitly define it to be ordered by earliest timestamp.
+        for (unsigned sectionIdx : sectionIdxs) {
+          auto [tsIt, inserted] =
+              sectionIdxToTimestamp.try_emplace(sectionIdx, timestamp);
+          if (!inserted)
+            tsIt->second = std::min<size_t>(tsIt->second, timestamp);
+        }
+
+        if (timestamp >= cutoffTimestamp || currentSize >= cutoffSize) {
+          ++maxUN;
+          cutoffSize = 2 * currentSize;
+          cutoffTimestamp = 2 * cutoffTimestamp;
+        }
+        for (unsigned sectionIdx : sectionIdxs)
+          sectionIdxToFirstUN.try_emplace(sectionIdx, maxUN);
+      }
+      for (auto &[sectionIdx, firstUN] : sectionIdxToFirstUN)
+        for (auto un = firstUN; un <= maxUN; ++un)
+          startupSectionIdxUNs[sectionIdx].push_back(un);
+      ++maxUN;
+      sectionIdxToFirstUN.clear();
+    }
+  }
+
+  SmallVector<unsigned> sectionIdxsForFunctionCompression,
+      sectionIdxsForDataCompression;
+  for (unsigned sectionIdx = 0; sectionIdx < sections.size(); ++sectionIdx) {
+    if (startupSectionIdxUNs.count(sectionIdx))
+      continue;
+    if (sections[sectionIdx]->flags & SHF_EXECINSTR) {
+      if (forFunctionCompression)
+        sectionIdxsForFunctionCompression.push_back(sectionIdx);
+    } else if (forDataCompression) {
+      sectionIdxsForDataCompression.push_back(sectionIdx);
+    }
+  }
+
+  if (compressionSortStartupFunctions) {
+    SmallVector<unsigned> startupIdxs;
+    for (auto &[sectionIdx, uns] : startupSectionIdxUNs)
+      startupIdxs.push_back(sectionIdx);
+    llvm::sort(startupIdxs);
+    auto unsForStartupFunctionCompression =
+        getUnsForCompression(sections, startupIdxs,
+                             /*duplicateSectionIdxs=*/nullptr, maxUN);
+    for (auto &[sectionIdx, compressionUns] :
+         unsForStartupFunctionCompression) {
+      UtilityNodes &uns = startupSectionIdxUNs[sectionIdx];
+      uns.append(compressionUns);
+      llvm::sort(uns);
+      uns.erase(std::unique(uns.begin(), uns.end()), uns.end());
+    }
+  }
+
+  // Map a section index (ordered directly) to a list of duplicate section
+  // indices (not ordered directly).
+  DenseMap<unsigned, SmallVector<unsigned>> duplicateSectionIdxs;
+  auto unsForFunctionCompression = getUnsForCompression(
+      sections, sectionIdxsForFunctionCompression, &duplicateSectionIdxs,
+      maxUN);
+  auto unsForDataCompression = getUnsForCompression(
+      sections, sectionIdxsForDataCompression, &duplicateSectionIdxs, maxUN);
+
+  std::vector<BPFunctionNode> nodesForStartup, nodesForFunctionCompression,
+      nodesForDataCompression;
+  for (auto &[sectionIdx, uns] : startupSectionIdxUNs)
+    nodesForStartup.emplace_back(sectionIdx, uns);
+  for (auto &[sectionIdx, uns] : unsForFunctionCompression)
+    nodesForFunctionCompression.emplace_back(sectionIdx, uns);
+  for (auto &[sectionIdx, uns] : unsForDataCompression)
+    nodesForDataCompression.emplace_back(sectionIdx, uns);
+
+  // Use the first timestamp to define the initial order for startup nodes.
+  llvm::sort(nodesForStartup,
+             [&](const BPFunctionNode &l, const BPFunctionNode &r) {
+               return std::make_pair(sectionIdxToTimestamp[l.Id], l.Id) <
+                      std::make_pair(sectionIdxToTimestamp[r.Id], r.Id);
+             });
+  // The input order tends to be a good initial order for compression.
+  auto byId = [](const BPFunctionNode &l, const BPFunctionNode &r) {
+    return l.Id < r.Id;
+  };
+  llvm::sort(nodesForFunctionCompression, byId);
+  llvm::sort(nodesForDataCompression, byId);
+
+  {
+    TimeTraceScope timeScope("Balanced Partitioning");
+    BalancedPartitioningConfig config;
+    BalancedPartitioning bp(config);
+    for (std::vector<BPFunctionNode> *nodes :
+         {&nodesForStartup, &nodesForFunctionCompression,
+          &nodesForDataCompression})
+      if (!nodes->empty())
+        bp.run(*nodes);
+  }
+
+  // Sections that are not ordered keep priority 0, so the ordered sections
+  // get negative priorities in the order computed above. Duplicates are
+  // placed right after their representative.
+  SmallVector<const InputSection *, 0> orderedSections;
+  for (std::vector<BPFunctionNode> *nodes :
+       {&nodesForStartup, &nodesForFunctionCompression,
+        &nodesForDataCompression}) {
+    for (const BPFunctionNode &node : *nodes) {
+      orderedSections.push_back(sections[node.Id]);
+      for (unsigned dupIdx : duplicateSectionIdxs.lookup(node.Id))
+        orderedSections.push_back(sections[dupIdx]);
+    }
+  }
+
+  if (verbose) {
+    lld::outs() << "Functions for startup: " << nodesForStartup.size() << "\n"
+                << "Functions for compression: "
+                << nodesForFunctionCompression.size() << "\n"
+                << "Data for compression: " << nodesForDataCompression.size()
+                << "\n"
+                << "Duplicate sections: "
+                << orderedSections.size() - nodesForStartup.size() -
+                       nodesForFunctionCompression.size() -
+                       nodesForDataCompression.size()
+                << "\n";
+  }
+
+  DenseMap<const InputSectionBase *, int> sectionPriorities;
+  int priority = -static_cast<int>(orderedSections.size());
+  for (const InputSection *isec : orderedSections)
+    sectionPriorities.try_emplace(isec, priority++);
+  return sectionPriorities;
+}
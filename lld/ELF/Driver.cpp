@@ -51,6 +51,7 @@
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Config/llvm-config.h"
+#include "llvm/Debuginfod/HTTPClient.h"
 #include "llvm/LTO/LTO.h"
 #include "llvm/Object/Archive.h"
 #include "llvm/Object/IRObjectFile.h"
@@ -66,6 +67,7 @@
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <cstdlib>
 #include <tuple>
 #include <utility>
@@ -113,6 +115,7 @@ void Ctx::reset() {
   scriptSymOrderCounter = 1;
   scriptSymOrder.clear();
   ltoAllVtablesHaveTypeInfos = false;
+  linkProfile.reset();
 }
 
 llvm::raw_fd_ostream Ctx::openAuxiliaryFile(llvm::StringRef filename,
@@ -599,6 +602,107 @@ constexpr const char *saveTempsValues[] = {
     "resolution", "preopt",     "promote", "internalize",  "import",
     "opt",        "precodegen", "prelink", "combinedindex"};
 
+// Returns a fingerprint of everything that determines the output of a link:
+// the lld version, the working directory, the command line, the contents of
+// all files read so far and the contents of the files that link() reads later.
+// Returns 0 if one of the latter cannot be read.
+static uint64_t getLinkFingerprint(opt::InputArgList &args) {
+  llvm::TimeTraceScope timeScope("Fingerprint inputs");
+  SmallVector<uint64_t, 0> hashes(ctx.memoryBuffers.size() * 2);
+  parallelFor(0, ctx.memoryBuffers.size(), [&](size_t i) {
+    const MemoryBuffer &mb = *ctx.memoryBuffers[i];
+    hashes[2 * i] = xxh3_64bits(mb.getBufferIdentifier());
+    hashes[2 * i + 1] = xxh3_64bits(mb.getBuffer());
+  });
+
+  StringRef laterFiles[] = {args.getLastArgValue(OPT_call_graph_ordering_file),
+                            config->irpgoProfilePath, config->ltoSampleProfile,
+                            config->ltoCSProfileFile};
+  for (StringRef path : laterFiles) {
+    if (path.empty())
+      continue;
+    ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr = MemoryBuffer::getFile(
+        path, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+    if (!mbOrErr)
+      return 0;
+    hashes.push_back(xxh3_64bits((*mbOrErr)->getBuffer()));
+  }
+
+  SmallString<128> cwd;
+  sys::fs::current_path(cwd);
+  hashes.push_back(xxh3_64bits(cwd));
+  hashes.push_back(xxh3_64bits(getLLDVersion()));
+  for (const opt::Arg *arg : args)
+    hashes.push_back(xxh3_64bits(arg->getAsString(args)));
+  return xxh3_64bits(ArrayRef(reinterpret_cast<const uint8_t *>(hashes.data()),
+                              hashes.size() * sizeof(uint64_t)));
+}
+
+// Returns the path of the file in the --incremental directory that records
+// the last link producing the output file.
+static std::string getIncrementalStatePath() {
+  SmallString<128> output(config->outputFile);
+  sys::fs::make_absolute(output);
+  SmallString<128> path(config->incrementalDir);
+  path::append(path, utohexstr(xxh3_64bits(output)) + ".state");
+  return std::string(path);
+}
+
+// Identifies the output file as produced by a link with the given
+// fingerprint. If the output file has been modified or replaced since, its
+// stamp changes.
+static std::string getOutputStamp(uint64_t fingerprint) {
+  sys::fs::file_status st;
+  if (sys::fs::status(config->outputFile, st) ||
+      st.type() != sys::fs::file_type::regular_file)
+    return "";
+  return (utohexstr(fingerprint) + " " + Twine(st.getSize()) + " " +
+          Twine(st.getLastModificationTime().time_since_epoch().count()))
+      .str();
+}
+
+static bool canReuseOutput(opt::InputArgList &args, uint64_t fingerprint) {
+  // Files other than the output file are not recorded, so a link writing them
+  // has to be redone.
+  if (config->outputFile == "-" || !config->dependencyFile.empty() ||
+      !config->mapFile.empty() || !config->whyExtract.empty() ||
+      !config->printArchiveStats.empty() || !config->printSymbolOrder.empty() ||
+      !config->ltoObjPath.empty() || !config->optRemarksFilename.empty() ||
+      !config->saveTempsArgs.empty() || config->thinLTOIndexOnly ||
+      config->thinLTOEmitImportsFiles || config->ltoCSProfileGenerate ||
+      config->timeTraceEnabled || ctx.linkProfile || tar)
+    return false;
+
+  // Neither is anything the link reports on stdout.
+  if (config->cref || config->printGcSections || config->printIcfSections ||
+      config->printMemoryUsage || config->trace ||
+      config->bpVerboseSectionOrderer || args.hasArg(OPT_trace_symbol))
+    return false;
+
+  std::string stamp = getOutputStamp(fingerprint);
+  ErrorOr<std::unique_ptr<MemoryBuffer>> mbOrErr =
+      MemoryBuffer::getFile(getIncrementalStatePath(), /*IsText=*/true);
+  return !stamp.empty() && mbOrErr && (*mbOrErr)->getBuffer() == stamp;
+}
+
+static void writeIncrementalState(uint64_t fingerprint) {
+  std::string stamp = getOutputStamp(fingerprint);
+  if (stamp.empty())
+    return;
+  std::error_code ec = sys::fs::create_directories(config->incrementalDir);
+  if (ec) {
+    warn("--incremental: cannot create " + config->incrementalDir + ": " +
+         ec.message());
+    return;
+  }
+  std::string path = getIncrementalStatePath();
+  raw_fd_ostream os(path, ec, sys::fs::OF_None);
+  if (ec)
+    warn("--incremental: cannot open " + path + ": " + ec.message());
+  else
+    os << stamp;
+}
+
 void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
   ELFOptTable parser;
   opt::InputArgList args = parser.parse(argsArr.slice(1));
@@ -663,6 +767,8 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
   // Initialize time trace profiler.
   if (config->timeTraceEnabled)
     timeTraceProfilerInitialize(config->timeTraceGranularity, config->progName);
+  if (args.hasArg(OPT_link_profile))
+    ctx.linkProfile = std::make_unique<LinkProfile>();
 
   {
     llvm::TimeTraceScope timeScope("ExecuteLinker");
@@ -678,7 +784,22 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
     if (errorCount())
       return;
 
-    invokeELFT(link, args);
+    // With --incremental, skip the link if it would reproduce the output of
+    // the previous one.
+    uint64_t fingerprint = 0;
+    if (!config->incrementalDir.empty())
+      fingerprint = getLinkFingerprint(args);
+    if (fingerprint && canReuseOutput(args, fingerprint)) {
+      log("--incremental: " + config->outputFile + " is up to date");
+    } else {
+      // A link that warns is not recorded, so that the next one reports the
+      // warnings again.
+      uint64_t warnings = errorHandler().warningCount;
+      invokeELFT(link, args);
+      if (fingerprint && !errorCount() &&
+          errorHandler().warningCount == warnings)
+        writeIncrementalState(fingerprint);
+    }
   }
 
   if (config->timeTraceEnabled) {
@@ -686,6 +807,16 @@ void LinkerDriver::linkerMain(ArrayRef<const char *> argsArr) {
         args.getLastArgValue(OPT_time_trace_eq).str(), config->outputFile));
     timeTraceProfilerCleanup();
   }
+
+  if (ctx.linkProfile) {
+    StringRef path = args.getLastArgValue(OPT_link_profile);
+    std::error_code ec;
+    raw_fd_ostream os = ctx.openAuxiliaryFile(path, ec);
+    if (ec)
+      error("cannot open " + path + ": " + ec.message());
+    else
+      ctx.linkProfile->write(os);
+  }
 }
 
 static std::string getRpath(opt::InputArgList &args) {
@@ -1304,6 +1435,7 @@ static void readConfigs(opt::InputArgList &args) {
       args.hasArg(OPT_ignore_data_address_equality);
   config->ignoreFunctionAddressEquality =
       args.hasArg(OPT_ignore_function_address_equality);
+  config->incrementalDir = args.getLastArgValue(OPT_incremental);
   config->init = args.getLastArgValue(OPT_init, "_init");
   config->ltoAAPipeline = args.getLastArgValue(OPT_lto_aa_pipeline);
   config->ltoCSProfileGenerate = args.hasArg(OPT_lto_cs_profile_generate);
@@ -1313,6 +1445,8 @@ static void readConfigs(opt::InputArgList &args) {
   config->ltoDebugPassManager = args.hasArg(OPT_lto_debug_pass_manager);
   config->ltoEmitAsm = args.hasArg(OPT_lto_emit_asm);
   config->ltoNewPmPasses = args.getLastArgValue(OPT_lto_newpm_passes);
+  config->ltoPartitionNewPmPasses =
+      args.getLastArgValue(OPT_lto_partition_newpm_passes);
   config->ltoWholeProgramVisibility =
       args.hasFlag(OPT_lto_whole_program_visibility,
                    OPT_no_lto_whole_program_visibility, false);
@@ -1416,6 +1550,13 @@ static void readConfigs(opt::InputArgList &args) {
   config->thinLTOCachePolicy = CHECK(
       parseCachePruningPolicy(args.getLastArgValue(OPT_thinlto_cache_policy)),
       "--thinlto-cache-policy: invalid cache policy");
+  config->thinLTORemoteCache = args.getLastArgValue(OPT_thinlto_remote_cache);
+  if (!config->thinLTORemoteCache.empty()) {
+    if (config->thinLTOCacheDir.empty())
+      error("--thinlto-remote-cache= requires --thinlto-cache-dir=");
+    // This must be done while lld is still single-threaded.
+    HTTPClient::initialize();
+  }
   config->thinLTOEmitImportsFiles = args.hasArg(OPT_thinlto_emit_imports_files);
   config->thinLTOEmitIndexFiles = args.hasArg(OPT_thinlto_emit_index_files) ||
                                   args.hasArg(OPT_thinlto_index_only) ||
@@ -1667,6 +1808,12 @@ static void readConfigs(opt::InputArgList &args) {
     error("--lto-partitions: number of threads must be > 0");
   if (!get_threadpool_strategy(config->thinLTOJobs))
     error("--thinlto-jobs: invalid job count: " + config->thinLTOJobs);
+  int64_t thinLTOMemoryBudget =
+      args::getInteger(args, OPT_thinlto_memory_budget_eq, 0);
+  if (thinLTOMemoryBudget < 0)
+    error("--thinlto-memory-budget: budget must be >= 0");
+  else
+    config->thinLTOMemoryBudget = uint64_t(thinLTOMemoryBudget) << 20;
 
   if (config->splitStackAdjustSize < 0)
     error("--split-stack-adjust-size: size must be >= 0");
@@ -1733,6 +1880,41 @@ static void readConfigs(opt::InputArgList &args) {
     }
   }
 
+  config->irpgoProfilePath = args.getLastArgValue(OPT_irpgo_profile);
+  if (auto *arg = args.getLastArg(OPT_bp_startup_sort)) {
+    StringRef s = arg->getValue();
+    if (s == "function")
+      config->bpStartupFunctionSort = true;
+    else if (s != "none")
+      error("unknown --bp-startup-sort= value: " + s);
+  }
+  if (auto *arg = args.getLastArg(OPT_bp_compression_sort)) {
+    StringRef s = arg->getValue();
+    if (s == "function" || s == "both")
+      config->bpFunctionOrderForCompression = true;
+    if (s == "data" || s == "both")
+      config->bpDataOrderForCompression = true;
+    if (s != "function" && s != "data" && s != "both" && s != "none")
+      error("unknown --bp-compression-sort= value: " + s);
+  }
+  config->bpCompressionSortStartupFunctions =
+      args.hasFlag(OPT_bp_compression_sort_startup_functions,
+                   OPT_no_bp_compression_sort_startup_functions, false);
+  config->bpVerboseSectionOrderer = args.hasArg(OPT_verbose_bp_section_orderer);
+  if (config->bpStartupFunctionSort && config->irpgoProfilePath.empty())
+    error("--bp-startup-sort=function must be used with --irpgo-profile");
+  if (config->bpCompressionSortStartupFunctions &&
+      !config->bpStartupFunctionSort)
+    error("--bp-compression-sort-startup-functions must be used with "
+          "--bp-startup-sort=function");
+  // Balanced partitioning replaces call graph profile sorting, but sections
+  // ordered by --symbol-ordering-file or --call-graph-ordering-file are placed
+  // first and balanced partitioning orders the rest.
+  if ((config->bpStartupFunctionSort || config->bpFunctionOrderForCompression ||
+       config->bpDataOrderForCompression) &&
+      !args.hasArg(OPT_call_graph_ordering_file))
+    config->callGraphProfileSort = CGProfileSortKind::None;
+
   assert(config->versionDefinitions.empty());
   config->versionDefinitions.push_back(
       {"local", (uint16_t)VER_NDX_LOCAL, {}, {}});
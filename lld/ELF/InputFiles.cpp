@@ -351,6 +351,9 @@ static void doParseFiles(const std::vector<InputFile *> &files,
   // addDependentLibrary.
   for (size_t i = 0; i < files.size(); ++i) {
     llvm::TimeTraceScope timeScope("Parse input files", files[i]->getName());
+    LinkProfileScope profileScope(
+        ctx.linkProfile.get(), "parse", [&] { return toString(files[i]); },
+        files[i]->mb.getBufferSize());
     doParseFile<ELFT>(files[i]);
   }
   if (armCmseImpLib)
@@ -1131,10 +1134,8 @@ void ObjFile<ELFT>::initializeSymbols(const object::ELFFile<ELFT> &obj) {
     symbols = std::make_unique<Symbol *[]>(numSymbols);
   }
 
-  // Some entries have been filled by LazyObjFile.
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
-    if (!symbols[i])
-      symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
+    symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
 
   // Perform symbol resolution on non-local symbols.
   SmallVector<unsigned, 32> undefineds;
@@ -1883,17 +1884,19 @@ ELFFileBase *elf::createObjFile(MemoryBufferRef mb, StringRef archiveName,
 
 template <class ELFT> void ObjFile<ELFT>::parseLazy() {
   const ArrayRef<typename ELFT::Sym> eSyms = this->getELFSyms<ELFT>();
-  numSymbols = eSyms.size();
-  symbols = std::make_unique<Symbol *[]>(numSymbols);
 
+  // Most members of a large archive are never extracted, so don't allocate
+  // the symbols array here. initializeSymbols allocates it and looks up the
+  // names again if this file is extracted.
+  //
   // resolve() may trigger this->extract() if an existing symbol is an undefined
   // symbol. If that happens, this function has served its purpose, and we can
   // exit from the loop early.
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
     if (eSyms[i].st_shndx == SHN_UNDEF)
       continue;
-    symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
-    symbols[i]->resolve(LazySymbol{*this});
+    symtab.insert(CHECK(eSyms[i].getName(stringTable), this))
+        ->resolve(LazySymbol{*this});
     if (!lazy)
       break;
   }
@@ -196,10 +196,14 @@ public:
     return llvm::ArrayRef(symbols.get() + 1, firstGlobal - 1);
   }
   ArrayRef<Symbol *> getGlobalSymbols() {
+    if (numSymbols == 0)
+      return {};
     return llvm::ArrayRef(symbols.get() + firstGlobal,
                           numSymbols - firstGlobal);
   }
   MutableArrayRef<Symbol *> getMutableGlobalSymbols() {
+    if (numSymbols == 0)
+      return {};
     return llvm::MutableArrayRef(symbols.get() + firstGlobal,
                                      numSymbols - firstGlobal);
   }
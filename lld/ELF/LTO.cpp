@@ -22,6 +22,7 @@
 #include "llvm/ADT/Twine.h"
 #include "llvm/BinaryFormat/ELF.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Debuginfod/RemoteCache.h"
 #include "llvm/LTO/Config.h"
 #include "llvm/LTO/LTO.h"
 #include "llvm/Support/Caching.h"
@@ -90,6 +91,10 @@ static lto::Config createConfig() {
   c.Options.UniqueBasicBlockSectionNames =
       config->ltoUniqueBasicBlockSectionNames;
 
+  // If the code generator compresses debug sections, let it use as many
+  // threads as the rest of the link.
+  c.Options.MCOptions.CompressDebugSectionsThreads = config->threadCount;
+
   if (auto relocModel = getRelocModelFromCMModel())
     c.RelocModel = *relocModel;
   else if (config->relocatable)
@@ -112,6 +117,7 @@ static lto::Config createConfig() {
 
   // Set up a custom pipeline if we've been asked to.
   c.OptPipeline = std::string(config->ltoNewPmPasses);
+  c.PartitionOptPipeline = std::string(config->ltoPartitionNewPmPasses);
   c.AAPipeline = std::string(config->ltoAAPipeline);
 
   // Set up optimization remarks if we've been asked to.
@@ -138,6 +144,8 @@ static lto::Config createConfig() {
 
   for (const llvm::StringRef &name : config->thinLTOModulesToCompile)
     c.ThinLTOModulesToCompile.emplace_back(name);
+  c.ThinLTOMemoryBudget = config->thinLTOMemoryBudget;
+  c.ThinLTOImportCacheDir = std::string(config->thinLTOCacheDir);
 
   c.TimeTraceEnabled = config->timeTraceEnabled;
   c.TimeTraceGranularity = config->timeTraceGranularity;
@@ -314,14 +322,22 @@ std::vector<InputFile *> BitcodeCompiler::compile() {
   // The --thinlto-cache-dir option specifies the path to a directory in which
   // to cache native object files for ThinLTO incremental builds. If a path was
   // specified, configure LTO to use it as the cache directory.
+  // With --thinlto-remote-cache, the directory is backed by a cache shared
+  // with other machines.
   FileCache cache;
-  if (!config->thinLTOCacheDir.empty())
+  auto addBuffer = [&](size_t task, const Twine &moduleName,
+                       std::unique_ptr<MemoryBuffer> mb) {
+    files[task] = std::move(mb);
+    filenames[task] = moduleName.str();
+  };
+  RemoteCacheUploader uploader;
+  if (!config->thinLTORemoteCache.empty())
+    cache = check(remoteCache("ThinLTO", "Thin", config->thinLTOCacheDir,
+                              config->thinLTORemoteCache, uploader,
+                              addBuffer));
+  else if (!config->thinLTOCacheDir.empty())
     cache = check(localCache("ThinLTO", "Thin", config->thinLTOCacheDir,
-                             [&](size_t task, const Twine &moduleName,
-                                 std::unique_ptr<MemoryBuffer> mb) {
-                               files[task] = std::move(mb);
-                               filenames[task] = moduleName.str();
-                             }));
+                             addBuffer));
 
   if (!ctx.bitcodeFiles.empty())
     checkError(ltoObj->run(
@@ -332,6 +348,12 @@ std::vector<InputFile *> BitcodeCompiler::compile() {
         },
         cache));
 
+  // Entries missing from the remote cache are uploaded while the backends
+  // run. A failed upload only costs other machines a cache hit.
+  handleAllErrors(uploader.wait(), [](const ErrorInfoBase &e) {
+    warn("--thinlto-remote-cache: " + e.message());
+  });
+
   // Emit empty index files for non-indexed files but not in single-module mode.
   if (config->thinLTOModulesToCompile.empty()) {
     for (StringRef s : thinIndices) {
@@ -31,6 +31,7 @@
 #include "lld/Common/Strings.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Object/ELF.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/TimeProfiler.h"
 #include <vector>
 
@@ -53,10 +54,24 @@ private:
   void enqueue(InputSectionBase *sec, uint64_t offset);
   void markSymbol(Symbol *sym);
   void mark();
+  void visit(InputSectionBase &sec);
+
+  // Side effects of visiting a batch of sections, recorded by markParallel
+  // and applied serially afterwards.
+  struct Shard {
+    SmallVector<Symbol *, 0> syms;
+    SmallVector<std::pair<InputSectionBase *, uint64_t>, 0> targets;
+  };
+  void markParallel();
+  void collect(InputSectionBase &sec, Shard &shard);
+  void markUsed(Symbol &sym);
 
   template <class RelTy>
   void resolveReloc(InputSectionBase &sec, RelTy &rel, bool fromFDE);
 
+  template <class RelTy>
+  void collectReloc(InputSectionBase &sec, RelTy &rel, Shard &shard);
+
   template <class RelTy>
   void scanEhFrameSection(EhInputSection &eh, ArrayRef<RelTy> rels);
 
@@ -301,25 +316,122 @@ template <class ELFT> void MarkLive<ELFT>::run() {
 }
 
 template <class ELFT> void MarkLive<ELFT>::mark() {
-  // Mark all reachable sections.
+  // Mark all reachable sections. If threading is enabled, large worklists are
+  // visited in parallel. This is only done for the main partition when there
+  // are no other partitions, because markUsed relies on every symbol's
+  // reference side effects being applied at most once.
+  bool canParallelize =
+      parallel::strategy.ThreadsRequested != 1 && partitions.size() == 1;
   while (!queue.empty()) {
-    InputSectionBase &sec = *queue.pop_back_val();
+    if (canParallelize && queue.size() >= 1024) {
+      markParallel();
+      continue;
+    }
+    visit(*queue.pop_back_val());
+  }
+}
 
-    const RelsOrRelas<ELFT> rels = sec.template relsOrRelas<ELFT>();
-    for (const typename ELFT::Rel &rel : rels.rels)
-      resolveReloc(sec, rel, false);
-    for (const typename ELFT::Rela &rel : rels.relas)
-      resolveReloc(sec, rel, false);
+template <class ELFT> void MarkLive<ELFT>::visit(InputSectionBase &sec) {
+  const RelsOrRelas<ELFT> rels = sec.template relsOrRelas<ELFT>();
+  for (const typename ELFT::Rel &rel : rels.rels)
+    resolveReloc(sec, rel, false);
+  for (const typename ELFT::Rela &rel : rels.relas)
+    resolveReloc(sec, rel, false);
 
-    for (InputSectionBase *isec : sec.dependentSections)
-      enqueue(isec, 0);
+  for (InputSectionBase *isec : sec.dependentSections)
+    enqueue(isec, 0);
+
+  // Mark the next group member.
+  if (sec.nextInSectionGroup)
+    enqueue(sec.nextInSectionGroup, 0);
+}
 
-    // Mark the next group member.
-    if (sec.nextInSectionGroup)
-      enqueue(sec.nextInSectionGroup, 0);
+// Visit all queued sections concurrently. Scanning relocations is the
+// expensive part of marking, and it only reads linker state, so each shard of
+// the queue records the symbols it uses and the sections it reaches in its own
+// buffer. The buffers are then applied serially in shard order, which may
+// queue more sections. Liveness is a fixpoint that doesn't depend on the
+// visiting order, so the result is identical to that of the serial marker.
+template <class ELFT> void MarkLive<ELFT>::markParallel() {
+  SmallVector<InputSection *, 0> sections = std::move(queue);
+  queue.clear();
+
+  const size_t numShards = 256;
+  size_t step = divideCeil(sections.size(), numShards);
+  SmallVector<Shard, 0> shards(numShards);
+  parallelFor(0, numShards, [&](size_t i) {
+    size_t end = std::min(sections.size(), (i + 1) * step);
+    for (size_t j = i * step; j < end; ++j)
+      collect(*sections[j], shards[i]);
+  });
+
+  for (Shard &shard : shards) {
+    for (Symbol *sym : shard.syms)
+      markUsed(*sym);
+    for (auto [sec, offset] : shard.targets)
+      enqueue(sec, offset);
   }
 }
 
+// The read-only counterpart of visit, called concurrently by markParallel.
+template <class ELFT>
+void MarkLive<ELFT>::collect(InputSectionBase &sec, Shard &shard) {
+  const RelsOrRelas<ELFT> rels = sec.template relsOrRelas<ELFT>();
+  for (const typename ELFT::Rel &rel : rels.rels)
+    collectReloc(sec, rel, shard);
+  for (const typename ELFT::Rela &rel : rels.relas)
+    collectReloc(sec, rel, shard);
+
+  for (InputSectionBase *isec : sec.dependentSections)
+    shard.targets.emplace_back(isec, 0);
+  if (sec.nextInSectionGroup)
+    shard.targets.emplace_back(sec.nextInSectionGroup, 0);
+}
+
+// The read-only counterpart of resolveReloc with fromFDE being false. Neither
+// symbols nor sections are modified while shards are being collected, so
+// references that would be no-ops for resolveReloc can be dropped early to
+// keep the shards small.
+template <class ELFT>
+template <class RelTy>
+void MarkLive<ELFT>::collectReloc(InputSectionBase &sec, RelTy &rel,
+                                  Shard &shard) {
+  Symbol &sym = sec.file->getRelocTargetSym(rel);
+  if (!sym.used)
+    shard.syms.push_back(&sym);
+
+  auto *d = dyn_cast<Defined>(&sym);
+  if (!d)
+    return;
+  auto *relSec = dyn_cast_or_null<InputSectionBase>(d->section);
+  if (!relSec ||
+      (relSec->partition == partition && !isa<MergeInputSection>(relSec)))
+    return;
+
+  uint64_t offset = d->value;
+  if (d->isSection())
+    offset += getAddend<ELFT>(sec, rel);
+  shard.targets.emplace_back(relSec, offset);
+}
+
+// Apply the symbol side effects of resolveReloc for a symbol collected by
+// markParallel. The first time a symbol is used, the effects are applied, so
+// later references to it can be skipped.
+template <class ELFT> void MarkLive<ELFT>::markUsed(Symbol &sym) {
+  if (sym.used)
+    return;
+  sym.used = true;
+  if (isa<Defined>(sym))
+    return;
+
+  if (auto *ss = dyn_cast<SharedSymbol>(&sym))
+    if (!ss->isWeak())
+      cast<SharedFile>(ss->file)->isNeeded = true;
+
+  for (InputSectionBase *sec : cNamedSections.lookup(sym.getName()))
+    enqueue(sec, 0);
+}
+
 // Move the sections for some symbols to the main partition, specifically ifuncs
 // (because they can result in an IRELATIVE being added to the main partition's
 // GOT, which means that the ifunc must be available when the main partition is
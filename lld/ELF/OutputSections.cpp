@@ -506,6 +506,12 @@ void OutputSection::writeTo(uint8_t *buf, parallel::TaskGroup &tg) {
     fill(buf, sections.empty() ? size : sections[0]->outSecOff, filler);
 
   auto fn = [=](size_t begin, size_t end) {
+    LinkProfileScope profileScope(
+        ctx.linkProfile.get(), "write", [&] { return name.str(); },
+        begin == end ? 0
+                     : sections[end - 1]->outSecOff +
+                           sections[end - 1]->getSize() -
+                           sections[begin]->outSecOff);
     size_t numSections = sections.size();
     for (size_t i = begin; i != end; ++i) {
       InputSection *isec = sections[i];
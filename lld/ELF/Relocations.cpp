@@ -1626,18 +1626,43 @@ template <class ELFT> void elf::scanRelocations() {
   bool serial = !config->zCombreloc || config->emachine == EM_MIPS ||
                 config->emachine == EM_PPC64;
   parallel::TaskGroup tg;
+
+  // Split the work into tasks of roughly the same number of relocations
+  // rather than one task per file, so that a few large object files (e.g. the
+  // output of a full LTO link) don't leave the other threads idle. Tasks
+  // preserve the input order, which matters in serial mode.
+  SmallVector<InputSectionBase *, 0> taskSections;
+  size_t taskRelocs = 0;
+  auto spawn = [&] {
+    tg.spawn(
+        [sections = std::move(taskSections)] {
+          RelocationScanner scanner;
+          for (InputSectionBase *s : sections) {
+            LinkProfileScope profileScope(ctx.linkProfile.get(),
+                                          "scan relocations",
+                                          [&] { return toString(s->file); });
+            scanner.template scanSection<ELFT>(*s);
+          }
+        },
+        serial);
+    taskSections.clear();
+    taskRelocs = 0;
+  };
   for (ELFFileBase *f : ctx.objectFiles) {
-    auto fn = [f]() {
-      RelocationScanner scanner;
-      for (InputSectionBase *s : f->getSections()) {
-        if (s && s->kind() == SectionBase::Regular && s->isLive() &&
-            (s->flags & SHF_ALLOC) &&
-            !(s->type == SHT_ARM_EXIDX && config->emachine == EM_ARM))
-          scanner.template scanSection<ELFT>(*s);
-      }
-    };
-    tg.spawn(fn, serial);
+    for (InputSectionBase *s : f->getSections()) {
+      if (!s || s->kind() != SectionBase::Regular || !s->isLive() ||
+          !(s->flags & SHF_ALLOC) ||
+          (s->type == SHT_ARM_EXIDX && config->emachine == EM_ARM))
+        continue;
+      const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
+      taskSections.push_back(s);
+      taskRelocs += rels.rels.size() + rels.relas.size();
+      if (taskRelocs >= 4096)
+        spawn();
+    }
   }
+  if (!taskSections.empty())
+    spawn();
 
   tg.spawn([] {
     RelocationScanner scanner;
@@ -3910,18 +3910,73 @@ void MergeNoTailSection::finalizeContents() {
   const size_t concurrency =
       llvm::bit_floor(std::min<size_t>(config->threadCount, numShards));
 
-  // Add section pieces to the builders.
-  parallelFor(0, concurrency, [&](size_t threadId) {
+  // pieceBase[i] is the index of the first piece of sections[i] when the
+  // pieces of all sections are numbered consecutively.
+  SmallVector<uint32_t, 0> pieceBase;
+  size_t numPieces = 0;
+  if (concurrency > 1) {
+    pieceBase.reserve(sections.size() + 1);
     for (MergeInputSection *sec : sections) {
-      for (size_t i = 0, e = sec->pieces.size(); i != e; ++i) {
-        if (!sec->pieces[i].live)
-          continue;
-        size_t shardId = getShardId(sec->pieces[i].hash);
-        if ((shardId & (concurrency - 1)) == threadId)
+      pieceBase.push_back(numPieces);
+      numPieces += sec->pieces.size();
+    }
+    pieceBase.push_back(numPieces);
+  }
+
+  // Add section pieces to the builders. A single thread walks the pieces once
+  // and needs no side data. The same walk is used if the pieces cannot be
+  // numbered with 32 bits.
+  if (concurrency == 1 || numPieces > UINT32_MAX) {
+    parallelFor(0, concurrency, [&](size_t threadId) {
+      for (MergeInputSection *sec : sections) {
+        for (size_t i = 0, e = sec->pieces.size(); i != e; ++i) {
+          if (!sec->pieces[i].live)
+            continue;
+          size_t shardId = getShardId(sec->pieces[i].hash);
+          if ((shardId & (concurrency - 1)) == threadId)
+            sec->pieces[i].outputOff = shards[shardId].add(sec->getData(i));
+        }
+      }
+    });
+  } else {
+    // With several threads, bucket the live pieces by shard first so that
+    // every piece is inspected once rather than once per thread. A bucket
+    // entry is the 4-byte consecutive index of a piece. Sections are split
+    // into contiguous chunks with their own buckets; concatenating the
+    // buckets of a shard in chunk order lists its pieces in input order,
+    // which keeps the output the same.
+    const size_t numChunks = std::min<size_t>(sections.size(), 256);
+    const size_t step =
+        divideCeil(sections.size(), std::max<size_t>(numChunks, 1));
+    auto buckets =
+        std::make_unique<std::array<SmallVector<uint32_t, 0>, numShards>[]>(
+            numChunks);
+    parallelFor(0, numChunks, [&](size_t chunk) {
+      size_t end = std::min(sections.size(), (chunk + 1) * step);
+      for (size_t secIdx = chunk * step; secIdx < end; ++secIdx) {
+        ArrayRef<SectionPiece> pieces = sections[secIdx]->pieces;
+        for (size_t i = 0, e = pieces.size(); i != e; ++i)
+          if (pieces[i].live)
+            buckets[chunk][getShardId(pieces[i].hash)].push_back(
+                pieceBase[secIdx] + i);
+      }
+    });
+
+    parallelFor(0, numShards, [&](size_t shardId) {
+      // Bucket entries are increasing, so the owning section is found by
+      // advancing a cursor rather than by searching pieceBase.
+      size_t secIdx = 0;
+      for (size_t chunk = 0; chunk != numChunks; ++chunk) {
+        for (uint32_t idx : buckets[chunk][shardId]) {
+          while (pieceBase[secIdx + 1] <= idx)
+            ++secIdx;
+          MergeInputSection *sec = sections[secIdx];
+          size_t i = idx - pieceBase[secIdx];
           sec->pieces[i].outputOff = shards[shardId].add(sec->getData(i));
+        }
       }
-    }
-  });
+    });
+  }
 
   // Compute an in-section offset for each shard.
   size_t off = 0;
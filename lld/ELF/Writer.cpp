@@ -9,6 +9,7 @@
 #include "Writer.h"
 #include "AArch64ErrataFix.h"
 #include "ARMErrataFix.h"
+#include "BPSectionOrderer.h"
 #include "CallGraphSort.h"
 #include "Config.h"
 #include "InputFiles.h"
@@ -1036,8 +1037,9 @@ static void maybeShuffle(DenseMap<const InputSectionBase *, int> &order) {
 }
 
 // Builds section order for handling --symbol-ordering-file.
-static DenseMap<const InputSectionBase *, int> buildSectionOrder() {
+static DenseMap<const InputSectionBase *, int> buildExplicitSectionOrder() {
   DenseMap<const InputSectionBase *, int> sectionOrder;
+
   // Use the rarely used option --call-graph-ordering-file to sort sections.
   if (!config->callGraphProfile.empty())
     return computeCallGraphProfileOrder();
@@ -1093,6 +1095,37 @@ static DenseMap<const InputSectionBase *, int> buildSectionOrder() {
   return sectionOrder;
 }
 
+// Builds the section order from the ordering options. Like in the Mach-O port,
+// explicitly ordered sections come first and balanced partitioning orders the
+// remaining ones after them.
+static DenseMap<const InputSectionBase *, int> buildSectionOrder() {
+  DenseMap<const InputSectionBase *, int> sectionOrder =
+      buildExplicitSectionOrder();
+  if (!config->bpStartupFunctionSort &&
+      !config->bpFunctionOrderForCompression &&
+      !config->bpDataOrderForCompression)
+    return sectionOrder;
+
+  TimeTraceScope timeScope("Balanced Partitioning Section Orderer");
+  DenseMap<const InputSectionBase *, int> bpOrder = runBalancedPartitioning(
+      config->bpStartupFunctionSort ? config->irpgoProfilePath : "",
+      config->bpFunctionOrderForCompression,
+      config->bpDataOrderForCompression,
+      config->bpCompressionSortStartupFunctions,
+      config->bpVerboseSectionOrderer);
+  if (sectionOrder.empty())
+    return bpOrder;
+
+  int explicitEnd = INT_MIN, bpBegin = 0;
+  for (auto &[sec, priority] : sectionOrder)
+    explicitEnd = std::max(explicitEnd, priority + 1);
+  for (auto &[sec, priority] : bpOrder)
+    bpBegin = std::min(bpBegin, priority);
+  for (auto &[sec, priority] : bpOrder)
+    sectionOrder.try_emplace(sec, explicitEnd + (priority - bpBegin));
+  return sectionOrder;
+}
+
 // Sorts the sections in ISD according to the provided section order.
 static void
 sortISDBySectionOrder(InputSectionDescription *isd,
@@ -2797,19 +2830,35 @@ template <class ELFT> void Writer<ELFT>::writeTrapInstr() {
 template <class ELFT> void Writer<ELFT>::writeSections() {
   llvm::TimeTraceScope timeScope("Write sections");
 
-  {
-    // In -r or --emit-relocs mode, write the relocation sections first as in
-    // ELf_Rel targets we might find out that we need to modify the relocated
-    // section while doing it.
+  // In -r or --emit-relocs mode, write the relocation sections first as in
+  // ELf_Rel targets we might find out that we need to modify the relocated
+  // section while doing it. SHT_RELA sections don't affect other sections, so
+  // if there is no SHT_REL section, everything is written by a single task
+  // group rather than waiting for the slowest relocation section.
+  bool hasRel = llvm::any_of(outputSections, [](OutputSection *sec) {
+    return sec->type == SHT_REL;
+  });
+  if (hasRel) {
     parallel::TaskGroup tg;
     for (OutputSection *sec : outputSections)
       if (isStaticRelSecType(sec->type))
         sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
+  } else {
+    // copyRelocations decompresses the relocated section, which is written
+    // concurrently by another task. Decompress those sections up front.
+    SmallVector<InputSection *, 0> storage;
+    for (OutputSection *sec : outputSections) {
+      if (!isStaticRelSecType(sec->type))
+        continue;
+      for (InputSection *isec : getInputSections(*sec, storage))
+        if (InputSectionBase *relocated = isec->getRelocatedSection())
+          (void)relocated->contentMaybeDecompress();
+    }
   }
   {
     parallel::TaskGroup tg;
     for (OutputSection *sec : outputSections)
-      if (!isStaticRelSecType(sec->type))
+      if (!hasRel || !isStaticRelSecType(sec->type))
         sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
   }
 
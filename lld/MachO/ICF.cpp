@@ -412,6 +412,8 @@ void macho::foldIdenticalSections(bool onlyCfStrings) {
   // someone keep the numbers straight in case we ever need to debug the
   // ICF::segregate()
   std::vector<ConcatInputSection *> foldable;
+  std::vector<ConcatInputSection *> addendsRemoved;
+  size_t addendsRemovedSize = 0;
   uint64_t icfUniqueID = inputSections.size();
   for (ConcatInputSection *isec : inputSections) {
     bool isFoldableWithAddendsRemoved = isCfStringSection(isec) ||
@@ -433,19 +435,9 @@ void macho::foldIdenticalSections(bool onlyCfStrings) {
         if (d->unwindEntry())
           foldable.push_back(d->unwindEntry());
 
-      // Some sections have embedded addends that foil ICF's hashing / equality
-      // checks. (We can ignore embedded addends when doing ICF because the same
-      // information gets recorded in our Reloc structs.) We therefore create a
-      // mutable copy of the section data and zero out the embedded addends
-      // before performing any hashing / equality checks.
       if (isFoldableWithAddendsRemoved) {
-        // We have to do this copying serially as the BumpPtrAllocator is not
-        // thread-safe. FIXME: Make a thread-safe allocator.
-        MutableArrayRef<uint8_t> copy = isec->data.copy(bAlloc());
-        for (const Reloc &r : isec->relocs)
-          target->relocateOne(copy.data() + r.offset, r, /*va=*/0,
-                              /*relocVA=*/0);
-        isec->data = copy;
+        addendsRemoved.push_back(isec);
+        addendsRemovedSize += isec->data.size();
       }
     } else if (!isEhFrameSection(isec)) {
       // EH frames are gathered as foldables from unwindEntry above; give a
@@ -453,6 +445,32 @@ void macho::foldIdenticalSections(bool onlyCfStrings) {
       isec->icfEqClass[0] = ++icfUniqueID;
     }
   }
+
+  // Some sections have embedded addends that foil ICF's hashing / equality
+  // checks. (We can ignore embedded addends when doing ICF because the same
+  // information gets recorded in our Reloc structs.) We therefore create a
+  // mutable copy of the section data and zero out the embedded addends
+  // before performing any hashing / equality checks. The BumpPtrAllocator is
+  // not thread-safe, so allocate one buffer for all of the copies up front and
+  // fill it in parallel.
+  if (!addendsRemoved.empty()) {
+    uint8_t *buf = bAlloc().Allocate<uint8_t>(addendsRemovedSize);
+    std::vector<uint8_t *> copies;
+    copies.reserve(addendsRemoved.size());
+    for (ConcatInputSection *isec : addendsRemoved) {
+      copies.push_back(buf);
+      buf += isec->data.size();
+    }
+    parallelFor(0, addendsRemoved.size(), [&](size_t i) {
+      ConcatInputSection *isec = addendsRemoved[i];
+      uint8_t *copy = copies[i];
+      memcpy(copy, isec->data.data(), isec->data.size());
+      for (const Reloc &r : isec->relocs)
+        target->relocateOne(copy + r.offset, r, /*va=*/0, /*relocVA=*/0);
+      isec->data = {copy, isec->data.size()};
+    });
+  }
+
   parallelForEach(foldable, [](ConcatInputSection *isec) {
     assert(isec->icfEqClass[0] == 0); // don't overwrite a unique ID!
     // Turn-on the top bit to guarantee that valid hashes have no collisions
@@ -0,0 +1,83 @@
+//===- LinkProfile.h --------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// --link-profile= attributes the time spent in individual linker phases to the
+// input files and output sections that caused it, so that users can tell which
+// libraries make their links slow. Unlike --time-trace, which records a
+// timeline, records with the same phase and name are summed up.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLD_COMMON_LINKPROFILE_H
+#define LLD_COMMON_LINKPROFILE_H
+
+#include "llvm/ADT/STLFunctionalExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include <chrono>
+#include <mutex>
+#include <string>
+
+namespace llvm {
+class raw_ostream;
+} // namespace llvm
+
+namespace lld {
+
+class LinkProfile {
+public:
+  // Adds time and bytes to the record for name in phase. This is thread-safe.
+  void add(llvm::StringRef phase, llvm::StringRef name,
+           std::chrono::nanoseconds time, uint64_t bytes);
+
+  // Writes all records as CSV, most expensive first.
+  void write(llvm::raw_ostream &os) const;
+
+private:
+  struct Record {
+    std::chrono::nanoseconds time{0};
+    uint64_t bytes = 0;
+    uint64_t count = 0;
+  };
+
+  mutable std::mutex mu;
+  // Keyed by phase and name, separated by '\0'.
+  llvm::StringMap<Record> records;
+};
+
+// Adds the time elapsed between construction and destruction to a profile.
+// Does nothing if the profile is null, in which case getName is not called,
+// so that the scope is cheap enough for hot loops.
+class LinkProfileScope {
+public:
+  LinkProfileScope(LinkProfile *profile, llvm::StringRef phase,
+                   llvm::function_ref<std::string()> getName,
+                   uint64_t bytes = 0)
+      : profile(profile), phase(phase), bytes(bytes) {
+    if (!profile)
+      return;
+    name = getName();
+    startTime = std::chrono::steady_clock::now();
+  }
+
+  ~LinkProfileScope() {
+    if (profile)
+      profile->add(phase, name, std::chrono::steady_clock::now() - startTime,
+                   bytes);
+  }
+
+private:
+  LinkProfile *profile;
+  llvm::StringRef phase;
+  std::string name;
+  uint64_t bytes;
+  std::chrono::steady_clock::time_point startTime;
+};
+
+} // namespace lld
+
+#endif
@@ -0,0 +1,31 @@
+# REQUIRES: x86
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+
+# RUN: not ld.lld --bp-startup-sort=foo %t.o -o /dev/null 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=STARTUP
+# STARTUP: error: unknown --bp-startup-sort= value: foo
+
+# RUN: not ld.lld --bp-compression-sort=foo %t.o -o /dev/null 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=COMPRESSION
+# COMPRESSION: error: unknown --bp-compression-sort= value: foo
+
+# RUN: not ld.lld --bp-startup-sort=function %t.o -o /dev/null 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=NO-PROFILE
+# NO-PROFILE: error: --bp-startup-sort=function must be used with --irpgo-profile
+
+# RUN: not ld.lld --bp-compression-sort-startup-functions %t.o -o /dev/null 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=STARTUP-COMPRESSION
+# STARTUP-COMPRESSION: error: --bp-compression-sort-startup-functions must be used with --bp-startup-sort=function
+
+# RUN: not ld.lld --irpgo-profile=%t.nonexistent --bp-startup-sort=function \
+# RUN:   %t.o -o /dev/null 2>&1 | FileCheck %s --check-prefix=MISSING -DMSG=%errc_ENOENT
+# MISSING: error: cannot open {{.*}}.nonexistent: [[MSG]]
+
+## An object file is not an indexed profile.
+# RUN: not ld.lld --irpgo-profile=%t.o --bp-startup-sort=function \
+# RUN:   %t.o -o /dev/null 2>&1 | FileCheck %s --check-prefix=INVALID
+# INVALID: error: {{.*}}.o: {{.+}}
+
+.globl _start
+_start:
+  ret
@@ -0,0 +1,61 @@
+# REQUIRES: x86
+## Sections ordered by --symbol-ordering-file or --call-graph-ordering-file
+## come first; balanced partitioning orders the remaining sections after them.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+
+# RUN: ld.lld --bp-compression-sort=function --verbose-bp-section-orderer \
+# RUN:   --symbol-ordering-file=order.txt a.o -o sym.out | FileCheck %s --check-prefix=VERBOSE
+# RUN: llvm-nm -n -j --defined-only sym.out | FileCheck %s --check-prefix=ORDER
+
+# RUN: ld.lld --bp-compression-sort=function --call-graph-ordering-file=cg.txt \
+# RUN:   a.o -o cg.out
+# RUN: llvm-nm -n -j --defined-only cg.out | FileCheck %s --check-prefix=ORDER
+
+# VERBOSE: Functions for compression:
+
+## F4 and F3 are placed first, in the requested order. The other functions
+## follow in the order chosen by balanced partitioning.
+# ORDER-NOT: {{.}}
+# ORDER:      F4
+# ORDER-NEXT: F3
+# ORDER-DAG:  F1
+# ORDER-DAG:  F2
+# ORDER-DAG:  _start
+
+#--- order.txt
+F4
+F3
+
+#--- cg.txt
+F4 F3 100
+
+#--- a.s
+.globl _start, F1, F2, F3, F4
+.text
+_start:
+  call F1
+  ret
+
+.section .text.F1,"ax",@progbits
+F1:
+  add $1, %eax
+  ret
+
+.section .text.F2,"ax",@progbits
+F2:
+  add $2, %eax
+  add $2, %ecx
+  ret
+
+.section .text.F3,"ax",@progbits
+F3:
+  sub $3, %eax
+  call F4
+  ret
+
+.section .text.F4,"ax",@progbits
+F4:
+  imul $4, %eax
+  ret
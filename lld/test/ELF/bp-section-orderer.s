@@ -0,0 +1,166 @@
+# REQUIRES: x86
+## Balanced partitioning orders sections for startup from the temporal
+## profile in --irpgo-profile=, and functions and data for compression.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+# RUN: llvm-profdata merge a.proftext -o a.profdata
+
+## The functions executed during startup come first.
+# RUN: ld.lld --irpgo-profile=a.profdata --bp-startup-sort=function \
+# RUN:   --verbose-bp-section-orderer a.o -o startup.out | FileCheck %s --check-prefix=STARTUP-INFO
+# RUN: llvm-nm -n -j --defined-only startup.out | FileCheck %s --check-prefix=STARTUP
+# STARTUP-INFO:      Functions for startup: 2
+# STARTUP-INFO-NEXT: Functions for compression: 0
+# STARTUP-INFO-NEXT: Data for compression: 0
+
+# STARTUP-NOT: {{.}}
+# STARTUP-DAG: F4
+# STARTUP-DAG: F1
+# STARTUP:     _start
+# STARTUP:     F2
+# STARTUP:     F3
+
+# RUN: ld.lld --irpgo-profile=a.profdata --bp-startup-sort=function \
+# RUN:   --bp-compression-sort-startup-functions --verbose-bp-section-orderer \
+# RUN:   a.o -o startup-compr.out | FileCheck %s --check-prefix=STARTUP-INFO
+
+## .init, .fini, .init_array, .fini_array, .ctors and .dtors sections are not
+## reordered: unprioritized initializers from different translation units
+## must run in input order. These inputs are too small for any hash to be
+## frequent, so all candidates of a kind are duplicates of the first one.
+# RUN: ld.lld --bp-compression-sort=both --verbose-bp-section-orderer a.o \
+# RUN:   -o both.out | FileCheck %s --check-prefix=BOTH-INFO
+# BOTH-INFO:      Functions for startup: 0
+# BOTH-INFO-NEXT: Functions for compression: 1
+# BOTH-INFO-NEXT: Data for compression: 1
+# BOTH-INFO-NEXT: Duplicate sections: 7
+
+# RUN: ld.lld --bp-compression-sort=data --verbose-bp-section-orderer a.o \
+# RUN:   -o data.out | FileCheck %s --check-prefix=DATA-INFO
+# RUN: llvm-nm -n -j --defined-only data.out | FileCheck %s --check-prefix=INIT
+# RUN: llvm-nm -n -j --defined-only data.out | FileCheck %s --check-prefix=CTORS
+# DATA-INFO:      Functions for compression: 0
+# DATA-INFO-NEXT: Data for compression: 1
+# DATA-INFO-NEXT: Duplicate sections: 3
+
+# INIT:      init1
+# INIT-NEXT: init2
+# INIT-NEXT: init3
+# CTORS:      ctor1
+# CTORS-NEXT: ctor2
+
+## The same holds under a SECTIONS command, where no priority sort follows.
+# RUN: echo 'SECTIONS { .init_array : { *(.init_array) } .ctors : { *(.ctors) } \
+# RUN:   .text : { *(.text*) } .data : { *(.data*) } }' > a.lds
+# RUN: ld.lld --bp-compression-sort=data -T a.lds a.o -o script.out
+# RUN: llvm-nm -n -j --defined-only script.out | FileCheck %s --check-prefix=INIT
+# RUN: llvm-nm -n -j --defined-only script.out | FileCheck %s --check-prefix=CTORS
+
+## All data sections are reordered for compression, but none is lost.
+# RUN: llvm-nm -n -j --defined-only data.out | FileCheck %s --check-prefix=DATA
+# DATA-DAG: d1
+# DATA-DAG: d2
+# DATA-DAG: d3
+# DATA-DAG: d4
+
+#--- a.proftext
+:ir
+:temporal_prof_traces
+# Num Traces
+1
+# Trace Stream Size:
+1
+# Weight
+1
+F4, F1
+
+F1
+# Func Hash:
+1111
+# Num Counters:
+1
+# Counter Values:
+1
+
+F4
+# Func Hash:
+4444
+# Num Counters:
+1
+# Counter Values:
+1
+
+#--- a.s
+.globl _start, F1, F2, F3, F4
+.text
+_start:
+  call F1
+  ret
+
+.section .text.F1,"ax",@progbits
+F1:
+  add $1, %eax
+  ret
+
+.section .text.F2,"ax",@progbits
+F2:
+  add $2, %eax
+  add $2, %ecx
+  ret
+
+.section .text.F3,"ax",@progbits
+F3:
+  sub $3, %eax
+  call F4
+  ret
+
+.section .text.F4,"ax",@progbits
+F4:
+  imul $4, %eax
+  ret
+
+.section .init,"ax",@progbits
+init:
+  ret
+
+.section .fini,"ax",@progbits
+fini:
+  ret
+
+.section .init_array,"aw",@init_array,unique,1
+init1:
+  .quad F3
+.section .init_array,"aw",@init_array,unique,2
+init2:
+  .quad F1
+.section .init_array,"aw",@init_array,unique,3
+init3:
+  .quad F3
+
+.section .fini_array,"aw",@fini_array,unique,1
+fini1:
+  .quad F2
+
+.section .ctors,"aw",@progbits,unique,1
+ctor1:
+  .quad F1
+.section .ctors,"aw",@progbits,unique,2
+ctor2:
+  .quad F3
+
+.section .data.d1,"aw",@progbits
+d1:
+  .quad 0x1111111111111111
+  .quad 0x2222222222222222
+.section .data.d2,"aw",@progbits
+d2:
+  .quad 0x3333333333333333
+.section .data.d3,"aw",@progbits
+d3:
+  .quad 0x1111111111111111
+  .quad 0x2222222222222222
+.section .data.d4,"aw",@progbits
+d4:
+  .quad 0x3333333333333333
+  .quad 0x4444444444444444
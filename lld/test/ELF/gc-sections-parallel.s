@@ -0,0 +1,67 @@
+# REQUIRES: x86
+## --gc-sections marks a worklist of 1024 or more sections in parallel. The
+## result must be the same as that of the serial marker.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: %python gen.py
+# RUN: llvm-mc -filetype=obj -triple=x86_64 funcs.s -o funcs.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 start.s -o start.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 shared.s -o shared.o
+# RUN: ld.lld -shared -soname=shared.so shared.o -o shared.so
+
+# RUN: ld.lld --gc-sections --print-gc-sections --as-needed --threads=4 \
+# RUN:   start.o funcs.o shared.so -o parallel > parallel.txt
+# RUN: ld.lld --gc-sections --print-gc-sections --as-needed --threads=1 \
+# RUN:   start.o funcs.o shared.so -o serial > serial.txt
+# RUN: cmp parallel serial
+# RUN: cmp parallel.txt serial.txt
+
+## Only the dead functions are removed.
+# RUN: grep -c 'removing unused section' parallel.txt | FileCheck %s --check-prefix=COUNT
+# RUN: FileCheck %s --check-prefix=GC < parallel.txt
+# COUNT: 1100
+# GC:     removing unused section funcs.o:(.text.dead0)
+# GC-NOT: .text.f
+# GC-NOT: .text.g
+
+# RUN: llvm-nm -j --defined-only parallel | FileCheck %s --check-prefix=SYMS
+# SYMS-DAG: f0
+# SYMS-DAG: f1099
+# SYMS-DAG: g0
+# SYMS-DAG: g1099
+
+## f500 references shared.so and f700 references __start_keep. Both are
+## only found by the parallel marker.
+# RUN: llvm-readelf -d parallel | FileCheck %s --check-prefix=NEEDED
+# NEEDED: (NEEDED) Shared library: [shared.so]
+# RUN: llvm-readelf -S parallel | FileCheck %s --check-prefix=KEEP
+# KEEP: {{ }}keep{{ +}}PROGBITS
+
+#--- gen.py
+## _start calls 1100 functions, which queues all of them at once. Each of
+## them calls a helper, which queues another 1100 sections. Every dead
+## function calls a helper too, but nothing reaches it.
+n = 1100
+with open("start.s", "w") as f:
+    print(".globl _start\n_start:", file=f)
+    for i in range(n):
+        print(f"  call f{i}", file=f)
+with open("funcs.s", "w") as f:
+    for i in range(n):
+        print(f'.section .text.f{i},"ax",@progbits\n.globl f{i}\nf{i}:', file=f)
+        print(f"  call g{i}", file=f)
+        if i == 500:
+            print("  call shared", file=f)
+        if i == 700:
+            print("  movq $__start_keep, %rax", file=f)
+        print("  ret", file=f)
+        print(f'.section .text.g{i},"ax",@progbits\ng{i}:\n  ret', file=f)
+        print(f'.section .text.dead{i},"ax",@progbits\ndead{i}:', file=f)
+        print(f"  call g{i}\n  ret", file=f)
+    print('.section keep,"a",@progbits\n.quad 0', file=f)
+
+#--- shared.s
+.globl shared
+.type shared,@function
+shared:
+  ret
@@ -0,0 +1,87 @@
+# REQUIRES: x86
+## --incremental= skips a link that would reproduce the output of the previous
+## one, unless the link writes side files or reports something.
+
+# RUN: rm -rf %t && mkdir %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o a.o
+
+# RUN: ld.lld --incremental=state --verbose a.o -o a 2>&1 | FileCheck %s --check-prefix=LINK
+# RUN: ld.lld --incremental=state --verbose a.o -o a 2>&1 | FileCheck %s --check-prefix=REUSE
+# LINK-NOT: is up to date
+# REUSE: --incremental: a is up to date
+
+## Changing an input relinks.
+# RUN: cp a.o orig.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 --defsym=CHANGED=1 %s -o a.o
+# RUN: ld.lld --incremental=state --verbose a.o -o a 2>&1 | FileCheck %s --check-prefix=LINK
+# RUN: cp orig.o a.o
+
+## So does changing a file that is read after the inputs.
+# RUN: echo '_start _start 1' > cg.txt
+# RUN: ld.lld --incremental=state --verbose --call-graph-ordering-file=cg.txt a.o -o cg 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=LINK
+# RUN: ld.lld --incremental=state --verbose --call-graph-ordering-file=cg.txt a.o -o cg 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=REUSE
+# RUN: echo '_start _start 2' > cg.txt
+# RUN: ld.lld --incremental=state --verbose --call-graph-ordering-file=cg.txt a.o -o cg 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=LINK
+
+## Links that report something on stdout are redone every time.
+# RUN: ld.lld --incremental=state --gc-sections --print-gc-sections a.o -o gc | FileCheck %s --check-prefix=GC
+# RUN: ld.lld --incremental=state --gc-sections --print-gc-sections a.o -o gc | FileCheck %s --check-prefix=GC
+# GC: removing unused section a.o:(.text.unused)
+
+# RUN: ld.lld --incremental=state --trace a.o -o trace | FileCheck %s --check-prefix=TRACE
+# RUN: ld.lld --incremental=state --trace a.o -o trace | FileCheck %s --check-prefix=TRACE
+# TRACE: a.o
+
+# RUN: ld.lld --incremental=state --trace-symbol=_start a.o -o sym | FileCheck %s --check-prefix=SYM
+# RUN: ld.lld --incremental=state --trace-symbol=_start a.o -o sym | FileCheck %s --check-prefix=SYM
+# SYM: a.o: definition of _start
+
+# RUN: ld.lld --incremental=state --print-memory-usage a.o -o mem | FileCheck %s --check-prefix=MEM
+# RUN: ld.lld --incremental=state --print-memory-usage a.o -o mem | FileCheck %s --check-prefix=MEM
+# MEM: Memory region
+
+## So are links that write side files.
+# RUN: ld.lld --incremental=state -Map=a.map a.o -o map
+# RUN: rm a.map
+# RUN: ld.lld --incremental=state -Map=a.map a.o -o map
+# RUN: FileCheck %s --check-prefix=MAP < a.map
+# MAP: _start
+
+# RUN: ld.lld --incremental=state --time-trace a.o -o tt
+# RUN: rm tt.time-trace
+# RUN: ld.lld --incremental=state --time-trace a.o -o tt
+# RUN: ls tt.time-trace
+
+# RUN: ld.lld --incremental=state --link-profile=a.csv a.o -o prof
+# RUN: rm a.csv
+# RUN: ld.lld --incremental=state --link-profile=a.csv a.o -o prof
+# RUN: FileCheck %s --check-prefix=PROFILE < a.csv
+# PROFILE: {{^}}parse,a.o,
+
+# RUN: ld.lld --incremental=state --reproduce=repro.tar a.o -o repro
+# RUN: rm repro.tar
+# RUN: ld.lld --incremental=state --reproduce=repro.tar a.o -o repro
+# RUN: ls repro.tar
+
+## Warnings are reported again, since a link that warns is not recorded.
+# RUN: echo 'call undef' | llvm-mc -filetype=obj -triple=x86_64 - -o undef.o
+# RUN: ld.lld --incremental=state --warn-unresolved-symbols a.o undef.o -o warn 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=WARN
+# RUN: ld.lld --incremental=state --warn-unresolved-symbols --verbose a.o undef.o -o warn 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=WARN
+# WARN: warning: undefined symbol: undef
+# WARN-NOT: is up to date
+
+.globl _start
+_start:
+  ret
+
+.ifdef CHANGED
+  nop
+.endif
+
+.section .text.unused,"ax",@progbits
+  ret
@@ -0,0 +1,44 @@
+# REQUIRES: x86
+## --link-profile= writes a CSV attributing parse and relocation scanning time
+## to each input file, and write time to each output section.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 b.s -o b.o
+# RUN: ld.lld --link-profile=profile.csv a.o b.o -o out
+# RUN: FileCheck %s --input-file=profile.csv
+
+## The header comes first; records are sorted by time, so their order varies.
+# CHECK:     {{^}}phase,name,milliseconds,bytes,count{{$}}
+# CHECK-DAG: {{^}}parse,a.o,[[#]].[[#]],[[#]],1{{$}}
+# CHECK-DAG: {{^}}parse,b.o,[[#]].[[#]],[[#]],1{{$}}
+# CHECK-DAG: {{^}}scan relocations,a.o,[[#]].[[#]],0,[[#]]{{$}}
+# CHECK-DAG: {{^}}scan relocations,b.o,[[#]].[[#]],0,[[#]]{{$}}
+# CHECK-DAG: {{^}}write,.text,[[#]].[[#]],[[#]],[[#]]{{$}}
+# CHECK-DAG: {{^}}write,.data,[[#]].[[#]],8,[[#]]{{$}}
+
+## Names containing a comma are quoted.
+# RUN: cp a.o 'c,d.o'
+# RUN: ld.lld --link-profile=quoted.csv 'c,d.o' b.o -o out
+# RUN: FileCheck %s --check-prefix=QUOTED --input-file=quoted.csv
+# QUOTED: {{^}}parse,"c,d.o",
+
+## An unwritable path is an error.
+# RUN: not ld.lld --link-profile=%t/nonexistent/profile.csv a.o b.o -o out 2>&1 | \
+# RUN:   FileCheck %s --check-prefix=ERR -DMSG=%errc_ENOENT
+# ERR: error: cannot open {{.*}}profile.csv: [[MSG]]
+
+#--- a.s
+.globl _start
+_start:
+  call f
+  movq data(%rip), %rax
+
+.data
+data:
+  .quad 0
+
+#--- b.s
+.globl f
+f:
+  ret
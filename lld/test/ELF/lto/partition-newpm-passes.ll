@@ -0,0 +1,42 @@
+; REQUIRES: x86
+;; --lto-partition-newpm-passes= runs a pipeline over each --lto-partitions=
+;; partition before its code generation, after --lto-newpm-passes= has run
+;; over the whole module.
+
+; RUN: opt %s -o %t.o
+; RUN: ld.lld %t.o -o %t.so -shared --lto-partitions=2 --lto-debug-pass-manager \
+; RUN:   --lto-newpm-passes=globaldce --lto-partition-newpm-passes='function(instcombine)' \
+; RUN:   2>&1 | FileCheck %s
+; RUN: llvm-nm %t.so | FileCheck %s --check-prefix=SYMS
+
+; CHECK:     Running pass: GlobalDCEPass
+; CHECK-NOT: Running pass: InstCombinePass
+; CHECK-DAG: Running pass: InstCombinePass on f
+; CHECK-DAG: Running pass: InstCombinePass on g
+
+; SYMS-DAG: T f
+; SYMS-DAG: T g
+
+;; Without partitions to run it on, the pipeline is not used.
+; RUN: ld.lld %t.o -o %t.so -shared --lto-debug-pass-manager \
+; RUN:   --lto-newpm-passes=globaldce --lto-partition-newpm-passes='function(instcombine)' \
+; RUN:   2>&1 | FileCheck %s --check-prefix=SINGLE
+; SINGLE: Running pass: GlobalDCEPass
+; SINGLE-NOT: InstCombinePass
+
+; RUN: not --crash ld.lld %t.o -o %t.so -shared --lto-partitions=2 \
+; RUN:   --lto-partition-newpm-passes=iamnotapass 2>&1 | FileCheck %s --check-prefix=INVALID
+; INVALID: unable to parse pass pipeline description 'iamnotapass': unknown pass name 'iamnotapass'
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @f(i32 %x) {
+  %a = add i32 %x, 0
+  ret i32 %a
+}
+
+define i32 @g(i32 %x) {
+  %m = mul i32 %x, 1
+  ret i32 %m
+}
@@ -0,0 +1,50 @@
+; REQUIRES: x86
+;; --thinlto-memory-budget= limits the estimated memory of the ThinLTO backends
+;; that run at once. A backend is always started when no other one is running,
+;; so a budget smaller than any estimate still finishes the link.
+
+; RUN: rm -rf %t && split-file %s %t && cd %t
+; RUN: opt -module-summary a.ll -o a.o
+; RUN: opt -module-summary b.ll -o b.o
+
+; RUN: ld.lld --thinlto-memory-budget=1 --thinlto-jobs=2 a.o b.o -o out
+; RUN: llvm-nm out | FileCheck %s
+; RUN: ld.lld --thinlto-memory-budget=0 --thinlto-jobs=2 a.o b.o -o out
+; RUN: llvm-nm out | FileCheck %s
+
+; CHECK: T _start
+
+; RUN: not ld.lld --thinlto-memory-budget=-1 a.o b.o -o /dev/null 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=NEGATIVE
+; NEGATIVE: error: --thinlto-memory-budget: budget must be >= 0
+
+; RUN: not ld.lld --thinlto-memory-budget=foo a.o b.o -o /dev/null 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=INVALID
+; INVALID: error: --thinlto-memory-budget=foo: number expected, but got 'foo'
+
+;; A one-byte budget in llvm-lto2 runs the backends one at a time.
+; RUN: llvm-lto2 run a.o b.o -o lto2 -thinlto-threads=2 -thinlto-memory-budget=1 \
+; RUN:   -r=a.o,_start,px -r=a.o,f, -r=b.o,f,px
+; RUN: llvm-nm lto2.1 | FileCheck %s --check-prefix=LTO2-A
+; RUN: llvm-nm lto2.2 | FileCheck %s --check-prefix=LTO2-B
+; LTO2-A: T _start
+; LTO2-B: T f
+
+;--- a.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @f()
+
+define void @_start() {
+  call void @f()
+  ret void
+}
+
+;--- b.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define void @f() {
+  ret void
+}
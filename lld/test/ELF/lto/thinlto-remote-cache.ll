@@ -0,0 +1,118 @@
+; REQUIRES: x86, curl
+;; --thinlto-remote-cache= looks ThinLTO backend objects up on an HTTP server
+;; after missing the --thinlto-cache-dir= directory, writes hits through to the
+;; directory and uploads the objects it had to compute.
+
+; RUN: rm -rf %t && split-file %s %t && cd %t
+; RUN: opt -module-hash -module-summary a.ll -o a.o
+; RUN: opt -module-hash -module-summary b.ll -o b.o
+; RUN: mkdir store
+
+;; Missing everywhere computes both objects and uploads them.
+; RUN: %python server.py store miss.log ld.lld --thinlto-cache-dir=cache1 \
+; RUN:   --thinlto-remote-cache=@URL@ a.o b.o -o out1
+; RUN: ls store | count 2
+; RUN: ls cache1 | grep llvmcache- | count 2
+; RUN: sort miss.log | FileCheck %s --check-prefix=MISS
+; MISS:      GET 404
+; MISS-NEXT: GET 404
+; MISS-NEXT: PUT 201
+; MISS-NEXT: PUT 201
+; MISS-NOT:  {{.}}
+
+;; Another machine, with an empty cache directory, fetches both objects and
+;; writes them through.
+; RUN: %python server.py store hit.log ld.lld --thinlto-cache-dir=cache2 \
+; RUN:   --thinlto-remote-cache=@URL@ a.o b.o -o out2
+; RUN: cmp out1 out2
+; RUN: ls cache2 | grep llvmcache- | count 2
+; RUN: sort hit.log | FileCheck %s --check-prefix=HIT
+; HIT:      GET 200
+; HIT-NEXT: GET 200
+; HIT-NOT:  {{.}}
+
+;; Local hits don't reach the server.
+; RUN: touch local.log
+; RUN: %python server.py store local.log ld.lld --thinlto-cache-dir=cache2 \
+; RUN:   --thinlto-remote-cache=@URL@ a.o b.o -o out3
+; RUN: cmp out1 out3
+; RUN: count 0 < local.log
+
+;; A server that cannot be reached is a miss. The link succeeds and warns
+;; that the objects could not be uploaded.
+; RUN: ld.lld --thinlto-cache-dir=cache3 --thinlto-remote-cache=http://localhost:1 \
+; RUN:   a.o b.o -o out4 2>&1 | FileCheck %s --check-prefix=UNREACHABLE
+; RUN: cmp out1 out4
+; UNREACHABLE: warning: --thinlto-remote-cache: failed to upload http://localhost:1/
+
+; RUN: not ld.lld --thinlto-remote-cache=http://localhost:1 a.o b.o -o /dev/null 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=NO-DIR
+; NO-DIR: error: --thinlto-remote-cache= requires --thinlto-cache-dir=
+
+;--- server.py
+## Serves the directory argv[1] as a remote cache while running the command
+## in argv[3:], with @URL@ replaced by the server's URL. Every request is
+## logged to argv[2] as "<method> <status>".
+import http.server
+import os
+import subprocess
+import sys
+import threading
+
+store, log = sys.argv[1], sys.argv[2]
+lock = threading.Lock()
+
+
+class Handler(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+
+    def log_message(self, *args):
+        pass
+
+    def reply(self, code, body=b""):
+        with lock, open(log, "a") as f:
+            print(self.command, code, file=f)
+        self.send_response(code)
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def do_GET(self):
+        path = os.path.join(store, os.path.basename(self.path))
+        if not os.path.exists(path):
+            return self.reply(404)
+        with open(path, "rb") as f:
+            self.reply(200, f.read())
+
+    def do_PUT(self):
+        body = self.rfile.read(int(self.headers["Content-Length"]))
+        with open(os.path.join(store, os.path.basename(self.path)), "wb") as f:
+            f.write(body)
+        self.reply(201)
+
+
+server = http.server.ThreadingHTTPServer(("localhost", 0), Handler)
+threading.Thread(target=server.serve_forever, daemon=True).start()
+url = "http://localhost:%d" % server.server_address[1]
+ret = subprocess.call([arg.replace("@URL@", url) for arg in sys.argv[3:]])
+server.shutdown()
+sys.exit(ret)
+
+;--- a.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @f()
+
+define void @_start() {
+  call void @f()
+  ret void
+}
+
+;--- b.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define void @f() {
+  ret void
+}
@@ -0,0 +1,29 @@
+# REQUIRES: x86, zlib
+## With -r, a RELA section is written in the same task group as the other
+## sections, while copyRelocations needs the relocated section decompressed.
+## The compressed .debug_info must be decompressed before the sections are
+## written concurrently.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 --compress-debug-sections=zlib %s -o %t.o
+# RUN: llvm-readelf -S %t.o | FileCheck %s --check-prefix=INPUT
+# RUN: ld.lld -r --threads=4 %t.o %t.o -o %t.ro
+# RUN: llvm-readelf -S -r -x .debug_info %t.ro | FileCheck %s
+
+# INPUT: .debug_info PROGBITS {{.*}} C
+
+# CHECK:      .debug_info PROGBITS
+# CHECK:      .rela.debug_info RELA
+# CHECK:      Relocation section '.rela.debug_info' at offset {{.*}} contains 4 entries:
+# CHECK-COUNT-4: R_X86_64_64 {{.*}} .text
+# CHECK:      Hex dump of section '.debug_info':
+# CHECK-NEXT: 0x00000000 00000000 00000000 00000000 00000000
+# CHECK-NEXT: 0x00000010 00000000 00000000 00000000 00000000
+
+.text
+.globl foo
+foo:
+  ret
+
+.section .debug_info,"",@progbits
+  .quad .text
+  .quad .text + 1
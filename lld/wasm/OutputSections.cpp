@@ -53,10 +53,15 @@ void CodeSection::finalizeContents() {
   os.flush();
   bodySize = codeSectionHeader.size();
 
+  // With --compress-relocations, computing a function's size requires
+  // evaluating all of its relocations, so do that in parallel before
+  // assigning offsets.
+  parallelForEach(functions,
+                  [](InputFunction *func) { func->calculateSize(); });
+
   for (InputFunction *func : functions) {
     func->outputSec = this;
     func->outSecOff = bodySize;
-    func->calculateSize();
     // All functions should have a non-empty body at this point
     assert(func->getSize());
     bodySize += func->getSize();
@@ -79,9 +84,10 @@ void CodeSection::writeTo(uint8_t *buf) {
   // Write code section headers
   memcpy(buf, codeSectionHeader.data(), codeSectionHeader.size());
 
-  // Write code section bodies
-  for (const InputChunk *chunk : functions)
-    chunk->writeTo(buf);
+  // Write code section bodies. Function offsets were assigned in
+  // finalizeContents, so functions can be copied and relocated in parallel.
+  parallelForEach(functions,
+                  [buf](const InputChunk *chunk) { chunk->writeTo(buf); });
 }
 
 uint32_t CodeSection::getNumRelocations() const {
@@ -9,6 +9,7 @@
 #ifndef LLDB_BREAKPOINT_BREAKPOINTLOCATION_H
 #define LLDB_BREAKPOINT_BREAKPOINTLOCATION_H
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 
@@ -90,6 +91,13 @@ public:
   /// Resets the current Hit Count.
   void ResetHitCount() { m_hit_counter.Reset(); }
 
+  /// Return the number of times the condition had to be parsed.
+  uint32_t GetConditionParseCount() const { return m_condition_parse_count; }
+
+  /// Return the number of condition evaluations that reused the previously
+  /// parsed expression.
+  uint32_t GetConditionReuseCount() const { return m_condition_reuse_count; }
+
   /// Return the current Ignore Count.
   ///
   /// \return
@@ -366,6 +374,10 @@ private:
                                 /// multiple processes.
   size_t m_condition_hash; ///< For testing whether the condition source code
                            ///changed.
+  /// Number of condition parses and of reuses of a parsed condition. They are
+  /// read by statistics without holding m_condition_mutex.
+  std::atomic<uint32_t> m_condition_parse_count{0};
+  std::atomic<uint32_t> m_condition_reuse_count{0};
   lldb::break_id_t m_loc_id; ///< Breakpoint location ID.
   StoppointHitCounter m_hit_counter; ///< Number of times this breakpoint
                                      /// location has been hit.
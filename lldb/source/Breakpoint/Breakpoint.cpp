@@ -1113,6 +1113,18 @@ json::Value Breakpoint::GetStatistics() {
   bp.try_emplace("numLocations", (int64_t)GetNumLocations());
   bp.try_emplace("numResolvedLocations", (int64_t)GetNumResolvedLocations());
   bp.try_emplace("hitCount", (int64_t)GetHitCount());
+  // Conditions are parsed once per location and reused while they and the
+  // context they were parsed in stay the same.
+  int64_t condition_parses = 0, condition_reuses = 0;
+  for (size_t i = 0, e = GetNumLocations(); i != e; ++i) {
+    BreakpointLocationSP loc_sp = GetLocationAtIndex(i);
+    condition_parses += loc_sp->GetConditionParseCount();
+    condition_reuses += loc_sp->GetConditionReuseCount();
+  }
+  if (condition_parses || condition_reuses) {
+    bp.try_emplace("conditionParseCount", condition_parses);
+    bp.try_emplace("conditionReuseCount", condition_reuses);
+  }
   bp.try_emplace("internal", IsInternal());
   if (!m_kind_description.empty())
     bp.try_emplace("kindDescription", m_kind_description);
@@ -272,6 +272,9 @@ bool BreakpointLocation::ConditionSaysStop(ExecutionContext &exe_ctx,
     }
 
     m_condition_hash = condition_hash;
+    ++m_condition_parse_count;
+  } else {
+    ++m_condition_reuse_count;
   }
 
   // We need to make sure the user sees any parse errors in their condition, so
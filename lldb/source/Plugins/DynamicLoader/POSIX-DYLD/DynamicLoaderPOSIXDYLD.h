@@ -17,6 +17,7 @@
 #include "lldb/Breakpoint/StoppointCallbackContext.h"
 #include "lldb/Core/ModuleList.h"
 #include "lldb/Target/DynamicLoader.h"
+#include "llvm/Support/RWMutex.h"
 
 class AuxVector;
 
@@ -90,6 +91,9 @@ protected:
   /// Loaded module list. (link map for each module)
   std::map<lldb::ModuleWP, lldb::addr_t, std::owner_less<lldb::ModuleWP>>
       m_loaded_modules;
+  /// Guards m_loaded_modules, which is updated from several threads when
+  /// modules are loaded in parallel. Every access must hold it.
+  llvm::sys::RWMutex m_loaded_modules_mutex;
 
   /// Returns true if the process is for a core file.
   bool IsCoreFile() const;
@@ -0,0 +1,142 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/APInt.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+static void BM_SmallVectorPushBack(benchmark::State &State) {
+  unsigned N = State.range(0);
+  for (auto _ : State) {
+    SmallVector<unsigned, 8> V;
+    for (unsigned I = 0; I != N; ++I)
+      V.push_back(I);
+    benchmark::DoNotOptimize(V.data());
+  }
+  State.SetItemsProcessed(State.iterations() * N);
+}
+BENCHMARK(BM_SmallVectorPushBack)->Arg(4)->Arg(64)->Arg(4096);
+
+static void BM_SmallVectorAppend(benchmark::State &State) {
+  std::vector<unsigned> Src(State.range(0), 1);
+  for (auto _ : State) {
+    SmallVector<unsigned, 8> V;
+    V.append(Src.begin(), Src.end());
+    benchmark::DoNotOptimize(V.data());
+  }
+  State.SetBytesProcessed(State.iterations() * Src.size() * sizeof(unsigned));
+}
+BENCHMARK(BM_SmallVectorAppend)->Arg(4)->Arg(64)->Arg(4096);
+
+static std::vector<void *> makePointers(size_t N) {
+  std::vector<void *> Ptrs;
+  Ptrs.reserve(N);
+  for (size_t I = 0; I != N; ++I)
+    Ptrs.push_back(reinterpret_cast<void *>(0x10000000 + I * 48));
+  std::shuffle(Ptrs.begin(), Ptrs.end(), std::mt19937_64(1));
+  return Ptrs;
+}
+
+static void BM_DenseMapInsert(benchmark::State &State) {
+  auto Keys = makePointers(State.range(0));
+  for (auto _ : State) {
+    DenseMap<void *, unsigned> M;
+    for (void *K : Keys)
+      M[K] = 0;
+    benchmark::DoNotOptimize(M.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+BENCHMARK(BM_DenseMapInsert)->Arg(16)->Arg(1024)->Arg(65536);
+
+static void BM_DenseMapFind(benchmark::State &State) {
+  auto Keys = makePointers(State.range(0));
+  DenseMap<void *, unsigned> M;
+  for (void *K : Keys)
+    M[K] = 0;
+  for (auto _ : State) {
+    unsigned Found = 0;
+    for (void *K : Keys)
+      Found += M.count(K);
+    benchmark::DoNotOptimize(Found);
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+BENCHMARK(BM_DenseMapFind)->Arg(16)->Arg(1024)->Arg(65536);
+
+static void BM_SmallPtrSetInsert(benchmark::State &State) {
+  auto Keys = makePointers(State.range(0));
+  for (auto _ : State) {
+    SmallPtrSet<void *, 16> S;
+    for (void *K : Keys)
+      S.insert(K);
+    benchmark::DoNotOptimize(S.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+BENCHMARK(BM_SmallPtrSetInsert)->Arg(8)->Arg(16)->Arg(1024)->Arg(65536);
+
+static std::vector<std::string> makeSymbolNames(size_t N) {
+  std::vector<std::string> Names;
+  Names.reserve(N);
+  for (size_t I = 0; I != N; ++I)
+    Names.push_back("_ZN4llvm" + std::to_string(I * 2654435761u) + "Ev");
+  return Names;
+}
+
+static void BM_StringMapInsert(benchmark::State &State) {
+  auto Names = makeSymbolNames(State.range(0));
+  for (auto _ : State) {
+    StringMap<unsigned> M;
+    for (const std::string &N : Names)
+      M[N] = 0;
+    benchmark::DoNotOptimize(M.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Names.size());
+}
+BENCHMARK(BM_StringMapInsert)->Arg(16)->Arg(1024)->Arg(65536);
+
+static void BM_StringMapFind(benchmark::State &State) {
+  auto Names = makeSymbolNames(State.range(0));
+  StringMap<unsigned> M;
+  for (const std::string &N : Names)
+    M[N] = 0;
+  for (auto _ : State) {
+    unsigned Found = 0;
+    for (const std::string &N : Names)
+      Found += M.count(N);
+    benchmark::DoNotOptimize(Found);
+  }
+  State.SetItemsProcessed(State.iterations() * Names.size());
+}
+BENCHMARK(BM_StringMapFind)->Arg(16)->Arg(1024)->Arg(65536);
+
+// APInt arithmetic for the inline (<= 64 bits) and heap-allocated cases.
+static void BM_APIntMulAdd(benchmark::State &State) {
+  unsigned BitWidth = State.range(0);
+  APInt A = APInt::getAllOnes(BitWidth).lshr(3);
+  APInt B(BitWidth, 0x123456789abcdefULL);
+  for (auto _ : State) {
+    APInt R = A * B + A;
+    benchmark::DoNotOptimize(R);
+  }
+}
+BENCHMARK(BM_APIntMulAdd)->Arg(32)->Arg(64)->Arg(128)->Arg(512);
+
+static void BM_APIntUDiv(benchmark::State &State) {
+  unsigned BitWidth = State.range(0);
+  APInt A = APInt::getAllOnes(BitWidth);
+  APInt B(BitWidth, 0x123456789ULL);
+  for (auto _ : State) {
+    APInt R = A.udiv(B);
+    benchmark::DoNotOptimize(R);
+  }
+}
+BENCHMARK(BM_APIntUDiv)->Arg(32)->Arg(64)->Arg(128)->Arg(512);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,117 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/FlatHashMap.h"
+#include "llvm/ADT/StringMap.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+// Pointer keys shaped like the ones ValueMap and the MC layer use: aligned and
+// clustered, so DenseMapInfo's hash sees little entropy in the low bits.
+static std::vector<void *> makePointerKeys(size_t N) {
+  std::vector<void *> Keys;
+  Keys.reserve(N);
+  uintptr_t Base = 0x10000000;
+  std::mt19937_64 Rng(1);
+  for (size_t I = 0; I != N; ++I) {
+    Base += 16 * (1 + Rng() % 8);
+    Keys.push_back(reinterpret_cast<void *>(Base));
+  }
+  return Keys;
+}
+
+// Symbol-like string keys.
+static std::vector<std::string> makeStringKeys(size_t N) {
+  std::vector<std::string> Keys;
+  Keys.reserve(N);
+  for (size_t I = 0; I != N; ++I)
+    Keys.push_back("_ZN4llvm" + std::to_string(I * 2654435761u) + "Ev");
+  return Keys;
+}
+
+template <typename MapT> static void BM_PointerInsert(benchmark::State &State) {
+  auto Keys = makePointerKeys(State.range(0));
+  for (auto _ : State) {
+    MapT M;
+    for (void *K : Keys)
+      M[K] = 1;
+    benchmark::DoNotOptimize(M.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+template <typename MapT> static void BM_PointerFind(benchmark::State &State) {
+  auto Keys = makePointerKeys(State.range(0));
+  auto Missing = makePointerKeys(State.range(0) * 2);
+  MapT M;
+  for (void *K : Keys)
+    M[K] = 1;
+  // Interleave hits and misses, as caches like SCEV's see both.
+  std::vector<void *> Queries;
+  for (size_t I = 0; I != Keys.size(); ++I) {
+    Queries.push_back(Keys[I]);
+    Queries.push_back(Missing[Keys.size() + I]);
+  }
+  std::shuffle(Queries.begin(), Queries.end(), std::mt19937_64(2));
+  for (auto _ : State) {
+    unsigned Found = 0;
+    for (void *K : Queries)
+      Found += M.count(K);
+    benchmark::DoNotOptimize(Found);
+  }
+  State.SetItemsProcessed(State.iterations() * Queries.size());
+}
+
+// Erase and re-insert in a loop, like a worklist keyed by instruction.
+template <typename MapT> static void BM_PointerChurn(benchmark::State &State) {
+  auto Keys = makePointerKeys(State.range(0) * 4);
+  size_t Live = State.range(0);
+  for (auto _ : State) {
+    MapT M;
+    for (size_t I = 0; I != Keys.size(); ++I) {
+      M[Keys[I]] = I;
+      if (I >= Live)
+        M.erase(Keys[I - Live]);
+    }
+    benchmark::DoNotOptimize(M.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+template <typename MapT> static void BM_StringFind(benchmark::State &State) {
+  auto Keys = makeStringKeys(State.range(0));
+  MapT M;
+  for (const std::string &K : Keys)
+    M[K] = 1;
+  for (auto _ : State) {
+    unsigned Found = 0;
+    for (const std::string &K : Keys)
+      Found += M.count(K);
+    benchmark::DoNotOptimize(Found);
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+using PtrDenseMap = DenseMap<void *, unsigned>;
+using PtrFlatHashMap = FlatHashMap<void *, unsigned>;
+using StrStringMap = StringMap<unsigned>;
+using StrDenseMap = DenseMap<StringRef, unsigned>;
+using StrFlatHashMap = FlatHashMap<StringRef, unsigned>;
+
+#define HASHMAP_BENCHMARK(BM, MapT)                                            \
+  BENCHMARK_TEMPLATE(BM, MapT)->RangeMultiplier(8)->Range(64, 1 << 18)
+
+HASHMAP_BENCHMARK(BM_PointerInsert, PtrDenseMap);
+HASHMAP_BENCHMARK(BM_PointerInsert, PtrFlatHashMap);
+HASHMAP_BENCHMARK(BM_PointerFind, PtrDenseMap);
+HASHMAP_BENCHMARK(BM_PointerFind, PtrFlatHashMap);
+HASHMAP_BENCHMARK(BM_PointerChurn, PtrDenseMap);
+HASHMAP_BENCHMARK(BM_PointerChurn, PtrFlatHashMap);
+HASHMAP_BENCHMARK(BM_StringFind, StrStringMap);
+HASHMAP_BENCHMARK(BM_StringFind, StrDenseMap);
+HASHMAP_BENCHMARK(BM_StringFind, StrFlatHashMap);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,83 @@
+#include "benchmark/benchmark.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include <memory>
+
+using namespace llvm;
+
+static Function *createFunction(Module &M, unsigned NumArgs) {
+  LLVMContext &Ctx = M.getContext();
+  SmallVector<Type *, 8> Params(NumArgs, Type::getInt32Ty(Ctx));
+  auto *FTy = FunctionType::get(Type::getInt32Ty(Ctx), Params, false);
+  return Function::Create(FTy, GlobalValue::ExternalLinkage, "f", M);
+}
+
+// Straight-line arithmetic, as emitted by a frontend.
+static void BM_IRBuilderArithmetic(benchmark::State &State) {
+  unsigned N = State.range(0);
+  LLVMContext Ctx;
+  for (auto _ : State) {
+    auto M = std::make_unique<Module>("m", Ctx);
+    Function *F = createFunction(*M, 2);
+    IRBuilder<> B(BasicBlock::Create(Ctx, "entry", F));
+    Value *Acc = F->getArg(0);
+    for (unsigned I = 0; I != N; ++I)
+      Acc = B.CreateAdd(B.CreateMul(Acc, F->getArg(1)), B.getInt32(I));
+    B.CreateRet(Acc);
+    benchmark::DoNotOptimize(F);
+  }
+  State.SetItemsProcessed(State.iterations() * N * 2);
+}
+BENCHMARK(BM_IRBuilderArithmetic)->Arg(64)->Arg(4096);
+
+// Build a value with many users, then replace it. Exercises Use list
+// insertion and RAUW.
+static void BM_ReplaceAllUsesWith(benchmark::State &State) {
+  unsigned N = State.range(0);
+  LLVMContext Ctx;
+  for (auto _ : State) {
+    State.PauseTiming();
+    auto M = std::make_unique<Module>("m", Ctx);
+    Function *F = createFunction(*M, 2);
+    IRBuilder<> B(BasicBlock::Create(Ctx, "entry", F));
+    Value *Old = B.CreateAdd(F->getArg(0), F->getArg(1));
+    Value *New = B.CreateSub(F->getArg(0), F->getArg(1));
+    for (unsigned I = 0; I != N; ++I)
+      B.CreateXor(Old, B.getInt32(I));
+    B.CreateRet(Old);
+    State.ResumeTiming();
+
+    Old->replaceAllUsesWith(New);
+    benchmark::DoNotOptimize(New);
+  }
+  State.SetItemsProcessed(State.iterations() * N);
+}
+BENCHMARK(BM_ReplaceAllUsesWith)->Arg(64)->Arg(4096);
+
+// Add and drop many uses of one value without timing IR construction.
+static void BM_UseListChurn(benchmark::State &State) {
+  unsigned N = State.range(0);
+  LLVMContext Ctx;
+  auto M = std::make_unique<Module>("m", Ctx);
+  Function *F = createFunction(*M, 2);
+  IRBuilder<> B(BasicBlock::Create(Ctx, "entry", F));
+  Value *A = F->getArg(0);
+  Value *C = F->getArg(1);
+  SmallVector<Instruction *, 0> Users;
+  for (unsigned I = 0; I != N; ++I)
+    Users.push_back(cast<Instruction>(B.CreateFreeze(A)));
+  B.CreateRet(A);
+  for (auto _ : State) {
+    for (Instruction *U : Users)
+      U->setOperand(0, C);
+    for (Instruction *U : Users)
+      U->setOperand(0, A);
+  }
+  State.SetItemsProcessed(State.iterations() * N * 2);
+}
+BENCHMARK(BM_UseListChurn)->Arg(64)->Arg(4096);
+
+BENCHMARK_MAIN();
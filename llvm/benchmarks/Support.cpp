@@ -0,0 +1,184 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/BLAKE3.h"
+#include "llvm/Support/Compression.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SpecialCaseList.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+// Compressible input that looks roughly like object file contents.
+static std::vector<uint8_t> makeData(size_t Size) {
+  std::vector<uint8_t> Data(Size);
+  std::mt19937 Rng(1);
+  for (size_t I = 0; I != Size; ++I)
+    Data[I] = (Rng() % 4 == 0) ? Rng() : I % 64;
+  return Data;
+}
+
+static void BM_RawSVectorOstreamWrite(benchmark::State &State) {
+  for (auto _ : State) {
+    SmallString<256> Buf;
+    raw_svector_ostream OS(Buf);
+    for (unsigned I = 0; I != 64; ++I)
+      OS << "name" << I << ' ' << 'x' << "\n";
+    benchmark::DoNotOptimize(Buf.data());
+  }
+}
+BENCHMARK(BM_RawSVectorOstreamWrite);
+
+static void BM_RawOstreamFormat(benchmark::State &State) {
+  for (auto _ : State) {
+    SmallString<256> Buf;
+    raw_svector_ostream OS(Buf);
+    for (unsigned I = 0; I != 64; ++I)
+      OS << format_hex(I * 0x1000, 10) << format("%5.2f", I * 0.5);
+    benchmark::DoNotOptimize(Buf.data());
+  }
+}
+BENCHMARK(BM_RawOstreamFormat);
+
+static void BM_XXH3_64(benchmark::State &State) {
+  auto Data = makeData(State.range(0));
+  for (auto _ : State)
+    benchmark::DoNotOptimize(xxh3_64bits(Data));
+  State.SetBytesProcessed(State.iterations() * Data.size());
+}
+BENCHMARK(BM_XXH3_64)->Arg(16)->Arg(256)->Arg(64 << 10);
+
+static void BM_XXHash64(benchmark::State &State) {
+  auto Data = makeData(State.range(0));
+  for (auto _ : State)
+    benchmark::DoNotOptimize(xxHash64(Data));
+  State.SetBytesProcessed(State.iterations() * Data.size());
+}
+BENCHMARK(BM_XXHash64)->Arg(16)->Arg(256)->Arg(64 << 10);
+
+static void BM_BLAKE3(benchmark::State &State) {
+  auto Data = makeData(State.range(0));
+  for (auto _ : State)
+    benchmark::DoNotOptimize(BLAKE3::hash(Data));
+  State.SetBytesProcessed(State.iterations() * Data.size());
+}
+BENCHMARK(BM_BLAKE3)->Arg(256)->Arg(64 << 10)->Arg(1 << 20);
+
+static void BM_Compress(benchmark::State &State) {
+  auto Format = static_cast<compression::Format>(State.range(0));
+  if (const char *Reason = compression::getReasonIfUnsupported(Format)) {
+    State.SkipWithError(Reason);
+    return;
+  }
+  auto Data = makeData(State.range(1));
+  for (auto _ : State) {
+    SmallVector<uint8_t, 0> Out;
+    compression::compress(compression::Params(Format), Data, Out);
+    benchmark::DoNotOptimize(Out.data());
+  }
+  State.SetBytesProcessed(State.iterations() * Data.size());
+}
+BENCHMARK(BM_Compress)
+    ->ArgsProduct({{int(compression::Format::Zlib),
+                    int(compression::Format::Zstd)},
+                   {64 << 10, 1 << 20}});
+
+static void BM_Decompress(benchmark::State &State) {
+  auto Format = static_cast<compression::Format>(State.range(0));
+  if (const char *Reason = compression::getReasonIfUnsupported(Format)) {
+    State.SkipWithError(Reason);
+    return;
+  }
+  auto Data = makeData(State.range(1));
+  SmallVector<uint8_t, 0> Compressed;
+  compression::compress(compression::Params(Format), Data, Compressed);
+  for (auto _ : State) {
+    SmallVector<uint8_t, 0> Out;
+    if (Error E = compression::decompress(Format, Compressed, Out,
+                                          Data.size())) {
+      State.SkipWithError(toString(std::move(E)).c_str());
+      return;
+    }
+    benchmark::DoNotOptimize(Out.data());
+  }
+  State.SetBytesProcessed(State.iterations() * Data.size());
+}
+BENCHMARK(BM_Decompress)
+    ->ArgsProduct({{int(compression::Format::Zlib),
+                    int(compression::Format::Zstd)},
+                   {64 << 10, 1 << 20}});
+
+// A mix of small and large values, as in DWARF and object file encodings.
+static std::vector<uint64_t> makeLEBValues() {
+  std::vector<uint64_t> Values(4096);
+  std::mt19937_64 Rng(1);
+  for (uint64_t &V : Values)
+    V = Rng() >> (Rng() % 64);
+  return Values;
+}
+
+static void BM_EncodeULEB128(benchmark::State &State) {
+  auto Values = makeLEBValues();
+  std::vector<uint8_t> Buf(Values.size() * 10);
+  for (auto _ : State) {
+    uint8_t *P = Buf.data();
+    for (uint64_t V : Values)
+      P += encodeULEB128(V, P);
+    benchmark::DoNotOptimize(P);
+  }
+  State.SetItemsProcessed(State.iterations() * Values.size());
+}
+BENCHMARK(BM_EncodeULEB128);
+
+static void BM_DecodeULEB128(benchmark::State &State) {
+  auto Values = makeLEBValues();
+  std::vector<uint8_t> Buf(Values.size() * 10);
+  uint8_t *End = Buf.data();
+  for (uint64_t V : Values)
+    End += encodeULEB128(V, End);
+  for (auto _ : State) {
+    uint64_t Sum = 0;
+    for (const uint8_t *P = Buf.data(); P != End;)
+      Sum += decodeULEB128AndInc(P, End);
+    benchmark::DoNotOptimize(Sum);
+  }
+  State.SetItemsProcessed(State.iterations() * Values.size());
+}
+BENCHMARK(BM_DecodeULEB128);
+
+// An ignorelist of State.range(0) entries, mostly exact names and name
+// prefixes with a few real globs, queried with names that mostly don't match.
+static void BM_SpecialCaseListMatch(benchmark::State &State) {
+  unsigned N = State.range(0);
+  std::string List;
+  for (unsigned I = 0; I != N; ++I) {
+    List += "fun:_ZN4llvm8function" + std::to_string(I);
+    List += I % 4 == 1 ? "*\n" : I % 64 == 2 ? "?x*\n" : "\n";
+  }
+  auto MB = MemoryBuffer::getMemBuffer(List);
+  std::string Error;
+  auto SCL = SpecialCaseList::create(MB.get(), Error);
+  if (!SCL) {
+    State.SkipWithError(Error.c_str());
+    return;
+  }
+
+  std::vector<std::string> Queries;
+  for (unsigned I = 0; I != 1024; ++I)
+    Queries.push_back("_ZN4llvm8function" + std::to_string(I * 7919 % (4 * N)) +
+                      "Ev");
+  for (auto _ : State)
+    for (const std::string &Q : Queries)
+      benchmark::DoNotOptimize(SCL->inSection("", "fun", Q));
+  State.SetItemsProcessed(State.iterations() * Queries.size());
+}
+BENCHMARK(BM_SpecialCaseListMatch)->Arg(100)->Arg(50000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,637 @@
+//===- llvm/ADT/FlatHashMap.h - Group-probed hash map -----------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the FlatHashMap class, an open-addressing hash map that
+/// keeps one byte of metadata per bucket and probes a group of buckets at a
+/// time.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_FLATHASHMAP_H
+#define LLVM_ADT_FLATHASHMAP_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/bit.h"
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemAlloc.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LLVM_FLATHASHMAP_USE_SSE2 1
+#endif
+
+namespace llvm {
+
+namespace detail {
+
+/// Control byte values. Full buckets hold the low 7 bits of their key's hash,
+/// so they are never negative.
+enum : int8_t { FlatHashEmpty = -128, FlatHashDeleted = -2 };
+
+/// A window of control bytes that is matched as a unit. Each match returns a
+/// bitmask with bit I set if bucket I of the window matches.
+class FlatHashGroup {
+public:
+  static constexpr unsigned Width = 16;
+
+  explicit FlatHashGroup(const int8_t *Ctrl) {
+#ifdef LLVM_FLATHASHMAP_USE_SSE2
+    Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Ctrl));
+#else
+    std::memcpy(Bytes, Ctrl, Width);
+#endif
+  }
+
+  /// Buckets that are full and whose hash matches \p H2.
+  uint32_t match(int8_t H2) const {
+#ifdef LLVM_FLATHASHMAP_USE_SSE2
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(H2), Bytes));
+#else
+    return matchIf([H2](int8_t C) { return C == H2; });
+#endif
+  }
+
+  /// Buckets that have never held an entry since the last rehash.
+  uint32_t matchEmpty() const {
+#ifdef LLVM_FLATHASHMAP_USE_SSE2
+    return _mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_set1_epi8(FlatHashEmpty), Bytes));
+#else
+    return matchIf([](int8_t C) { return C == FlatHashEmpty; });
+#endif
+  }
+
+  /// Buckets that an insertion can use.
+  uint32_t matchEmptyOrDeleted() const {
+#ifdef LLVM_FLATHASHMAP_USE_SSE2
+    return _mm_movemask_epi8(Bytes);
+#else
+    return matchIf([](int8_t C) { return C < 0; });
+#endif
+  }
+
+private:
+#ifdef LLVM_FLATHASHMAP_USE_SSE2
+  __m128i Bytes;
+#else
+  template <typename PredT> uint32_t matchIf(PredT Pred) const {
+    uint32_t Mask = 0;
+    for (unsigned I = 0; I != Width; ++I)
+      Mask |= uint32_t(Pred(Bytes[I])) << I;
+    return Mask;
+  }
+
+  int8_t Bytes[Width];
+#endif
+};
+
+} // end namespace detail
+
+/// An unordered map from KeyT to ValueT that stores its entries inline in a
+/// single open-addressed table, like DenseMap, and offers a DenseMap-style
+/// interface.
+///
+/// Unlike DenseMap, membership is tracked in a separate array of control
+/// bytes rather than through reserved key values, so KeyInfoT only needs
+/// getHashValue() and isEqual(), and every key value can be stored. Lookups
+/// compare 7 bits of the hash for a whole group of buckets at once (with SSE2
+/// where available) and only compare keys for buckets whose bits match.
+///
+/// As with DenseMap, inserting into the map may invalidate iterators and
+/// references to its entries. Erasing only invalidates the erased entry.
+template <typename KeyT, typename ValueT,
+          typename KeyInfoT = DenseMapInfo<KeyT>>
+class FlatHashMap {
+  using Group = detail::FlatHashGroup;
+  using BucketT = detail::DenseMapPair<KeyT, ValueT>;
+
+public:
+  using size_type = unsigned;
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+  using value_type = BucketT;
+
+  template <bool IsConst> class IteratorImpl {
+    friend class FlatHashMap;
+    friend class IteratorImpl<true>;
+
+    using BucketPtr = std::conditional_t<IsConst, const BucketT *, BucketT *>;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::conditional_t<IsConst, const BucketT, BucketT>;
+    using pointer = value_type *;
+    using reference = value_type &;
+    using iterator_category = std::forward_iterator_tag;
+
+    IteratorImpl() = default;
+
+    // Allow conversion from iterator to const_iterator.
+    template <bool IsConstSrc,
+              typename = std::enable_if_t<!IsConstSrc && IsConst>>
+    IteratorImpl(const IteratorImpl<IsConstSrc> &I)
+        : Ctrl(I.Ctrl), End(I.End), Bucket(I.Bucket) {}
+
+    reference operator*() const {
+      assert(Ctrl != End && "dereferencing end() iterator");
+      return *Bucket;
+    }
+    pointer operator->() const {
+      assert(Ctrl != End && "dereferencing end() iterator");
+      return Bucket;
+    }
+
+    IteratorImpl &operator++() {
+      assert(Ctrl != End && "incrementing end() iterator");
+      ++Ctrl;
+      ++Bucket;
+      skipNonFull();
+      return *this;
+    }
+    IteratorImpl operator++(int) {
+      IteratorImpl Tmp = *this;
+      ++*this;
+      return Tmp;
+    }
+
+    friend bool operator==(const IteratorImpl &LHS, const IteratorImpl &RHS) {
+      return LHS.Ctrl == RHS.Ctrl;
+    }
+    friend bool operator!=(const IteratorImpl &LHS, const IteratorImpl &RHS) {
+      return !(LHS == RHS);
+    }
+
+  private:
+    IteratorImpl(const int8_t *Ctrl, const int8_t *End, BucketPtr Bucket,
+                 bool NoAdvance = false)
+        : Ctrl(Ctrl), End(End), Bucket(Bucket) {
+      if (!NoAdvance)
+        skipNonFull();
+    }
+
+    void skipNonFull() {
+      while (Ctrl != End && *Ctrl < 0) {
+        ++Ctrl;
+        ++Bucket;
+      }
+    }
+
+    const int8_t *Ctrl = nullptr;
+    const int8_t *End = nullptr;
+    BucketPtr Bucket = nullptr;
+  };
+
+  using iterator = IteratorImpl<false>;
+  using const_iterator = IteratorImpl<true>;
+
+  explicit FlatHashMap(unsigned InitialReserve = 0) {
+    allocateBuckets(getMinBucketsToReserveFor(InitialReserve));
+  }
+
+  FlatHashMap(std::initializer_list<std::pair<KeyT, ValueT>> Vals)
+      : FlatHashMap(Vals.size()) {
+    insert(Vals.begin(), Vals.end());
+  }
+
+  template <typename InputIt> FlatHashMap(const InputIt &I, const InputIt &E) {
+    insert(I, E);
+  }
+
+  FlatHashMap(const FlatHashMap &Other) { copyFrom(Other); }
+
+  FlatHashMap(FlatHashMap &&Other) { swap(Other); }
+
+  ~FlatHashMap() {
+    destroyAll();
+    deallocateBuckets(Buckets, NumBuckets);
+  }
+
+  FlatHashMap &operator=(const FlatHashMap &Other) {
+    if (&Other != this) {
+      destroyAll();
+      deallocateBuckets(Buckets, NumBuckets);
+      copyFrom(Other);
+    }
+    return *this;
+  }
+
+  FlatHashMap &operator=(FlatHashMap &&Other) {
+    destroyAll();
+    deallocateBuckets(Buckets, NumBuckets);
+    Ctrl = nullptr;
+    Buckets = nullptr;
+    NumBuckets = NumEntries = GrowthLeft = 0;
+    swap(Other);
+    return *this;
+  }
+
+  void swap(FlatHashMap &Other) {
+    std::swap(Ctrl, Other.Ctrl);
+    std::swap(Buckets, Other.Buckets);
+    std::swap(NumBuckets, Other.NumBuckets);
+    std::swap(NumEntries, Other.NumEntries);
+    std::swap(GrowthLeft, Other.GrowthLeft);
+  }
+
+  iterator begin() { return iterator(Ctrl, Ctrl + NumBuckets, Buckets); }
+  iterator end() {
+    return iterator(Ctrl + NumBuckets, Ctrl + NumBuckets, Buckets + NumBuckets,
+                    /*NoAdvance=*/true);
+  }
+  const_iterator begin() const {
+    return const_iterator(Ctrl, Ctrl + NumBuckets, Buckets);
+  }
+  const_iterator end() const {
+    return const_iterator(Ctrl + NumBuckets, Ctrl + NumBuckets,
+                          Buckets + NumBuckets, /*NoAdvance=*/true);
+  }
+
+  [[nodiscard]] bool empty() const { return NumEntries == 0; }
+  unsigned size() const { return NumEntries; }
+
+  /// Grow the map so that it can hold \p NumEntries entries without growing
+  /// again.
+  void reserve(size_type NumEntries) {
+    unsigned NewNumBuckets = getMinBucketsToReserveFor(NumEntries);
+    if (NewNumBuckets > NumBuckets)
+      rehash(NewNumBuckets);
+  }
+
+  void clear() {
+    if (NumEntries == 0 && GrowthLeft == getMaxLoad(NumBuckets))
+      return;
+    destroyAll();
+    if (NumBuckets)
+      std::memset(Ctrl, detail::FlatHashEmpty, NumBuckets + Group::Width);
+    NumEntries = 0;
+    GrowthLeft = getMaxLoad(NumBuckets);
+  }
+
+  /// Return true if the specified key is in the map, false otherwise.
+  bool contains(const KeyT &Key) const {
+    return findIndex(Key, hashOf(Key)) != NumBuckets;
+  }
+
+  /// Return 1 if the specified key is in the map, 0 otherwise.
+  size_type count(const KeyT &Key) const { return contains(Key) ? 1 : 0; }
+
+  iterator find(const KeyT &Key) { return find_as(Key); }
+  const_iterator find(const KeyT &Key) const { return find_as(Key); }
+
+  /// Alternate version of find() which allows a different, and possibly less
+  /// expensive, key type. KeyInfoT must provide getHashValue() and isEqual()
+  /// overloads for LookupKeyT.
+  template <class LookupKeyT> iterator find_as(const LookupKeyT &Key) {
+    return makeIterator(findIndex(Key, hashOf(Key)));
+  }
+  template <class LookupKeyT>
+  const_iterator find_as(const LookupKeyT &Key) const {
+    return makeConstIterator(findIndex(Key, hashOf(Key)));
+  }
+
+  /// Return the entry for the specified key, or a default constructed value
+  /// if no such entry exists.
+  ValueT lookup(const KeyT &Key) const {
+    unsigned I = findIndex(Key, hashOf(Key));
+    if (I != NumBuckets)
+      return Buckets[I].getSecond();
+    return ValueT();
+  }
+
+  /// Return the entry for the specified key. Asserts that the key is in the
+  /// map.
+  const ValueT &at(const KeyT &Key) const {
+    unsigned I = findIndex(Key, hashOf(Key));
+    assert(I != NumBuckets && "FlatHashMap::at failed due to a missing key");
+    return Buckets[I].getSecond();
+  }
+
+  std::pair<iterator, bool> insert(const std::pair<KeyT, ValueT> &KV) {
+    return try_emplace(KV.first, KV.second);
+  }
+  std::pair<iterator, bool> insert(std::pair<KeyT, ValueT> &&KV) {
+    return try_emplace(std::move(KV.first), std::move(KV.second));
+  }
+
+  /// Insert a range of entries. Keys that are already in the map keep their
+  /// current value.
+  template <typename InputIt> void insert(InputIt I, InputIt E) {
+    for (; I != E; ++I)
+      insert(*I);
+  }
+
+  /// Insert a new entry constructed from \p Args if \p Key is not in the map.
+  /// Returns the entry for \p Key and whether it was inserted.
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(KeyT &&Key, Ts &&...Args) {
+    uint64_t Hash = hashOf(Key);
+    unsigned I = findIndex(Key, Hash);
+    if (I != NumBuckets)
+      return {makeIterator(I), false};
+    I = prepareInsert(Hash);
+    ::new (&Buckets[I].getFirst()) KeyT(std::move(Key));
+    ::new (&Buckets[I].getSecond()) ValueT(std::forward<Ts>(Args)...);
+    return {makeIterator(I), true};
+  }
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(const KeyT &Key, Ts &&...Args) {
+    uint64_t Hash = hashOf(Key);
+    unsigned I = findIndex(Key, Hash);
+    if (I != NumBuckets)
+      return {makeIterator(I), false};
+    I = prepareInsert(Hash);
+    ::new (&Buckets[I].getFirst()) KeyT(Key);
+    ::new (&Buckets[I].getSecond()) ValueT(std::forward<Ts>(Args)...);
+    return {makeIterator(I), true};
+  }
+
+  template <typename V>
+  std::pair<iterator, bool> insert_or_assign(const KeyT &Key, V &&Val) {
+    auto Ret = try_emplace(Key, std::forward<V>(Val));
+    if (!Ret.second)
+      Ret.first->second = std::forward<V>(Val);
+    return Ret;
+  }
+  template <typename V>
+  std::pair<iterator, bool> insert_or_assign(KeyT &&Key, V &&Val) {
+    auto Ret = try_emplace(std::move(Key), std::forward<V>(Val));
+    if (!Ret.second)
+      Ret.first->second = std::forward<V>(Val);
+    return Ret;
+  }
+
+  ValueT &operator[](const KeyT &Key) { return try_emplace(Key).first->second; }
+  ValueT &operator[](KeyT &&Key) {
+    return try_emplace(std::move(Key)).first->second;
+  }
+
+  /// Erase the entry for \p Key. Returns true if there was one.
+  bool erase(const KeyT &Key) {
+    unsigned I = findIndex(Key, hashOf(Key));
+    if (I == NumBuckets)
+      return false;
+    eraseIndex(I);
+    return true;
+  }
+  void erase(iterator I) { eraseIndex(I.Bucket - Buckets); }
+
+  /// Return the approximate size (in bytes) of the actual map. This is just
+  /// the raw memory used by the map. If entries are pointers to objects, the
+  /// size of the referenced objects are not included.
+  size_t getMemorySize() const { return getAllocationSize(NumBuckets); }
+
+private:
+  /// The share of buckets that may be full or deleted is capped at 7/8, so
+  /// that every probe sequence reaches an empty bucket quickly.
+  static unsigned getMaxLoad(unsigned NumBuckets) {
+    return NumBuckets - NumBuckets / 8;
+  }
+
+  static unsigned getMinBucketsToReserveFor(unsigned NumEntries) {
+    if (NumEntries == 0)
+      return 0;
+    uint64_t MinBuckets = (uint64_t(NumEntries) * 8 + 6) / 7;
+    return std::max<uint64_t>(Group::Width, PowerOf2Ceil(MinBuckets));
+  }
+
+  static size_t getAllocationSize(unsigned NumBuckets) {
+    if (NumBuckets == 0)
+      return 0;
+    return sizeof(BucketT) * NumBuckets + NumBuckets + Group::Width;
+  }
+
+  /// Hashes provided by DenseMapInfo are often weak in the low bits (e.g. for
+  /// pointers), but both the bucket index and the 7 bits stored in the control
+  /// byte come from the low bits. Mixing with a multiply spreads the entropy of
+  /// the whole hash into them.
+  template <typename LookupKeyT> static uint64_t hashOf(const LookupKeyT &Key) {
+    uint64_t H = uint64_t(KeyInfoT::getHashValue(Key)) * 0x9E3779B97F4A7C15ULL;
+    return H ^ (H >> 32);
+  }
+
+  static int8_t getH2(uint64_t Hash) { return Hash & 0x7f; }
+
+  /// Calls \p Visit with the first bucket of each group on the probe sequence
+  /// for \p Hash until it returns true. The groups start at triangular
+  /// multiples of the group width from the home bucket, which visits every
+  /// group when the number of buckets is a power of two.
+  template <typename VisitT>
+  void probe(uint64_t Hash, VisitT Visit) const {
+    assert(NumBuckets && "probing an empty table");
+    unsigned Mask = NumBuckets - 1;
+    unsigned Pos = (Hash >> 7) & Mask;
+    for (unsigned Stride = Group::Width;; Stride += Group::Width) {
+      if (Visit(Pos))
+        return;
+      Pos = (Pos + Stride) & Mask;
+    }
+  }
+
+  /// Returns the bucket holding \p Key, or NumBuckets if there is none.
+  template <typename LookupKeyT>
+  unsigned findIndex(const LookupKeyT &Key, uint64_t Hash) const {
+    if (NumBuckets == 0)
+      return 0;
+    unsigned Found = NumBuckets;
+    unsigned Mask = NumBuckets - 1;
+    int8_t H2 = getH2(Hash);
+    probe(Hash, [&](unsigned Pos) {
+      Group G(Ctrl + Pos);
+      for (uint32_t M = G.match(H2); M; M &= M - 1) {
+        unsigned I = (Pos + llvm::countr_zero(M)) & Mask;
+        if (LLVM_LIKELY(KeyInfoT::isEqual(Key, Buckets[I].getFirst()))) {
+          Found = I;
+          return true;
+        }
+      }
+      // A lookup never needs to continue past an empty bucket: an insertion
+      // would have used it.
+      return G.matchEmpty() != 0;
+    });
+    return Found;
+  }
+
+  /// Returns the first empty or deleted bucket on the probe sequence for
+  /// \p Hash. There always is one, since the load is capped.
+  unsigned findFirstNonFull(uint64_t Hash) const {
+    unsigned Found = 0;
+    unsigned Mask = NumBuckets - 1;
+    probe(Hash, [&](unsigned Pos) {
+      uint32_t M = Group(Ctrl + Pos).matchEmptyOrDeleted();
+      if (!M)
+        return false;
+      Found = (Pos + llvm::countr_zero(M)) & Mask;
+      return true;
+    });
+    return Found;
+  }
+
+  void setCtrl(unsigned I, int8_t H) {
+    Ctrl[I] = H;
+    // The first group of control bytes is mirrored after the last bucket so
+    // that a group starting at any bucket can be loaded without wrapping.
+    if (I < Group::Width)
+      Ctrl[NumBuckets + I] = H;
+  }
+
+  /// Claims a bucket for a new entry with hash \p Hash, growing the table if
+  /// needed, and returns its index. The caller constructs the entry.
+  unsigned prepareInsert(uint64_t Hash) {
+    unsigned I = NumBuckets ? findFirstNonFull(Hash) : 0;
+    // Reusing a deleted bucket doesn't use up any of the load budget.
+    if (LLVM_UNLIKELY(GrowthLeft == 0 &&
+                      (NumBuckets == 0 || Ctrl[I] == detail::FlatHashEmpty))) {
+      // If deleted buckets use up at least half the budget, drop them in a
+      // rehash of the current size instead of growing.
+      if (NumBuckets && uint64_t(NumEntries + 1) * 2 <= getMaxLoad(NumBuckets))
+        rehash(NumBuckets);
+      else
+        rehash(std::max<unsigned>(Group::Width, NumBuckets * 2));
+      I = findFirstNonFull(Hash);
+    }
+    if (Ctrl[I] == detail::FlatHashEmpty)
+      --GrowthLeft;
+    ++NumEntries;
+    setCtrl(I, getH2(Hash));
+    return I;
+  }
+
+  void eraseIndex(unsigned I) {
+    assert(I < NumBuckets && Ctrl[I] >= 0 && "erasing a non-full bucket");
+    Buckets[I].getSecond().~ValueT();
+    Buckets[I].getFirst().~KeyT();
+    --NumEntries;
+
+    // If every window of Width buckets containing I also contains an empty
+    // bucket, no probe sequence can have passed over I, so it can be marked
+    // empty again instead of deleted.
+    unsigned Mask = NumBuckets - 1;
+    uint32_t EmptyAfter = Group(Ctrl + I).matchEmpty();
+    uint32_t EmptyBefore =
+        Group(Ctrl + ((I - Group::Width) & Mask)).matchEmpty();
+    if (EmptyBefore && EmptyAfter &&
+        unsigned(llvm::countr_zero(EmptyAfter) +
+                 llvm::countl_zero(static_cast<uint16_t>(EmptyBefore))) <
+            Group::Width) {
+      setCtrl(I, detail::FlatHashEmpty);
+      ++GrowthLeft;
+    } else {
+      setCtrl(I, detail::FlatHashDeleted);
+    }
+  }
+
+  void allocateBuckets(unsigned Num) {
+    NumBuckets = Num;
+    GrowthLeft = getMaxLoad(Num);
+    if (Num == 0) {
+      Ctrl = nullptr;
+      Buckets = nullptr;
+      return;
+    }
+    Buckets = static_cast<BucketT *>(
+        allocate_buffer(getAllocationSize(Num), alignof(BucketT)));
+    Ctrl = reinterpret_cast<int8_t *>(Buckets + Num);
+    std::memset(Ctrl, detail::FlatHashEmpty, Num + Group::Width);
+  }
+
+  static void deallocateBuckets(BucketT *Buckets, unsigned NumBuckets) {
+    if (Buckets)
+      deallocate_buffer(Buckets, getAllocationSize(NumBuckets),
+                        alignof(BucketT));
+  }
+
+  void destroyAll() {
+    if constexpr (std::is_trivially_destructible_v<BucketT>)
+      return;
+    for (unsigned I = 0; I != NumBuckets; ++I) {
+      if (Ctrl[I] < 0)
+        continue;
+      Buckets[I].getSecond().~ValueT();
+      Buckets[I].getFirst().~KeyT();
+    }
+  }
+
+  void rehash(unsigned NewNumBuckets) {
+    int8_t *OldCtrl = Ctrl;
+    BucketT *OldBuckets = Buckets;
+    unsigned OldNumBuckets = NumBuckets;
+    allocateBuckets(NewNumBuckets);
+
+    for (unsigned I = 0; I != OldNumBuckets; ++I) {
+      if (OldCtrl[I] < 0)
+        continue;
+      BucketT &Old = OldBuckets[I];
+      uint64_t Hash = hashOf(Old.getFirst());
+      unsigned J = findFirstNonFull(Hash);
+      setCtrl(J, getH2(Hash));
+      ::new (&Buckets[J].getFirst()) KeyT(std::move(Old.getFirst()));
+      ::new (&Buckets[J].getSecond()) ValueT(std::move(Old.getSecond()));
+      Old.getSecond().~ValueT();
+      Old.getFirst().~KeyT();
+    }
+    GrowthLeft -= NumEntries;
+    deallocateBuckets(OldBuckets, OldNumBuckets);
+  }
+
+  void copyFrom(const FlatHashMap &Other) {
+    allocateBuckets(Other.NumBuckets);
+    NumEntries = Other.NumEntries;
+    GrowthLeft = Other.GrowthLeft;
+    if (NumBuckets == 0)
+      return;
+    std::memcpy(Ctrl, Other.Ctrl, NumBuckets + Group::Width);
+    for (unsigned I = 0; I != NumBuckets; ++I) {
+      if (Ctrl[I] < 0)
+        continue;
+      ::new (&Buckets[I].getFirst()) KeyT(Other.Buckets[I].getFirst());
+      ::new (&Buckets[I].getSecond()) ValueT(Other.Buckets[I].getSecond());
+    }
+  }
+
+  iterator makeIterator(unsigned I) {
+    return iterator(Ctrl + I, Ctrl + NumBuckets, Buckets + I,
+                    /*NoAdvance=*/true);
+  }
+  const_iterator makeConstIterator(unsigned I) const {
+    return const_iterator(Ctrl + I, Ctrl + NumBuckets, Buckets + I,
+                          /*NoAdvance=*/true);
+  }
+
+  /// NumBuckets + Group::Width control bytes, stored after the buckets in the
+  /// same allocation.
+  int8_t *Ctrl = nullptr;
+  BucketT *Buckets = nullptr;
+  unsigned NumBuckets = 0;
+  unsigned NumEntries = 0;
+  /// How many more empty buckets can be filled before the table must grow.
+  unsigned GrowthLeft = 0;
+};
+
+template <typename KeyT, typename ValueT, typename KeyInfoT>
+inline void swap(FlatHashMap<KeyT, ValueT, KeyInfoT> &LHS,
+                 FlatHashMap<KeyT, ValueT, KeyInfoT> &RHS) {
+  LHS.swap(RHS);
+}
+
+} // end namespace llvm
+
+#undef LLVM_FLATHASHMAP_USE_SSE2
+
+#endif // LLVM_ADT_FLATHASHMAP_H
@@ -4,6 +4,8 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/MC/MCSection.h"
 #include "llvm/MC/MCStreamer.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/StringSaver.h"
 #include <cassert>
 
 namespace llvm {
@@ -33,6 +35,10 @@ class DWPStringPool {
   MCStreamer &Out;
   MCSection *Sec;
   DenseMap<const char *, uint32_t, CStrDenseMapInfo> Pool;
+  // The keys are copies, so that the pool does not keep the input files
+  // alive: only unique strings are retained.
+  BumpPtrAllocator Alloc;
+  StringSaver Saver{Alloc};
   uint32_t Offset = 0;
 
 public:
@@ -41,14 +47,17 @@ public:
   uint32_t getOffset(const char *Str, unsigned Length) {
     assert(strlen(Str) + 1 == Length && "Ensure length hint is correct");
 
-    auto Pair = Pool.insert(std::make_pair(Str, Offset));
-    if (Pair.second) {
-      Out.switchSection(Sec);
-      Out.emitBytes(StringRef(Str, Length));
-      Offset += Length;
-    }
+    auto It = Pool.find(Str);
+    if (It != Pool.end())
+      return It->second;
 
-    return Pair.first->second;
+    const char *Key = Saver.save(StringRef(Str, Length - 1)).data();
+    Pool.try_emplace(Key, Offset);
+    Out.switchSection(Sec);
+    Out.emitBytes(StringRef(Key, Length));
+    uint32_t Result = Offset;
+    Offset += Length;
+    return Result;
   }
 };
 } // namespace llvm
@@ -355,7 +355,9 @@ public:
   /// Finalize the data in the GSYM creator prior to saving the data out.
   ///
   /// Finalize must be called after all FunctionInfo objects have been added
-  /// and before GsymCreator::save() is called.
+  /// and before GsymCreator::save() is called. The function infos are sorted
+  /// on the llvm::parallel executor, so callers control its thread count with
+  /// llvm::parallel::strategy.
   ///
   /// \param  OS Output stream to report duplicate function infos, overlapping
   ///         function infos, and function infos that were merged or removed.
@@ -85,6 +85,13 @@ std::string getDebuginfodDebuginfoUrlPath(object::BuildIDRef ID);
 /// server URLs.
 Expected<std::string> getCachedOrDownloadDebuginfo(object::BuildIDRef ID);
 
+/// Fetches the debug binaries for all of \p IDs into the default local cache,
+/// running up to \p MaxConcurrentRequests requests at once. Later calls to
+/// getCachedOrDownloadDebuginfo for these IDs are then answered from the
+/// cache. Failures are not reported; the later calls retry and report them.
+void prefetchDebuginfo(ArrayRef<object::BuildID> IDs,
+                       unsigned MaxConcurrentRequests = 16);
+
 /// Fetches any debuginfod artifact using the default local cache directory and
 /// server URLs.
 Expected<std::string> getCachedOrDownloadArtifact(StringRef UniqueKey,
@@ -24,13 +24,15 @@
 
 namespace llvm {
 
-enum class HTTPMethod { GET };
+enum class HTTPMethod { GET, PUT };
 
 /// A stateless description of an outbound HTTP request.
 struct HTTPRequest {
   SmallString<128> Url;
   SmallVector<std::string, 0> Headers;
   HTTPMethod Method = HTTPMethod::GET;
+  /// The data to send with a PUT request. It must outlive the request.
+  StringRef Body;
   bool FollowRedirects = true;
   HTTPRequest(StringRef Url);
 };
@@ -0,0 +1,74 @@
+//===-- llvm/Debuginfod/RemoteCache.h - Remote file cache -------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file declares remoteCache, a FileCache that backs a local cache
+/// directory with a content-addressed store on an HTTP server, so that cache
+/// entries (e.g. ThinLTO backend objects) can be shared between machines.
+///
+/// The protocol is deliberately simple: an entry with key K is fetched with
+/// GET <url>/K and published with PUT <url>/K. A 200 response to a GET is a
+/// hit; anything else is a miss.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_DEBUGINFOD_REMOTECACHE_H
+#define LLVM_DEBUGINFOD_REMOTECACHE_H
+
+#include "llvm/Support/Caching.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Mutex.h"
+#include "llvm/Support/ThreadPool.h"
+
+#include <chrono>
+
+namespace llvm {
+
+/// Publishes entries produced by a remoteCache client to the server on a
+/// background thread, so that finishing a cache entry never blocks on the
+/// network. Failed uploads are collected and reported by wait().
+class RemoteCacheUploader {
+public:
+  RemoteCacheUploader(
+      std::chrono::milliseconds Timeout = std::chrono::seconds(30));
+  ~RemoteCacheUploader();
+
+  /// Queues a PUT of the file at \p ObjectPath to \p Url.
+  void upload(std::string Url, std::string ObjectPath);
+
+  /// Blocks until all queued uploads have finished and returns their failures.
+  Error wait();
+
+private:
+  std::chrono::milliseconds Timeout;
+  sys::Mutex ErrorMutex;
+  Error Errors = Error::success();
+  DefaultThreadPool Pool;
+};
+
+/// Create a cache which looks entries up in the local cache directory first
+/// and then on the server at \p ServerUrlRef. Entries fetched from the server
+/// are written through to the local cache. Entries produced by the client
+/// after missing both are added to the local cache and then queued on
+/// \p Uploader, which must outlive the cache. Failing to reach the server on
+/// lookup is treated as a miss, so that a build never depends on the server
+/// being available.
+///
+/// The remaining arguments have the same meaning as for localCache.
+/// HTTPClient::initialize() must have been called before the cache is used.
+Expected<FileCache> remoteCache(
+    const Twine &CacheNameRef, const Twine &TempFilePrefixRef,
+    const Twine &CacheDirectoryPathRef, const Twine &ServerUrlRef,
+    RemoteCacheUploader &Uploader,
+    AddBufferFn AddBuffer = [](size_t Task, const Twine &ModuleName,
+                               std::unique_ptr<MemoryBuffer> MB) {},
+    std::chrono::milliseconds Timeout = std::chrono::seconds(30));
+
+} // end namespace llvm
+
+#endif // LLVM_DEBUGINFOD_REMOTECACHE_H
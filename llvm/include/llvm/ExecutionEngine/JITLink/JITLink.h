@@ -1854,6 +1854,12 @@ public:
   /// modifyPassConfig.
   virtual LinkGraphPassFunction getMarkLivePass(const Triple &TT) const;
 
+  /// Called by JITLink to determine whether the fixups of a large graph may be
+  /// applied concurrently on the llvm::parallel thread pool. The default
+  /// implementation returns false, so that JITLink doesn't start threads
+  /// behind the back of clients that schedule their own work.
+  virtual bool shouldApplyFixupsInParallel() const;
+
   /// Called by JITLink to modify the pass pipeline prior to linking.
   /// The default version performs no modification.
   virtual Error modifyPassConfig(LinkGraph &G, PassConfiguration &Config);
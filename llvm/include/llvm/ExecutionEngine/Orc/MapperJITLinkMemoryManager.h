@@ -46,6 +46,21 @@ public:
   // synchronous overload
   using JITLinkMemoryManager::deallocate;
 
+  /// A snapshot of how the reserved address space is being used.
+  struct Stats {
+    /// Bytes handed out to allocations that have not been deallocated.
+    size_t AllocatedBytes = 0;
+    /// Bytes reserved from the executor but not currently allocated.
+    size_t AvailableBytes = 0;
+    /// Number of disjoint available ranges.
+    size_t NumAvailableRanges = 0;
+    /// Size of the largest available range. When this is much smaller than
+    /// AvailableBytes the reservations are fragmented.
+    size_t LargestAvailableRange = 0;
+  };
+
+  Stats getStats();
+
 private:
   class InFlightAlloc;
 
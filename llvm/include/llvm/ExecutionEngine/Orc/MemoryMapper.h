@@ -81,9 +81,13 @@ public:
 
 class InProcessMemoryMapper : public MemoryMapper {
 public:
-  InProcessMemoryMapper(size_t PageSize);
+  InProcessMemoryMapper(size_t PageSize, bool UseHugePages = false);
 
-  static Expected<std::unique_ptr<InProcessMemoryMapper>> Create();
+  /// Create an InProcessMemoryMapper. If \p UseHugePages is true then
+  /// reservations ask the OS to back them with huge pages where supported,
+  /// which reduces iTLB pressure when the reservations are large.
+  static Expected<std::unique_ptr<InProcessMemoryMapper>>
+  Create(bool UseHugePages = false);
 
   unsigned int getPageSize() override { return PageSize; }
 
@@ -119,6 +123,7 @@ private:
   AllocationMap Allocations;
 
   size_t PageSize;
+  bool UseHugePages;
 };
 
 class SharedMemoryMapper final : public MemoryMapper {
@@ -0,0 +1,77 @@
+//===- PersistentObjectCache.h - On-disk object cache for ORC ---*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectCache that keeps compiled objects in a directory, so that they
+// survive process restarts.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_PERSISTENTOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_PERSISTENTOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/Error.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace llvm {
+namespace orc {
+
+/// An ObjectCache that stores objects on disk, content-addressed by a hash
+/// of the module's bitcode and a client-provided key.
+///
+/// The extra key must identify everything besides the IR that affects the
+/// generated code, e.g. the target triple, CPU, features and optimization
+/// level. Entries are written to a temporary file and renamed into place, so
+/// several processes may share one cache directory.
+///
+/// The key is computed when the compiler looks the module up, before codegen
+/// passes get a chance to modify the IR, and is reused when the compiled
+/// object is stored. Use it with SimpleCompiler or ConcurrentIRCompiler, e.g.
+/// through LLJITBuilder::setCompileFunctionCreator.
+class PersistentObjectCache : public ObjectCache {
+public:
+  /// Create a cache that stores its entries in \p CacheDir, creating the
+  /// directory if needed.
+  static Expected<std::unique_ptr<PersistentObjectCache>>
+  Create(StringRef CacheDir, std::string ExtraKey = "");
+
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+  /// Return the number of lookups that found a cached object.
+  size_t getNumHits() const { return NumHits; }
+
+  /// Return the number of lookups that required compilation.
+  size_t getNumMisses() const { return NumMisses; }
+
+private:
+  PersistentObjectCache(std::string CacheDir, std::string ExtraKey)
+      : CacheDir(std::move(CacheDir)), ExtraKey(std::move(ExtraKey)) {}
+
+  std::string computeKey(const Module &M) const;
+  std::string getEntryPath(StringRef Key) const;
+
+  std::string CacheDir;
+  std::string ExtraKey;
+
+  std::mutex PendingKeysMutex;
+  DenseMap<const Module *, std::string> PendingKeys;
+
+  std::atomic<size_t> NumHits{0};
+  std::atomic<size_t> NumMisses{0};
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_PERSISTENTOBJECTCACHE_H
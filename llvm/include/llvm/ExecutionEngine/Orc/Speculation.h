@@ -18,6 +18,7 @@
 #include "llvm/ExecutionEngine/Orc/DebugUtils.h"
 #include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/raw_ostream.h"
 #include <mutex>
 #include <type_traits>
 #include <utility>
@@ -203,6 +204,45 @@ private:
   ResultEval QueryAnalysis;
 };
 
+/// Records the order in which functions are materialized to a trace file, so
+/// that a later run can compile them ahead of time with
+/// replaySpeculationTrace.
+///
+/// Place this layer below a CompileOnDemandLayer: emit is then called when a
+/// function is first needed, and the trace captures the lazy-compile order.
+/// Each line of the trace names a JITDylib and a callable symbol materialized
+/// for it, separated by a tab. The JITDylib is the one the symbol was added
+/// to, not the CompileOnDemandLayer's implementation dylib, which a new
+/// session only creates on demand.
+class SpeculationTraceRecorder : public IRLayer {
+public:
+  static Expected<std::unique_ptr<SpeculationTraceRecorder>>
+  Create(ExecutionSession &ES, IRLayer &BaseLayer, StringRef TracePath);
+
+  void emit(std::unique_ptr<MaterializationResponsibility> R,
+            ThreadSafeModule TSM) override;
+
+private:
+  SpeculationTraceRecorder(ExecutionSession &ES, IRLayer &BaseLayer,
+                           std::unique_ptr<raw_fd_ostream> OS)
+      : IRLayer(ES, BaseLayer.getManglingOptions()), NextLayer(BaseLayer),
+        OS(std::move(OS)) {}
+
+  IRLayer &NextLayer;
+  std::mutex TraceMutex;
+  std::unique_ptr<raw_fd_ostream> OS;
+};
+
+/// Issue asynchronous lookups, in trace order, for the symbols recorded by a
+/// SpeculationTraceRecorder. The lookups trigger materialization through the
+/// session's TaskDispatcher, and follow a CompileOnDemandLayer's lazy stubs
+/// into its implementation dylib. With a concurrent dispatcher the functions
+/// are therefore compiled in the background before they are first called.
+///
+/// Symbols and JITDylibs that no longer exist are skipped, so a stale trace
+/// is harmless. Errors from the lookups are reported to the session.
+Error replaySpeculationTrace(ExecutionSession &ES, StringRef TracePath);
+
 } // namespace orc
 } // namespace llvm
 
@@ -99,6 +99,13 @@ struct Config {
   /// manager as the old one doesn't have this ability.
   std::string OptPipeline;
 
+  /// If this field is set and regular LTO code generation is split into
+  /// several partitions, this pipeline is run over each partition in parallel
+  /// right before its code generation. This allows moving function-level
+  /// optimizations out of the single-threaded OptPipeline, which then only
+  /// needs to contain the passes that need to see the whole module.
+  std::string PartitionOptPipeline;
+
   // If this field is set, it has the same effect of specifying an AA pipeline
   // identified by the string. Only works with the new pass manager, in
   // conjunction OptPipeline.
@@ -171,6 +178,16 @@ struct Config {
   /// Specific thinLTO modules to compile.
   std::vector<std::string> ThinLTOModulesToCompile;
 
+  /// If non-zero, the in-process ThinLTO backend only starts a backend if the
+  /// estimated peak memory of all running backends stays within this many
+  /// bytes. A backend is always started if no other backend is running.
+  uint64_t ThinLTOMemoryBudget = 0;
+
+  /// If non-empty, the thin link persists the cross-module import and export
+  /// lists in this directory and reuses them in later links whose combined
+  /// summary index is unchanged from the import computation's point of view.
+  std::string ThinLTOImportCacheDir;
+
   /// Time trace enabled.
   bool TimeTraceEnabled = false;
 
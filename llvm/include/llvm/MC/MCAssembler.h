@@ -198,6 +198,10 @@ private:
   /// were adjusted.
   bool layoutOnce();
 
+  /// Relax the fragments of \p Sec once and return true if any of them
+  /// changed. Invalidates the section's layout if so.
+  bool layoutSection(MCSection &Sec);
+
   /// Perform relaxation on a single fragment - returns true if the fragment
   /// changes as a result of relaxation.
   bool relaxFragment(MCFragment &F);
@@ -86,6 +86,11 @@ public:
   // Whether to compress DWARF debug sections.
   DebugCompressionType CompressDebugSections = DebugCompressionType::None;
 
+  // The number of threads used to compress a debug section with zstd. With
+  // more than one, sections larger than 1 MiB are compressed as independent
+  // frames in parallel; the output doesn't depend on the exact number.
+  unsigned CompressDebugSectionsThreads = 1;
+
   std::string ABIName;
   std::string AssemblyLanguage;
   std::string SplitDwarfFile;
@@ -15,6 +15,7 @@
 #ifndef LLVM_PASSES_STANDARDINSTRUMENTATIONS_H
 #define LLVM_PASSES_STANDARDINSTRUMENTATIONS_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
@@ -106,6 +107,26 @@ public:
   void registerCallbacks(PassInstrumentationCallbacks &PIC);
 };
 
+/// Skips optional function and loop passes on functions with more
+/// instructions than -opt-function-size-budget allows, and emits a missed
+/// optimization remark for each skipped pass. When 'size-budget' analysis
+/// remarks are enabled, also reports the instruction count delta of every
+/// pass that changes a function.
+class FunctionSizeBudgetInstrumentation {
+public:
+  void registerCallbacks(PassInstrumentationCallbacks &PIC);
+
+private:
+  bool shouldRun(StringRef PassID, Any IR);
+  void runBeforePass(Any IR);
+  void runAfterPass(StringRef PassID, Any IR, const PreservedAnalyses &PA);
+  unsigned getInstructionCount(const Function &F);
+
+  /// Instruction counts of functions that have not been changed since they
+  /// were counted.
+  DenseMap<const Function *, unsigned> InstCounts;
+};
+
 struct PrintPassOptions {
   /// Print adaptors and pass managers.
   bool Verbose = false;
@@ -586,6 +607,7 @@ class StandardInstrumentations {
   TimeProfilingPassesHandler TimeProfilingPasses;
   OptNoneInstrumentation OptNone;
   OptPassGateInstrumentation OptPassGate;
+  FunctionSizeBudgetInstrumentation FunctionSizeBudget;
   PreservedCFGCheckerInstrumentation PreservedCFGChecker;
   IRChangedPrinter PrintChangedIR;
   PseudoProbeVerifier PseudoProbeVerification;
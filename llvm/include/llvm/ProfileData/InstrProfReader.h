@@ -699,6 +699,11 @@ private:
   StringRef VTableName;
   /// A memory buffer holding binary ids.
   ArrayRef<uint8_t> BinaryIdsBuffer;
+  /// The encoded temporal profile traces. They are validated when the header
+  /// is read, but only decoded on the first call to getTemporalProfTraces,
+  /// since compilers don't use them.
+  const unsigned char *TemporalProfTracesPtr = nullptr;
+  uint64_t NumTemporalProfTraces = 0;
 
   // Index to the current record in the record array.
   unsigned RecordIndex = 0;
@@ -824,6 +829,10 @@ public:
     }
   }
 
+  /// The weights stored in the profile are used; \p Weight is ignored.
+  SmallVector<TemporalProfTraceTy> &
+  getTemporalProfTraces(std::optional<uint64_t> Weight = {}) override;
+
   Error readBinaryIds(std::vector<llvm::object::BuildID> &BinaryIds) override;
   Error printBinaryIds(raw_ostream &OS) override;
 };
@@ -123,6 +123,13 @@ protected:
     unsigned match(StringRef Query) const;
 
   private:
+    // Globs without metacharacters, and globs whose only metacharacter is a
+    // trailing '*', are looked up by hashing; lists often contain thousands
+    // of them. PrefixLengths holds the distinct lengths of the keys in
+    // Prefixes, in increasing order.
+    StringMap<unsigned> Literals;
+    StringMap<unsigned> Prefixes;
+    std::vector<size_t> PrefixLengths;
     StringMap<std::pair<GlobPattern, unsigned>> Globs;
     std::vector<std::pair<std::unique_ptr<Regex>, unsigned>> RegExes;
   };
@@ -69,6 +69,10 @@ private:
   /// The end index of each leaf in the tree.
   unsigned LeafEndIdx = SuffixTreeNode::EmptyIdx;
 
+  /// The number of nodes of each kind allocated for this tree.
+  size_t NumInternalNodes = 0;
+  size_t NumLeafNodes = 0;
+
   /// Helper struct which keeps track of the next insertion point in
   /// Ukkonen's algorithm.
   struct ActiveState {
@@ -155,6 +159,13 @@ public:
   SuffixTree(const ArrayRef<unsigned> &Str,
              bool OutlinerLeafDescendants = false);
 
+  /// \returns the number of bytes used by the nodes of this tree, not
+  /// counting the out-of-line storage of their child maps.
+  size_t getNodeMemorySize() const {
+    return NumInternalNodes * sizeof(SuffixTreeInternalNode) +
+           NumLeafNodes * sizeof(SuffixTreeLeafNode);
+  }
+
   /// Iterator for finding all repeated substrings in the suffix tree.
   struct RepeatedSubstringIterator {
   private:
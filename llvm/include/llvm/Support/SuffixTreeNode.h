@@ -30,6 +30,10 @@
 namespace llvm {
 
 /// A node in a suffix tree which represents a substring or suffix.
+///
+/// Nodes are owned by their SuffixTree's typed allocators, so there is no
+/// vtable. Large module-wide trees have one node per instruction, and
+/// dispatching on the kind keeps every node a pointer smaller.
 struct SuffixTreeNode {
 public:
   /// Represents an undefined index in the suffix tree.
@@ -65,7 +69,7 @@ public:
   unsigned getStartIdx() const;
 
   /// \returns the end index of this node.
-  virtual unsigned getEndIdx() const = 0;
+  unsigned getEndIdx() const;
 
   /// \return the index of this node's left most leaf node.
   unsigned getLeftLeafIdx() const;
@@ -90,7 +94,6 @@ public:
 
   SuffixTreeNode(NodeKind Kind, unsigned StartIdx)
       : Kind(Kind), StartIdx(StartIdx) {}
-  virtual ~SuffixTreeNode() = default;
 };
 
 // A node with two or more children, or the root.
@@ -134,7 +137,7 @@ public:
   bool isRoot() const;
 
   /// \returns the end index of this node's substring in the entire string.
-  unsigned getEndIdx() const override;
+  unsigned getEndIdx() const;
 
   /// Sets \p Link to \p L. Assumes \p L is not null.
   void setLink(SuffixTreeInternalNode *L);
@@ -153,8 +156,6 @@ public:
                          SuffixTreeInternalNode *Link)
       : SuffixTreeNode(NodeKind::ST_Internal, StartIdx), EndIdx(EndIdx),
         Link(Link) {}
-
-  virtual ~SuffixTreeInternalNode() = default;
 };
 
 // A node representing a suffix.
@@ -178,7 +179,7 @@ public:
   }
 
   /// \returns the end index of this node's substring in the entire string.
-  unsigned getEndIdx() const override;
+  unsigned getEndIdx() const;
 
   /// \returns the start index of the suffix represented by this leaf.
   unsigned getSuffixIdx() const;
@@ -187,8 +188,6 @@ public:
   void setSuffixIdx(unsigned Idx);
   SuffixTreeLeafNode(unsigned StartIdx, unsigned *EndIdx)
       : SuffixTreeNode(NodeKind::ST_Leaf, StartIdx), EndIdx(EndIdx) {}
-
-  virtual ~SuffixTreeLeafNode() = default;
 };
 } // namespace llvm
 #endif // LLVM_SUPPORT_SUFFIXTREE_NODE_H
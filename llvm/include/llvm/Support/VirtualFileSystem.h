@@ -14,9 +14,11 @@
 #ifndef LLVM_SUPPORT_VIRTUALFILESYSTEM_H
 #define LLVM_SUPPORT_VIRTUALFILESYSTEM_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/Errc.h"
@@ -809,12 +811,45 @@ public:
     std::vector<std::unique_ptr<Entry>> Contents;
     Status S;
 
+    /// The contents by lowercased name, in order, for directories with at
+    /// least IndexThreshold entries. Lookups in large overlays would spend
+    /// most of their time comparing names otherwise.
+    StringMap<SmallVector<Entry *, 1>> Index;
+    /// Whether some entry has a name that pathComponentMatches() may match
+    /// with a different lowercased name, so the index can't be used.
+    bool Unindexable = false;
+    static constexpr size_t IndexThreshold = 32;
+
+    void indexContent(Entry *E) {
+      StringRef Name = E->getName();
+      if (Name.empty() || Name == "/" || Name == "\\") {
+        Unindexable = true;
+        Index.clear();
+        return;
+      }
+      Index[Name.lower()].push_back(E);
+    }
+
+    void updateIndex() {
+      if (Unindexable || Contents.size() < IndexThreshold)
+        return;
+      if (!Index.empty()) {
+        indexContent(Contents.back().get());
+        return;
+      }
+      for (const std::unique_ptr<Entry> &E : Contents)
+        if (!Unindexable)
+          indexContent(E.get());
+    }
+
   public:
     /// Constructs a directory entry with explicitly specified contents.
     DirectoryEntry(StringRef Name, std::vector<std::unique_ptr<Entry>> Contents,
                    Status S)
         : Entry(EK_Directory, Name), Contents(std::move(Contents)),
-          S(std::move(S)) {}
+          S(std::move(S)) {
+      updateIndex();
+    }
 
     /// Constructs an empty directory entry.
     DirectoryEntry(StringRef Name, Status S)
@@ -824,10 +859,25 @@ public:
 
     void addContent(std::unique_ptr<Entry> Content) {
       Contents.push_back(std::move(Content));
+      updateIndex();
     }
 
     Entry *getLastContent() const { return Contents.back().get(); }
 
+    /// Whether lookupContent() can be used instead of iterating over all the
+    /// contents.
+    bool isIndexed() const { return !Index.empty(); }
+
+    /// Returns the entries whose name equals \p Name ignoring case, in
+    /// order. Only valid if isIndexed().
+    ArrayRef<Entry *> lookupContent(StringRef Name) const {
+      assert(isIndexed() && "Directory is not indexed");
+      auto I = Index.find(Name.lower());
+      if (I == Index.end())
+        return {};
+      return I->second;
+    }
+
     using iterator = decltype(Contents)::iterator;
 
     iterator contents_begin() { return Contents.begin(); }
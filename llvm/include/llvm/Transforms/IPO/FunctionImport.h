@@ -172,6 +172,21 @@ void ComputeCrossModuleImport(
     DenseMap<StringRef, FunctionImporter::ImportMapTy> &ImportLists,
     DenseMap<StringRef, FunctionImporter::ExportSetTy> &ExportLists);
 
+/// Like ComputeCrossModuleImport, but persists the computed import and export
+/// lists in \p CacheDir, keyed by a hash of everything the import computation
+/// depends on (module hashes, summary liveness, linkage and prevailing status,
+/// and the import thresholds). If a previous link left lists for the same key,
+/// they are read back instead of being recomputed. Falls back to
+/// ComputeCrossModuleImport if \p CacheDir is empty or a stable key can't be
+/// computed, e.g. because some module has no hash.
+void ComputeCrossModuleImportCached(
+    StringRef CacheDir, const ModuleSummaryIndex &Index,
+    const DenseMap<StringRef, GVSummaryMapTy> &ModuleToDefinedGVSummaries,
+    function_ref<bool(GlobalValue::GUID, const GlobalValueSummary *)>
+        isPrevailing,
+    DenseMap<StringRef, FunctionImporter::ImportMapTy> &ImportLists,
+    DenseMap<StringRef, FunctionImporter::ExportSetTy> &ExportLists);
+
 /// PrevailingType enum used as a return type of callback passed
 /// to computeDeadSymbolsAndUpdateIndirectCalls. Yes and No values used when
 /// status explicitly set by symbols resolution, otherwise status is Unknown.
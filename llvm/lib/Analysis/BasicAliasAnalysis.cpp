@@ -78,6 +78,10 @@ static cl::opt<bool> EnableSeparateStorageAnalysis("basic-aa-separate-storage",
 STATISTIC(SearchLimitReached, "Number of times the limit to "
                               "decompose GEPs is reached");
 STATISTIC(SearchTimes, "Number of times a GEP is decomposed");
+STATISTIC(NumAliasCacheHits, "Number of alias queries answered from cache");
+STATISTIC(NumAliasCacheMisses, "Number of alias queries computed");
+STATISTIC(NumAssumptionsDisproven,
+          "Number of NoAlias assumptions disproven in recursive queries");
 
 // The max limit of the search depth in DecomposeGEPExpression() and
 // getUnderlyingObject().
@@ -1690,6 +1694,7 @@ AliasResult BasicAAResult::aliasCheck(const Value *V1, LocationSize V1Size,
   const auto &Pair = AAQI.AliasCache.try_emplace(
       Locs, AAQueryInfo::CacheEntry{AliasResult::NoAlias, 0});
   if (!Pair.second) {
+    ++NumAliasCacheHits;
     auto &Entry = Pair.first->second;
     if (!Entry.isDefinitive()) {
       // Remember that we used an assumption.
@@ -1702,6 +1707,7 @@ AliasResult BasicAAResult::aliasCheck(const Value *V1, LocationSize V1Size,
     return Result;
   }
 
+  ++NumAliasCacheMisses;
   int OrigNumAssumptionUses = AAQI.NumAssumptionUses;
   unsigned OrigNumAssumptionBasedResults = AAQI.AssumptionBasedResults.size();
   AliasResult Result =
@@ -1714,8 +1720,10 @@ AliasResult BasicAAResult::aliasCheck(const Value *V1, LocationSize V1Size,
   // Check whether a NoAlias assumption has been used, but disproven.
   bool AssumptionDisproven =
       Entry.NumAssumptionUses > 0 && Result != AliasResult::NoAlias;
-  if (AssumptionDisproven)
+  if (AssumptionDisproven) {
+    ++NumAssumptionsDisproven;
     Result = AliasResult::MayAlias;
+  }
 
   // This is a definitive result now, when considered as a root query.
   AAQI.NumAssumptionUses -= Entry.NumAssumptionUses;
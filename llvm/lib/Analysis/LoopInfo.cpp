@@ -16,6 +16,7 @@
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/IVDescriptors.h"
 #include "llvm/Analysis/LoopIterator.h"
 #include "llvm/Analysis/LoopNestAnalysis.h"
@@ -40,6 +41,11 @@
 #include "llvm/Support/raw_ostream.h"
 using namespace llvm;
 
+#define DEBUG_TYPE "loops"
+
+STATISTIC(NumLoopInfoComputations,
+          "Number of loop infos computed from scratch by a pass manager");
+
 // Explicitly instantiate methods in LoopInfoImpl.h for IR-level Loops.
 template class llvm::LoopBase<BasicBlock, Loop>;
 template class llvm::LoopInfoBase<BasicBlock, Loop>;
@@ -973,6 +979,7 @@ LoopInfo LoopAnalysis::run(Function &F, FunctionAnalysisManager &AM) {
   // point it may prove worthwhile to use a freelist and recycle LoopInfo
   // objects. I don't want to add that kind of complexity until the scope of
   // the problem is better understood.
+  ++NumLoopInfoComputations;
   LoopInfo LI;
   LI.analyze(AM.getResult<DominatorTreeAnalysis>(F));
   return LI;
@@ -1211,6 +1218,7 @@ INITIALIZE_PASS_END(LoopInfoWrapperPass, "loops", "Natural Loop Information",
 
 bool LoopInfoWrapperPass::runOnFunction(Function &) {
   releaseMemory();
+  ++NumLoopInfoComputations;
   LI.analyze(getAnalysis<DominatorTreeWrapperPass>().getDomTree());
   return false;
 }
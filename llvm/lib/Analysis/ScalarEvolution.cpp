@@ -142,6 +142,20 @@ STATISTIC(NumExitCountsNotComputed,
           "Number of loop exits without predictable exit counts");
 STATISTIC(NumBruteForceTripCountsComputed,
           "Number of loops with trip counts computed by force");
+STATISTIC(NumSCEVCacheHits, "Number of getSCEV queries answered from cache");
+STATISTIC(NumSCEVCacheMisses, "Number of getSCEV queries that built a SCEV");
+STATISTIC(NumBECountCacheHits,
+          "Number of backedge-taken count queries answered from cache");
+STATISTIC(NumBECountCacheMisses,
+          "Number of backedge-taken count queries that computed a count");
+STATISTIC(NumConstantEvolutionCacheHits,
+          "Number of constant-evolution exit values answered from cache");
+STATISTIC(NumConstantEvolutionCacheMisses,
+          "Number of constant-evolution exit values that were evaluated");
+STATISTIC(MaxSCEVAllocatorBytes,
+          "Maximum bytes held by one ScalarEvolution's SCEV allocator");
+STATISTIC(MaxValueExprMapSize,
+          "Maximum number of values mapped by one ScalarEvolution");
 
 #ifdef EXPENSIVE_CHECKS
 bool llvm::VerifySCEV = true;
@@ -4569,8 +4583,11 @@ void ScalarEvolution::insertValueToMap(Value *V, const SCEV *S) {
 const SCEV *ScalarEvolution::getSCEV(Value *V) {
   assert(isSCEVable(V->getType()) && "Value is not SCEVable!");
 
-  if (const SCEV *S = getExistingSCEV(V))
+  if (const SCEV *S = getExistingSCEV(V)) {
+    ++NumSCEVCacheHits;
     return S;
+  }
+  ++NumSCEVCacheMisses;
   return createSCEVIter(V);
 }
 
@@ -8347,8 +8364,11 @@ ScalarEvolution::getBackedgeTakenInfo(const Loop *L) {
   // backedge-taken count, which could result in infinite recursion.
   std::pair<DenseMap<const Loop *, BackedgeTakenInfo>::iterator, bool> Pair =
       BackedgeTakenCounts.insert({L, BackedgeTakenInfo()});
-  if (!Pair.second)
+  if (!Pair.second) {
+    ++NumBECountCacheHits;
     return Pair.first->second;
+  }
+  ++NumBECountCacheMisses;
 
   // computeBackedgeTakenCount may allocate memory for its result. Inserting it
   // into the BackedgeTakenCounts map transfers ownership. Otherwise, the result
@@ -9627,8 +9647,11 @@ ScalarEvolution::getConstantEvolutionLoopExitValue(PHINode *PN,
                                                    const APInt &BEs,
                                                    const Loop *L) {
   auto I = ConstantEvolutionLoopExitValue.find(PN);
-  if (I != ConstantEvolutionLoopExitValue.end())
+  if (I != ConstantEvolutionLoopExitValue.end()) {
+    ++NumConstantEvolutionCacheHits;
     return I->second;
+  }
+  ++NumConstantEvolutionCacheMisses;
 
   if (BEs.ugt(MaxBruteForceIterations))
     return ConstantEvolutionLoopExitValue[PN] = nullptr;  // Not going to evaluate it.
@@ -13568,6 +13591,9 @@ ScalarEvolution::~ScalarEvolution() {
   }
   FirstUnknown = nullptr;
 
+  MaxSCEVAllocatorBytes.updateMax(SCEVAllocator.getBytesAllocated());
+  MaxValueExprMapSize.updateMax(ValueExprMap.size());
+
   ExprValueMap.clear();
   ValueExprMap.clear();
   HasRecMap.clear();
@@ -945,9 +945,27 @@ class ModuleSummaryIndexBitcodeReader : public BitcodeReaderBase {
   // ignoring the linkage, i.e. for values other than local linkage they are
   // identical (this is the second tuple member).
   // The third tuple member is the real GUID of the ValueInfo.
-  DenseMap<unsigned,
-           std::tuple<ValueInfo, GlobalValue::GUID, GlobalValue::GUID>>
-      ValueIdToValueInfoMap;
+  // It is consulted for every ref and call edge read, so it is a vector
+  // rather than a hash map: the module's globals take the first
+  // NumGlobalValueIds slots, followed by the values named by GUID-only
+  // records, whose IDs are assigned in order from RefValueIdBase. The few
+  // of those that fall outside the dense range go to
+  // SparseValueIdToValueInfoMap.
+  using ValueIdInfo =
+      std::tuple<ValueInfo, GlobalValue::GUID, GlobalValue::GUID>;
+  std::vector<ValueIdInfo> ValueIdToValueInfoMap;
+  DenseMap<uint64_t, ValueIdInfo> SparseValueIdToValueInfoMap;
+
+  /// The number of global values declared by the module, which bounds the
+  /// value IDs of its VST entries.
+  unsigned NumGlobalValueIds = 0;
+
+  /// The smallest value ID of the GUID-only records.
+  uint64_t RefValueIdBase = 0;
+
+  /// GUID-only value ID records read but not yet added, since the extent of
+  /// their ID range is only known once all of them are read.
+  std::vector<std::pair<uint64_t, GlobalValue::GUID>> PendingRefValueIds;
 
   /// Map populated during module path string table parsing, from the
   /// module ID to a string reference owned by the index's module
@@ -979,9 +997,11 @@ public:
   Error parseModule();
 
 private:
-  void setValueGUID(uint64_t ValueID, StringRef ValueName,
-                    GlobalValue::LinkageTypes Linkage,
-                    StringRef SourceFileName);
+  const ValueIdInfo *findValueId(uint64_t ValueID) const;
+  Error addPendingRefValueIds();
+  Error setValueGUID(uint64_t ValueID, StringRef ValueName,
+                     GlobalValue::LinkageTypes Linkage,
+                     StringRef SourceFileName);
   Error parseValueSymbolTable(
       uint64_t Offset,
       DenseMap<unsigned, GlobalValue::LinkageTypes> &ValueIdToLinkageMap);
@@ -7092,7 +7112,12 @@ ModuleSummaryIndexBitcodeReader::getThisModule() {
 template <bool AllowNullValueInfo>
 std::tuple<ValueInfo, GlobalValue::GUID, GlobalValue::GUID>
 ModuleSummaryIndexBitcodeReader::getValueInfoFromValueId(unsigned ValueId) {
-  auto VGI = ValueIdToValueInfoMap[ValueId];
+  const ValueIdInfo *Info = findValueId(ValueId);
+  if (!Info) {
+    assert(AllowNullValueInfo);
+    return {};
+  }
+  auto VGI = *Info;
   // We can have a null value info for memprof callsite info records in
   // distributed ThinLTO index files when the callee function summary is not
   // included in the index. The bitcode writer records 0 in that case,
@@ -7101,9 +7126,57 @@ ModuleSummaryIndexBitcodeReader::getValueInfoFromValueId(unsigned ValueId) {
   return VGI;
 }
 
-void ModuleSummaryIndexBitcodeReader::setValueGUID(
+const ModuleSummaryIndexBitcodeReader::ValueIdInfo *
+ModuleSummaryIndexBitcodeReader::findValueId(uint64_t ValueID) const {
+  if (ValueID < NumGlobalValueIds)
+    return ValueID < ValueIdToValueInfoMap.size()
+               ? &ValueIdToValueInfoMap[ValueID]
+               : nullptr;
+  if (ValueID >= RefValueIdBase) {
+    uint64_t Index = NumGlobalValueIds + (ValueID - RefValueIdBase);
+    if (Index < ValueIdToValueInfoMap.size())
+      return &ValueIdToValueInfoMap[Index];
+  }
+  auto I = SparseValueIdToValueInfoMap.find(ValueID);
+  return I == SparseValueIdToValueInfoMap.end() ? nullptr : &I->second;
+}
+
+// The writer assigns the IDs of GUID-only records from a counter, so they
+// mostly form one dense range; they are emitted in GUID order, though, so the
+// range is only known after all of them are read. The table grows by the
+// number of records, never by the value of an ID.
+Error ModuleSummaryIndexBitcodeReader::addPendingRefValueIds() {
+  if (PendingRefValueIds.empty())
+    return Error::success();
+
+  if (ValueIdToValueInfoMap.size() <= NumGlobalValueIds &&
+      SparseValueIdToValueInfoMap.empty()) {
+    RefValueIdBase = llvm::min_element(PendingRefValueIds)->first;
+    ValueIdToValueInfoMap.resize(NumGlobalValueIds + PendingRefValueIds.size());
+  }
+  uint64_t NumDenseRefs = ValueIdToValueInfoMap.size() - NumGlobalValueIds;
+  for (auto [ValueID, RefGUID] : PendingRefValueIds) {
+    // The IDs of the module's globals come first.
+    if (ValueID < NumGlobalValueIds)
+      return error("Invalid value id");
+    ValueIdInfo Info(TheIndex.getOrInsertValueInfo(RefGUID), RefGUID, RefGUID);
+    if (ValueID >= RefValueIdBase && ValueID - RefValueIdBase < NumDenseRefs)
+      ValueIdToValueInfoMap[NumGlobalValueIds + ValueID - RefValueIdBase] = Info;
+    else
+      SparseValueIdToValueInfoMap[ValueID] = Info;
+  }
+  PendingRefValueIds.clear();
+  return Error::success();
+}
+
+Error ModuleSummaryIndexBitcodeReader::setValueGUID(
     uint64_t ValueID, StringRef ValueName, GlobalValue::LinkageTypes Linkage,
     StringRef SourceFileName) {
+  if (ValueID >= NumGlobalValueIds)
+    return error("Invalid value id");
+  if (ValueIdToValueInfoMap.size() < NumGlobalValueIds)
+    ValueIdToValueInfoMap.resize(NumGlobalValueIds);
+
   std::string GlobalId =
       GlobalValue::getGlobalIdentifier(ValueName, Linkage, SourceFileName);
   auto ValueGUID = GlobalValue::getGUID(GlobalId);
@@ -7121,6 +7194,7 @@ void ModuleSummaryIndexBitcodeReader::setValueGUID(
       TheIndex.getOrInsertValueInfo(
           ValueGUID, UseStrtab ? ValueName : TheIndex.saveString(ValueName)),
       OriginalNameID, ValueGUID);
+  return Error::success();
 }
 
 // Specialized value symbol table parser used when reading module index
@@ -7158,6 +7232,8 @@ Error ModuleSummaryIndexBitcodeReader::parseValueSymbolTable(
     case BitstreamEntry::Error:
       return error("Malformed block");
     case BitstreamEntry::EndBlock:
+      if (Error Err = addPendingRefValueIds())
+        return Err;
       // Done parsing VST, jump back to wherever we came from.
       if (Error JumpFailed = Stream.JumpToBit(CurrentBit))
         return JumpFailed;
@@ -7180,11 +7256,11 @@ Error ModuleSummaryIndexBitcodeReader::parseValueSymbolTable(
         return error("Invalid record");
       unsigned ValueID = Record[0];
       assert(!SourceFileName.empty());
-      auto VLI = ValueIdToLinkageMap.find(ValueID);
-      assert(VLI != ValueIdToLinkageMap.end() &&
-             "No linkage found for VST entry?");
-      auto Linkage = VLI->second;
-      setValueGUID(ValueID, ValueName, Linkage, SourceFileName);
+      // Every value ID below NumGlobalValueIds has a linkage, and
+      // setValueGUID rejects the others.
+      auto Linkage = ValueIdToLinkageMap.lookup(ValueID);
+      if (Error Err = setValueGUID(ValueID, ValueName, Linkage, SourceFileName))
+        return Err;
       ValueName.clear();
       break;
     }
@@ -7194,11 +7270,11 @@ Error ModuleSummaryIndexBitcodeReader::parseValueSymbolTable(
         return error("Invalid record");
       unsigned ValueID = Record[0];
       assert(!SourceFileName.empty());
-      auto VLI = ValueIdToLinkageMap.find(ValueID);
-      assert(VLI != ValueIdToLinkageMap.end() &&
-             "No linkage found for VST entry?");
-      auto Linkage = VLI->second;
-      setValueGUID(ValueID, ValueName, Linkage, SourceFileName);
+      // Every value ID below NumGlobalValueIds has a linkage, and
+      // setValueGUID rejects the others.
+      auto Linkage = ValueIdToLinkageMap.lookup(ValueID);
+      if (Error Err = setValueGUID(ValueID, ValueName, Linkage, SourceFileName))
+        return Err;
       ValueName.clear();
       break;
     }
@@ -7208,8 +7284,7 @@ Error ModuleSummaryIndexBitcodeReader::parseValueSymbolTable(
       GlobalValue::GUID RefGUID = Record[1];
       // The "original name", which is the second value of the pair will be
       // overriden later by a FS_COMBINED_ORIGINAL_NAME in the combined index.
-      ValueIdToValueInfoMap[ValueID] = std::make_tuple(
-          TheIndex.getOrInsertValueInfo(RefGUID), RefGUID, RefGUID);
+      PendingRefValueIds.emplace_back(ValueID, RefGUID);
       break;
     }
     }
@@ -7343,12 +7418,16 @@ Error ModuleSummaryIndexBitcodeReader::parseModule() {
             return error("Invalid record");
           uint64_t RawLinkage = GVRecord[3];
           GlobalValue::LinkageTypes Linkage = getDecodedLinkage(RawLinkage);
+          unsigned GlobalValueId = ValueId++;
+          NumGlobalValueIds = ValueId;
           if (!UseStrtab) {
-            ValueIdToLinkageMap[ValueId++] = Linkage;
+            ValueIdToLinkageMap[GlobalValueId] = Linkage;
             break;
           }
 
-          setValueGUID(ValueId++, Name, Linkage, SourceFileName);
+          if (Error Err =
+                  setValueGUID(GlobalValueId, Name, Linkage, SourceFileName))
+            return Err;
           break;
         }
         }
@@ -7577,7 +7656,7 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     case BitstreamEntry::Error:
       return error("Malformed block");
     case BitstreamEntry::EndBlock:
-      return Error::success();
+      return addPendingRefValueIds();
     case BitstreamEntry::Record:
       // The interesting case.
       break;
@@ -7594,6 +7673,11 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     Expected<unsigned> MaybeBitCode = Stream.readRecord(Entry.ID, Record);
     if (!MaybeBitCode)
       return MaybeBitCode.takeError();
+    // The FS_VALUE_GUID records come first; add them before any record that
+    // refers to their IDs.
+    if (MaybeBitCode.get() != bitc::FS_VALUE_GUID)
+      if (Error Err = addPendingRefValueIds())
+        return Err;
     switch (unsigned BitCode = MaybeBitCode.get()) {
     default: // Default behavior: ignore.
       break;
@@ -7604,8 +7688,7 @@ Error ModuleSummaryIndexBitcodeReader::parseEntireSummary(unsigned ID) {
     case bitc::FS_VALUE_GUID: { // [valueid, refguid]
       uint64_t ValueID = Record[0];
       GlobalValue::GUID RefGUID = Record[1];
-      ValueIdToValueInfoMap[ValueID] = std::make_tuple(
-          TheIndex.getOrInsertValueInfo(RefGUID), RefGUID, RefGUID);
+      PendingRefValueIds.emplace_back(ValueID, RefGUID);
       break;
     }
     // FS_PERMODULE is legacy and does not have support for the tail call flag.
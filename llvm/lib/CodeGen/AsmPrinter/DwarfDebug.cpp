@@ -65,6 +65,7 @@ using namespace llvm;
 #define DEBUG_TYPE "dwarfdebug"
 
 STATISTIC(NumCSParams, "Number of dbg call site params created");
+STATISTIC(DIEBytes, "Number of bytes held by compile unit DIEs at emission");
 
 static cl::opt<bool> UseDwarfRangesBaseAddressSpecifier(
     "use-dwarf-ranges-base-address-specifier", cl::Hidden,
@@ -1436,6 +1437,9 @@ void DwarfDebug::endModule() {
   // Finalize the debug info for the module.
   finalizeModuleInfo();
 
+  for (const auto &P : CUMap)
+    DIEBytes += P.second->getDIEMemorySize();
+
   if (useSplitDwarf())
     // Emit debug_loc.dwo/debug_loclists.dwo section.
     emitDebugLocDWO();
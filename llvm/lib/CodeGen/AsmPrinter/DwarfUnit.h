@@ -114,6 +114,9 @@ public:
   /// Return true if this compile unit has something to write out.
   bool hasContent() const { return getUnitDie().hasChildren(); }
 
+  /// Return the number of bytes held by this unit's DIEs and DIE values.
+  size_t getDIEMemorySize() const { return DIEValueAllocator.getTotalMemory(); }
+
   /// Get string containing language specific context for a global name.
   ///
   /// Walks the metadata parent chain in a language specific manner (using the
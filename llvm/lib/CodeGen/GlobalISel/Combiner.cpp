@@ -32,6 +32,9 @@ STATISTIC(NumOneIteration, "Number of functions with one iteration");
 STATISTIC(NumTwoIterations, "Number of functions with two iterations");
 STATISTIC(NumThreeOrMoreIterations,
           "Number of functions with three or more iterations");
+STATISTIC(NumCombineAttempts, "Number of instructions tried for combining");
+STATISTIC(NumCombines, "Number of instructions successfully combined");
+STATISTIC(NumRevisits, "Number of instructions requeued by the observer");
 
 namespace llvm {
 cl::OptionCategory GICombinerOptionCategory(
@@ -72,6 +75,7 @@ public:
   }
   void createdInstr(MachineInstr &MI) override {
     LLVM_DEBUG(dbgs() << "Creating: " << MI << "\n");
+    ++NumRevisits;
     WorkList.insert(&MI);
     LLVM_DEBUG(CreatedInstrs.insert(&MI));
   }
@@ -81,6 +85,7 @@ public:
   }
   void changedInstr(MachineInstr &MI) override {
     LLVM_DEBUG(dbgs() << "Changed: " << MI << "\n");
+    ++NumRevisits;
     WorkList.insert(&MI);
   }
 
@@ -172,7 +177,11 @@ bool Combiner::combineMachineInstrs() {
     while (!WorkList.empty()) {
       MachineInstr *CurrInst = WorkList.pop_back_val();
       LLVM_DEBUG(dbgs() << "\nTry combining " << *CurrInst;);
-      Changed |= tryCombineAll(*CurrInst);
+      ++NumCombineAttempts;
+      if (tryCombineAll(*CurrInst)) {
+        ++NumCombines;
+        Changed = true;
+      }
       WLObserver->reportFullyCreatedInstrs();
     }
     MFChanged |= Changed;
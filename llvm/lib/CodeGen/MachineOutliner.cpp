@@ -58,6 +58,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/CodeGen/LivePhysRegs.h"
@@ -74,6 +75,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/SuffixTree.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include <functional>
 #include <tuple>
@@ -98,6 +100,9 @@ STATISTIC(NumInvisible,
           "Invisible instructions skipped during mapping");
 STATISTIC(UnsignedVecSize,
           "Total number of instructions mapped and saved to mapping vector");
+STATISTIC(NumRounds, "Number of outlining rounds run");
+STATISTIC(MaxSuffixTreeBytes,
+          "Maximum bytes used by the nodes of one round's suffix tree");
 
 // Set to true if the user wants the outliner to run on linkonceodr linkage
 // functions. This is false by default because the linker can dedupe linkonceodr
@@ -584,6 +589,7 @@ void MachineOutliner::findCandidates(
     InstructionMapper &Mapper, std::vector<OutlinedFunction> &FunctionList) {
   FunctionList.clear();
   SuffixTree ST(Mapper.UnsignedVec, OutlinerLeafDescendants);
+  MaxSuffixTreeBytes.updateMax(ST.getNodeMemorySize());
 
   // First, find all of the repeated substrings in the tree of minimum length
   // 2.
@@ -1159,6 +1165,9 @@ bool MachineOutliner::runOnModule(Module &M) {
 }
 
 bool MachineOutliner::doOutline(Module &M, unsigned &OutlinedFunctionNum) {
+  llvm::TimeTraceScope TimeScope("MachineOutlinerRound",
+                                 [&] { return utostr(OutlineRepeatedNum); });
+  ++NumRounds;
   MachineModuleInfo &MMI = getAnalysis<MachineModuleInfoWrapperPass>().getMMI();
 
   // If the user passed -enable-machine-outliner=always or
@@ -1181,11 +1190,17 @@ bool MachineOutliner::doOutline(Module &M, unsigned &OutlinedFunctionNum) {
   InstructionMapper Mapper;
 
   // Prepare instruction mappings for the suffix tree.
-  populateMapper(Mapper, M, MMI);
+  {
+    llvm::TimeTraceScope MapScope("MachineOutlinerMapping");
+    populateMapper(Mapper, M, MMI);
+  }
   std::vector<OutlinedFunction> FunctionList;
 
   // Find all of the outlining candidates.
-  findCandidates(Mapper, FunctionList);
+  {
+    llvm::TimeTraceScope FindScope("MachineOutlinerFindCandidates");
+    findCandidates(Mapper, FunctionList);
+  }
 
   // If we've requested size remarks, then collect the MI counts of every
   // function before outlining, and the MI counts after outlining.
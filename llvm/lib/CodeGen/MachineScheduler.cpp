@@ -74,6 +74,8 @@ using namespace llvm;
 #define DEBUG_TYPE "machine-scheduler"
 
 STATISTIC(NumClustered, "Number of load/store pairs clustered");
+STATISTIC(NumRegionsSplit,
+          "Number of scheduling regions split to stay within the size limit");
 
 namespace llvm {
 
@@ -152,6 +154,15 @@ static cl::opt<unsigned> SchedOnlyBlock("misched-only-block", cl::Hidden,
 static cl::opt<unsigned> ReadyListLimit("misched-limit", cl::Hidden,
   cl::desc("Limit ready list to N instructions"), cl::init(256));
 
+/// Bound the cost of building the scheduling DAG, which is superlinear in the
+/// region size, by ending regions early. The instruction a region is split at
+/// stays in place, like any other scheduling boundary.
+static cl::opt<unsigned> MaxRegionSize(
+    "misched-max-region-size", cl::Hidden,
+    cl::desc("Split scheduling regions larger than N instructions "
+             "(0 = unlimited)"),
+    cl::init(0));
+
 static cl::opt<bool> EnableRegPressure("misched-regpressure", cl::Hidden,
   cl::desc("Enable register pressure scheduling."), cl::init(true));
 
@@ -581,6 +592,12 @@ getSchedRegions(MachineBasicBlock *MBB,
       if (!MI.isDebugOrPseudoInstr()) {
         // MBB::size() uses instr_iterator to count. Here we need a bundle to
         // count as a single instruction.
+        if (MaxRegionSize && NumRegionInstrs == MaxRegionSize) {
+          LLVM_DEBUG(dbgs() << "Splitting scheduling region of "
+                            << printMBBReference(*MBB) << " at " << MI);
+          ++NumRegionsSplit;
+          break;
+        }
         ++NumRegionInstrs;
       }
     }
@@ -81,6 +81,8 @@ using namespace llvm;
 STATISTIC(NumGlobalSplits, "Number of split global live ranges");
 STATISTIC(NumLocalSplits,  "Number of split local live ranges");
 STATISTIC(NumEvicted,      "Number of interferences evicted");
+STATISTIC(NumSplitsOverBudget,
+          "Number of live ranges spilled because the split budget ran out");
 
 static cl::opt<SplitEditor::ComplementSpillMode> SplitSpillMode(
     "split-spill-mode", cl::Hidden,
@@ -146,6 +148,12 @@ static cl::opt<unsigned> SplitThresholdForRegWithHint(
              "percentate"),
     cl::init(75), cl::Hidden);
 
+static cl::opt<unsigned> SplitBudgetPerFunction(
+    "regalloc-split-budget",
+    cl::desc("Maximum number of live range split attempts per function; "
+             "ranges are spilled instead once it is reached (0 = unlimited)"),
+    cl::init(0), cl::Hidden);
+
 static RegisterRegAlloc greedyRegAlloc("greedy", "greedy register allocator",
                                        createGreedyRegisterAllocator);
 
@@ -1804,6 +1812,16 @@ unsigned RAGreedy::trySplit(const LiveInterval &VirtReg, AllocationOrder &Order,
   if (ExtraInfo->getStage(VirtReg) >= RS_Spill)
     return 0;
 
+  // Give up on splitting once this function has used its budget. The range
+  // is spilled instead, which bounds compile time on huge functions.
+  if (SplitBudget) {
+    if (*SplitBudget == 0) {
+      ++NumSplitsOverBudget;
+      return 0;
+    }
+    --*SplitBudget;
+  }
+
   // Local intervals are handled separately.
   if (LIS->intervalIsInOneMBB(VirtReg)) {
     NamedRegionTimer T("local_split", "Local Splitting", TimerGroupName,
@@ -2767,6 +2785,9 @@ bool RAGreedy::runOnMachineFunction(MachineFunction &mf) {
   IntfCache.init(MF, Matrix->getLiveUnions(), Indexes, LIS, TRI);
   GlobalCand.resize(32);  // This will grow as needed.
   SetOfBrokenHints.clear();
+  SplitBudget.reset();
+  if (SplitBudgetPerFunction)
+    SplitBudget = SplitBudgetPerFunction;
 
   allocatePhysRegs();
   tryHintsRecoloring();
@@ -35,6 +35,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <utility>
 
@@ -280,6 +281,10 @@ private:
 
   bool ReverseLocalAssignment = false;
 
+  /// The number of split attempts left in this function, or std::nullopt if
+  /// splitting effort is not capped.
+  std::optional<unsigned> SplitBudget;
+
 public:
   RAGreedy(const RegClassFilterFunc F = nullptr);
 
@@ -657,12 +657,11 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
 
   DWPStringPool Strings(Out, StrSection);
 
-  SmallVector<OwningBinary<object::ObjectFile>, 128> Objects;
-  Objects.reserve(Inputs.size());
-
-  std::deque<SmallString<32>> UncompressedSections;
-
   for (const auto &Input : Inputs) {
+    // Each input, and any section decompressed from it, is only needed while
+    // it is being copied: everything emitted to the streamer is copied and
+    // the string pool and index entries own their strings. Releasing inputs
+    // as we go keeps memory use from growing with the number of inputs.
     auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
     if (!ErrOrObj) {
       return handleErrors(ErrOrObj.takeError(),
@@ -671,8 +670,9 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
                           });
     }
 
-    auto &Obj = *ErrOrObj->getBinary();
-    Objects.push_back(std::move(*ErrOrObj));
+    OwningBinary<object::ObjectFile> Binary = std::move(*ErrOrObj);
+    auto &Obj = *Binary.getBinary();
+    std::deque<SmallString<32>> UncompressedSections;
 
     UnitIndexEntry CurEntry = {};
 
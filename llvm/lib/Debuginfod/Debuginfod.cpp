@@ -159,6 +159,21 @@ Expected<std::string> getCachedOrDownloadDebuginfo(BuildIDRef ID) {
   return getCachedOrDownloadArtifact(getDebuginfodCacheKey(UrlPath), UrlPath);
 }
 
+void prefetchDebuginfo(ArrayRef<object::BuildID> IDs,
+                       unsigned MaxConcurrentRequests) {
+  // Requests are dominated by network latency, so one request per thread,
+  // regardless of the number of cores.
+  DefaultThreadPool Pool(hardware_concurrency(
+      std::min<size_t>(MaxConcurrentRequests, IDs.size())));
+  for (const object::BuildID &ID : IDs)
+    Pool.async([&ID] {
+      Expected<std::string> PathOrErr = getCachedOrDownloadDebuginfo(ID);
+      if (!PathOrErr)
+        consumeError(PathOrErr.takeError());
+    });
+  Pool.wait();
+}
+
 // General fetching function.
 Expected<std::string> getCachedOrDownloadArtifact(StringRef UniqueKey,
                                                   StringRef UrlPath) {
@@ -27,7 +27,7 @@ using namespace llvm;
 HTTPRequest::HTTPRequest(StringRef Url) { this->Url = Url.str(); }
 
 bool operator==(const HTTPRequest &A, const HTTPRequest &B) {
-  return A.Url == B.Url && A.Method == B.Method &&
+  return A.Url == B.Url && A.Method == B.Method && A.Body == B.Body &&
          A.FollowRedirects == B.FollowRedirects;
 }
 
@@ -105,14 +105,24 @@ HTTPClient::~HTTPClient() { curl_easy_cleanup(Curl); }
 
 Error HTTPClient::perform(const HTTPRequest &Request,
                           HTTPResponseHandler &Handler) {
-  if (Request.Method != HTTPMethod::GET)
-    return createStringError(errc::invalid_argument,
-                             "Unsupported CURL request method.");
-
   SmallString<128> Url = Request.Url;
   curl_easy_setopt(Curl, CURLOPT_URL, Url.c_str());
   curl_easy_setopt(Curl, CURLOPT_FOLLOWLOCATION, Request.FollowRedirects);
 
+  // The handle is reused across requests, so reset the method every time.
+  switch (Request.Method) {
+  case HTTPMethod::GET:
+    curl_easy_setopt(Curl, CURLOPT_CUSTOMREQUEST, nullptr);
+    curl_easy_setopt(Curl, CURLOPT_HTTPGET, 1L);
+    break;
+  case HTTPMethod::PUT:
+    curl_easy_setopt(Curl, CURLOPT_CUSTOMREQUEST, "PUT");
+    curl_easy_setopt(Curl, CURLOPT_POSTFIELDS, Request.Body.data());
+    curl_easy_setopt(Curl, CURLOPT_POSTFIELDSIZE_LARGE,
+                     static_cast<curl_off_t>(Request.Body.size()));
+    break;
+  }
+
   curl_slist *Headers = nullptr;
   for (const std::string &Header : Request.Headers)
     Headers = curl_slist_append(Headers, Header.c_str());
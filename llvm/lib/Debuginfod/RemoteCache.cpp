@@ -0,0 +1,175 @@
+//===-- llvm/Debuginfod/RemoteCache.cpp - Remote file cache -----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file implements a FileCache that shares entries through an HTTP
+/// server, using a local cache directory for write-through.
+///
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Debuginfod/RemoteCache.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Debuginfod/HTTPClient.h"
+#include "llvm/Support/Errc.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+
+namespace {
+
+/// Collects the body of an HTTP response in memory.
+class BufferedHTTPResponseHandler final : public HTTPResponseHandler {
+public:
+  std::string Body;
+  Error handleBodyChunk(StringRef BodyChunk) override {
+    Body += BodyChunk;
+    return Error::success();
+  }
+};
+
+/// Wraps a stream of the local cache. When the client is done writing, the
+/// local cache commits the entry, which is then queued for upload.
+class UploadingCachedFileStream final : public CachedFileStream {
+public:
+  UploadingCachedFileStream(std::unique_ptr<CachedFileStream> LocalStream,
+                            std::string Url, RemoteCacheUploader &Uploader)
+      : CachedFileStream(std::move(LocalStream->OS),
+                         LocalStream->ObjectPathName),
+        LocalStream(std::move(LocalStream)), Url(std::move(Url)),
+        Uploader(Uploader) {}
+
+  ~UploadingCachedFileStream() {
+    LocalStream->OS = std::move(OS);
+    LocalStream.reset();
+    Uploader.upload(std::move(Url), std::move(ObjectPathName));
+  }
+
+private:
+  std::unique_ptr<CachedFileStream> LocalStream;
+  std::string Url;
+  RemoteCacheUploader &Uploader;
+};
+
+} // end anonymous namespace
+
+RemoteCacheUploader::RemoteCacheUploader(std::chrono::milliseconds Timeout)
+    : Timeout(Timeout), Pool(hardware_concurrency(1)) {}
+
+RemoteCacheUploader::~RemoteCacheUploader() {
+  // Uploads are best effort; clients that care call wait() themselves.
+  consumeError(wait());
+}
+
+void RemoteCacheUploader::upload(std::string Url, std::string ObjectPath) {
+  Pool.async([this, Url = std::move(Url), ObjectPath = std::move(ObjectPath)] {
+    Error Err = [&]() -> Error {
+      ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
+          MemoryBuffer::getFile(ObjectPath, /*IsText=*/false,
+                                /*RequiresNullTerminator=*/false);
+      if (!MBOrErr)
+        return createFileError(ObjectPath, MBOrErr.getError());
+      HTTPRequest Request(Url);
+      Request.Method = HTTPMethod::PUT;
+      Request.Body = (*MBOrErr)->getBuffer();
+      BufferedHTTPResponseHandler Handler;
+      HTTPClient Client;
+      Client.setTimeout(Timeout);
+      if (Error Err = Client.perform(Request, Handler))
+        return createStringError(errc::io_error, "failed to upload %s: %s",
+                                 Url.c_str(),
+                                 toString(std::move(Err)).c_str());
+      unsigned Code = Client.responseCode();
+      if (Code < 200 || Code >= 300)
+        return createStringError(errc::io_error,
+                                 "failed to upload %s: HTTP status %u",
+                                 Url.c_str(), Code);
+      return Error::success();
+    }();
+    if (Err) {
+      std::lock_guard<sys::Mutex> Guard(ErrorMutex);
+      Errors = joinErrors(std::move(Errors), std::move(Err));
+    }
+  });
+}
+
+Error RemoteCacheUploader::wait() {
+  Pool.wait();
+  std::lock_guard<sys::Mutex> Guard(ErrorMutex);
+  return std::move(Errors);
+}
+
+/// Fetches \p Url, returning its contents on a 200 response.
+static std::optional<std::string> fetch(StringRef Url,
+                                        std::chrono::milliseconds Timeout) {
+  HTTPRequest Request(Url);
+  BufferedHTTPResponseHandler Handler;
+  HTTPClient Client;
+  Client.setTimeout(Timeout);
+  if (Error Err = Client.perform(Request, Handler)) {
+    consumeError(std::move(Err));
+    return std::nullopt;
+  }
+  if (Client.responseCode() != 200)
+    return std::nullopt;
+  return std::move(Handler.Body);
+}
+
+Expected<FileCache> llvm::remoteCache(const Twine &CacheNameRef,
+                                      const Twine &TempFilePrefixRef,
+                                      const Twine &CacheDirectoryPathRef,
+                                      const Twine &ServerUrlRef,
+                                      RemoteCacheUploader &Uploader,
+                                      AddBufferFn AddBuffer,
+                                      std::chrono::milliseconds Timeout) {
+  if (!HTTPClient::isAvailable())
+    return createStringError(errc::not_supported,
+                             "remote caching requires LLVM to be built with "
+                             "an HTTP client (LLVM_ENABLE_CURL)");
+
+  Expected<FileCache> LocalCacheOrErr = localCache(
+      CacheNameRef, TempFilePrefixRef, CacheDirectoryPathRef, AddBuffer);
+  if (!LocalCacheOrErr)
+    return LocalCacheOrErr.takeError();
+
+  std::string ServerUrl = ServerUrlRef.str();
+  while (StringRef(ServerUrl).ends_with("/"))
+    ServerUrl.pop_back();
+
+  return [=, &Uploader, LocalCache = std::move(*LocalCacheOrErr)](
+             unsigned Task, StringRef Key,
+             const Twine &ModuleName) -> Expected<AddStreamFn> {
+    Expected<AddStreamFn> AddStreamOrErr = LocalCache(Task, Key, ModuleName);
+    // Return errors and local hits as they are.
+    if (!AddStreamOrErr || !*AddStreamOrErr)
+      return AddStreamOrErr;
+    AddStreamFn LocalAddStream = std::move(*AddStreamOrErr);
+    std::string Url = ServerUrl + "/" + Key.str();
+
+    // On a remote hit, write the entry through the local cache, which adds it
+    // to the client with AddBuffer.
+    if (std::optional<std::string> Body = fetch(Url, Timeout)) {
+      Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+          LocalAddStream(Task, ModuleName);
+      if (!StreamOrErr)
+        return StreamOrErr.takeError();
+      *(*StreamOrErr)->OS << *Body;
+      StreamOrErr->reset();
+      return AddStreamFn();
+    }
+
+    return [=, &Uploader](unsigned Task, const Twine &ModuleName)
+               -> Expected<std::unique_ptr<CachedFileStream>> {
+      Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+          LocalAddStream(Task, ModuleName);
+      if (!StreamOrErr)
+        return StreamOrErr.takeError();
+      return std::make_unique<UploadingCachedFileStream>(
+          std::move(*StreamOrErr), Url, Uploader);
+    };
+  };
+}
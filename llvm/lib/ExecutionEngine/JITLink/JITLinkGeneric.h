@@ -14,6 +14,10 @@
 #define LIB_EXECUTIONENGINE_JITLINK_JITLINKGENERIC_H
 
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/Support/Parallel.h"
+
+#include <mutex>
+#include <vector>
 
 #define DEBUG_TYPE "jitlink"
 
@@ -52,6 +56,11 @@ protected:
     return Ctx->shouldAddDefaultTargetPasses(TT);
   }
 
+  // Returns true if the context allows fixups to be applied in parallel.
+  bool shouldApplyFixupsInParallel() const {
+    return Ctx->shouldApplyFixupsInParallel();
+  }
+
   // Returns the PassConfiguration for this instance. This can be used by
   // JITLinkerBase implementations to add late passes that reference their
   // own data structures (e.g. for ELF implementations to locate / construct
@@ -103,6 +112,10 @@ private:
   std::unique_ptr<InFlightAlloc> Alloc;
 };
 
+/// Graphs with at least this many blocks have their fixups applied in
+/// parallel, if the JITLinkContext allows it.
+constexpr size_t ParallelFixupThreshold = 4096;
+
 template <typename LinkerImpl> class JITLinker : public JITLinkerBase {
 public:
   using JITLinkerBase::JITLinkerBase;
@@ -132,46 +145,84 @@ private:
   Error fixUpBlocks(LinkGraph &G) const override {
     LLVM_DEBUG(dbgs() << "Fixing up blocks:\n");
 
+    // Fixups for a block only write to that block's working memory, so blocks
+    // can be fixed up in parallel. Copying no-alloc content onto the graph's
+    // allocator is not thread-safe and is done up front.
+    std::vector<Block *> Blocks;
     for (auto &Sec : G.sections()) {
       bool NoAllocSection = Sec.getMemLifetime() == orc::MemLifetime::NoAlloc;
-
       for (auto *B : Sec.blocks()) {
-        LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
-
-        // Copy Block data and apply fixups.
-        LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
-        assert((!B->isZeroFill() || all_of(B->edges(),
-                                           [](const Edge &E) {
-                                             return E.getKind() ==
-                                                    Edge::KeepAlive;
-                                           })) &&
-               "Non-KeepAlive edges in zero-fill block?");
-
         // If this is a no-alloc section then copy the block content into
         // memory allocated on the Graph's allocator (if it hasn't been
         // already).
         if (NoAllocSection)
           (void)B->getMutableContent(G);
+        Blocks.push_back(B);
+      }
+    }
 
-        for (auto &E : B->edges()) {
-
-          // Skip non-relocation edges.
-          if (!E.isRelocation())
-            continue;
+    // Stay serial under -debug-only=jitlink to keep the output readable.
+    bool Serial = !shouldApplyFixupsInParallel() ||
+                  Blocks.size() < ParallelFixupThreshold;
+    LLVM_DEBUG(Serial = true);
+    if (Serial) {
+      for (auto *B : Blocks)
+        if (auto Err = fixUpBlock(G, *B))
+          return Err;
+      return Error::success();
+    }
 
-          // If B is a block in a Standard or Finalize section then make sure
-          // that no edges point to symbols in NoAlloc sections.
-          assert((NoAllocSection || !E.getTarget().isDefined() ||
-                  E.getTarget().getBlock().getSection().getMemLifetime() !=
-                      orc::MemLifetime::NoAlloc) &&
-                 "Block in allocated section has edge pointing to no-alloc "
-                 "section");
+    // Report the error from the first failing block, as the serial path
+    // would.
+    std::mutex ErrMutex;
+    size_t FirstErrIdx = Blocks.size();
+    Error FirstErr = Error::success();
+    parallelFor(0, Blocks.size(), [&](size_t I) {
+      Error Err = fixUpBlock(G, *Blocks[I]);
+      if (!Err)
+        return;
+      std::lock_guard<std::mutex> Lock(ErrMutex);
+      if (I < FirstErrIdx) {
+        FirstErrIdx = I;
+        consumeError(std::move(FirstErr));
+        FirstErr = std::move(Err);
+      } else
+        consumeError(std::move(Err));
+    });
+    return FirstErr;
+  }
 
-          // Dispatch to LinkerImpl for fixup.
-          if (auto Err = impl().applyFixup(G, *B, E))
-            return Err;
-        }
-      }
+  Error fixUpBlock(LinkGraph &G, Block &B) const {
+    [[maybe_unused]] bool NoAllocSection =
+        B.getSection().getMemLifetime() == orc::MemLifetime::NoAlloc;
+
+    LLVM_DEBUG(dbgs() << "  " << B << ":\n");
+
+    // Copy Block data and apply fixups.
+    LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
+    assert((!B.isZeroFill() || all_of(B.edges(),
+                                      [](const Edge &E) {
+                                        return E.getKind() == Edge::KeepAlive;
+                                      })) &&
+           "Non-KeepAlive edges in zero-fill block?");
+
+    for (auto &E : B.edges()) {
+
+      // Skip non-relocation edges.
+      if (!E.isRelocation())
+        continue;
+
+      // If B is a block in a Standard or Finalize section then make sure
+      // that no edges point to symbols in NoAlloc sections.
+      assert((NoAllocSection || !E.getTarget().isDefined() ||
+              E.getTarget().getBlock().getSection().getMemLifetime() !=
+                  orc::MemLifetime::NoAlloc) &&
+             "Block in allocated section has edge pointing to no-alloc "
+             "section");
+
+      // Dispatch to LinkerImpl for fixup.
+      if (auto Err = impl().applyFixup(G, B, E))
+        return Err;
     }
 
     return Error::success();
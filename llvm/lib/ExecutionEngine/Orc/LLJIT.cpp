@@ -26,6 +26,7 @@
 #include "llvm/IR/Mangler.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/DynamicLibrary.h"
+#include "llvm/Support/TimeProfiler.h"
 
 #define DEBUG_TYPE "orc"
 
@@ -655,6 +656,7 @@ LLJIT::PlatformSupport::~PlatformSupport() = default;
 Error LLJITBuilderState::prepareForConstruction() {
 
   LLVM_DEBUG(dbgs() << "Preparing to create LLJIT instance...\n");
+  TimeTraceScope TimeScope("LLJITPrepareForConstruction");
 
   if (!JTMB) {
     LLVM_DEBUG({
@@ -981,11 +983,14 @@ LLJIT::LLJIT(LLJITBuilderState &S, Error &Err)
 
   assert(!(S.EPC && S.ES) && "EPC and ES should not both be set");
 
+  TimeTraceScope TimeScope("LLJITConstruct");
+
   if (S.EPC) {
     ES = std::make_unique<ExecutionSession>(std::move(S.EPC));
   } else if (S.ES)
     ES = std::move(S.ES);
   else {
+    TimeTraceScope PhaseScope("LLJITCreateExecutorProcessControl");
     if (auto EPC = SelfExecutorProcessControl::Create()) {
       ES = std::make_unique<ExecutionSession>(std::move(*EPC));
     } else {
@@ -1004,6 +1009,7 @@ LLJIT::LLJIT(LLJITBuilderState &S, Error &Err)
       std::make_unique<ObjectTransformLayer>(*ES, *ObjLinkingLayer);
 
   {
+    TimeTraceScope PhaseScope("LLJITCreateCompileFunction");
     auto CompileFunction = createCompileFunction(S, std::move(*S.JTMB));
     if (!CompileFunction) {
       Err = CompileFunction.takeError();
@@ -1020,6 +1026,7 @@ LLJIT::LLJIT(LLJITBuilderState &S, Error &Err)
     InitHelperTransformLayer->setCloneToNewContextOnEmit(true);
 
   if (S.SetupProcessSymbolsJITDylib) {
+    TimeTraceScope PhaseScope("LLJITSetUpProcessSymbols");
     if (auto ProcSymsJD = S.SetupProcessSymbolsJITDylib(*this)) {
       ProcessSymbols = ProcSymsJD->get();
     } else {
@@ -1038,14 +1045,17 @@ LLJIT::LLJIT(LLJITBuilderState &S, Error &Err)
   if (!S.SetUpPlatform)
     S.SetUpPlatform = setUpGenericLLVMIRPlatform;
 
-  if (auto PlatformJDOrErr = S.SetUpPlatform(*this)) {
-    Platform = PlatformJDOrErr->get();
-    if (Platform)
-      DefaultLinks.push_back(
-          {Platform, JITDylibLookupFlags::MatchExportedSymbolsOnly});
-  } else {
-    Err = PlatformJDOrErr.takeError();
-    return;
+  {
+    TimeTraceScope PhaseScope("LLJITSetUpPlatform");
+    if (auto PlatformJDOrErr = S.SetUpPlatform(*this)) {
+      Platform = PlatformJDOrErr->get();
+      if (Platform)
+        DefaultLinks.push_back(
+            {Platform, JITDylibLookupFlags::MatchExportedSymbolsOnly});
+    } else {
+      Err = PlatformJDOrErr.takeError();
+      return;
+    }
   }
 
   if (S.LinkProcessSymbolsByDefault)
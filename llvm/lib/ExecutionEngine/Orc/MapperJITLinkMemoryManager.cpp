@@ -12,6 +12,8 @@
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
 #include "llvm/Support/Process.h"
 
+#include <algorithm>
+
 using namespace llvm::jitlink;
 
 namespace llvm {
@@ -185,5 +187,20 @@ void MapperJITLinkMemoryManager::deallocate(
   });
 }
 
+MapperJITLinkMemoryManager::Stats MapperJITLinkMemoryManager::getStats() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+
+  Stats S;
+  for (auto &KV : UsedMemory)
+    S.AllocatedBytes += KV.second;
+  for (auto It = AvailableMemory.begin(); It != AvailableMemory.end(); ++It) {
+    size_t Size = It.stop() - It.start() + 1;
+    S.AvailableBytes += Size;
+    S.LargestAvailableRange = std::max(S.LargestAvailableRange, Size);
+    ++S.NumAvailableRanges;
+  }
+  return S;
+}
+
 } // end namespace orc
 } // end namespace llvm
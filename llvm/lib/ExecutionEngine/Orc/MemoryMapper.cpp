@@ -30,22 +30,25 @@ namespace orc {
 
 MemoryMapper::~MemoryMapper() {}
 
-InProcessMemoryMapper::InProcessMemoryMapper(size_t PageSize)
-    : PageSize(PageSize) {}
+InProcessMemoryMapper::InProcessMemoryMapper(size_t PageSize,
+                                             bool UseHugePages)
+    : PageSize(PageSize), UseHugePages(UseHugePages) {}
 
 Expected<std::unique_ptr<InProcessMemoryMapper>>
-InProcessMemoryMapper::Create() {
+InProcessMemoryMapper::Create(bool UseHugePages) {
   auto PageSize = sys::Process::getPageSize();
   if (!PageSize)
     return PageSize.takeError();
-  return std::make_unique<InProcessMemoryMapper>(*PageSize);
+  return std::make_unique<InProcessMemoryMapper>(*PageSize, UseHugePages);
 }
 
 void InProcessMemoryMapper::reserve(size_t NumBytes,
                                     OnReservedFunction OnReserved) {
   std::error_code EC;
-  auto MB = sys::Memory::allocateMappedMemory(
-      NumBytes, nullptr, sys::Memory::MF_READ | sys::Memory::MF_WRITE, EC);
+  unsigned Flags = sys::Memory::MF_READ | sys::Memory::MF_WRITE;
+  if (UseHugePages)
+    Flags |= sys::Memory::MF_HUGE_HINT;
+  auto MB = sys::Memory::allocateMappedMemory(NumBytes, nullptr, Flags, EC);
 
   if (EC)
     return OnReserved(errorCodeToError(EC));
@@ -0,0 +1,116 @@
+//===------ PersistentObjectCache.cpp - On-disk object cache for ORC ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/PersistentObjectCache.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/raw_ostream.h"
+
+#define DEBUG_TYPE "orc"
+
+namespace llvm {
+namespace orc {
+
+Expected<std::unique_ptr<PersistentObjectCache>>
+PersistentObjectCache::Create(StringRef CacheDir, std::string ExtraKey) {
+  if (std::error_code EC = sys::fs::create_directories(CacheDir))
+    return createFileError(CacheDir, EC);
+  return std::unique_ptr<PersistentObjectCache>(
+      new PersistentObjectCache(CacheDir.str(), std::move(ExtraKey)));
+}
+
+std::string PersistentObjectCache::computeKey(const Module &M) const {
+  SmallVector<char, 0> Bitcode;
+  {
+    raw_svector_ostream OS(Bitcode);
+    WriteBitcodeToFile(M, OS);
+  }
+
+  SHA1 Hasher;
+  Hasher.update(StringRef(Bitcode.data(), Bitcode.size()));
+  // Separate the two parts so that they can't run into each other.
+  Hasher.update(StringRef("\0", 1));
+  Hasher.update(ExtraKey);
+  return toHex(Hasher.result());
+}
+
+std::string PersistentObjectCache::getEntryPath(StringRef Key) const {
+  SmallString<128> Path(CacheDir);
+  sys::path::append(Path, Key + ".o");
+  return std::string(Path);
+}
+
+std::unique_ptr<MemoryBuffer>
+PersistentObjectCache::getObject(const Module *M) {
+  std::string Key = computeKey(*M);
+  auto Obj = MemoryBuffer::getFile(getEntryPath(Key), /*IsText=*/false,
+                                   /*RequiresNullTerminator=*/false);
+  if (Obj) {
+    ++NumHits;
+    LLVM_DEBUG(dbgs() << "Object cache hit for " << M->getModuleIdentifier()
+                      << ": " << Key << "\n");
+    return std::move(*Obj);
+  }
+
+  ++NumMisses;
+  LLVM_DEBUG(dbgs() << "Object cache miss for " << M->getModuleIdentifier()
+                    << ": " << Key << "\n");
+  std::lock_guard<std::mutex> Lock(PendingKeysMutex);
+  PendingKeys[M] = std::move(Key);
+  return nullptr;
+}
+
+void PersistentObjectCache::notifyObjectCompiled(const Module *M,
+                                                 MemoryBufferRef Obj) {
+  // Prefer the key computed during lookup: codegen may have changed the IR
+  // since then.
+  std::string Key;
+  {
+    std::lock_guard<std::mutex> Lock(PendingKeysMutex);
+    auto I = PendingKeys.find(M);
+    if (I != PendingKeys.end()) {
+      Key = std::move(I->second);
+      PendingKeys.erase(I);
+    }
+  }
+  if (Key.empty())
+    Key = computeKey(*M);
+
+  // The cache is best-effort: failing to store an entry only costs a later
+  // recompilation, so errors are dropped. Readers must never see a partial
+  // file, hence the write to a temporary and the rename.
+  std::string EntryPath = getEntryPath(Key);
+  SmallString<128> TempPath;
+  int FD;
+  if (sys::fs::createUniqueFile(EntryPath + ".tmp-%%%%%%", FD, TempPath))
+    return;
+
+  raw_fd_ostream OS(FD, /*shouldClose=*/true);
+  OS << Obj.getBuffer();
+  OS.close();
+  if (OS.has_error()) {
+    OS.clear_error();
+    sys::fs::remove(TempPath);
+    return;
+  }
+
+  if (sys::fs::rename(TempPath, EntryPath))
+    sys::fs::remove(TempPath);
+}
+
+} // end namespace orc
+} // end namespace llvm
@@ -29,37 +29,45 @@ SimpleRemoteEPC::loadDylib(const char *DylibPath) {
   return DylibMgr->open(DylibPath, 0);
 }
 
-/// Async helper to chain together calls to DylibMgr::lookupAsync to fulfill all
-/// all the requests.
-/// FIXME: The dylib manager should support multiple LookupRequests natively.
-static void
-lookupSymbolsAsyncHelper(EPCGenericDylibManager &DylibMgr,
-                         ArrayRef<SimpleRemoteEPC::LookupRequest> Request,
-                         std::vector<tpctypes::LookupResult> Result,
-                         SimpleRemoteEPC::SymbolLookupCompleteFn Complete) {
-  if (Request.empty())
-    return Complete(std::move(Result));
-
-  auto &Element = Request.front();
-  DylibMgr.lookupAsync(Element.Handle, Element.Symbols,
-                       [&DylibMgr, Request, Complete = std::move(Complete),
-                        Result = std::move(Result)](auto R) mutable {
-                         if (!R)
-                           return Complete(R.takeError());
-                         Result.push_back({});
-                         Result.back().reserve(R->size());
-                         for (auto Addr : *R)
-                           Result.back().push_back(Addr);
-
-                         lookupSymbolsAsyncHelper(
-                             DylibMgr, Request.drop_front(), std::move(Result),
-                             std::move(Complete));
-                       });
-}
-
 void SimpleRemoteEPC::lookupSymbolsAsync(ArrayRef<LookupRequest> Request,
                                          SymbolLookupCompleteFn Complete) {
-  lookupSymbolsAsyncHelper(*DylibMgr, Request, {}, std::move(Complete));
+  // FIXME: The dylib manager should support multiple LookupRequests natively.
+  if (Request.empty())
+    return Complete(std::vector<tpctypes::LookupResult>());
+
+  // Issue all of the lookups up front so that they're pipelined over the
+  // connection, rather than costing a round trip each.
+  struct LookupState {
+    std::mutex M;
+    std::vector<tpctypes::LookupResult> Result;
+    Error Err = Error::success();
+    size_t Remaining;
+    SymbolLookupCompleteFn Complete;
+  };
+  auto S = std::make_shared<LookupState>();
+  S->Result.resize(Request.size());
+  S->Remaining = Request.size();
+  S->Complete = std::move(Complete);
+
+  for (size_t I = 0; I != Request.size(); ++I)
+    DylibMgr->lookupAsync(
+        Request[I].Handle, Request[I].Symbols, [S, I](auto R) {
+          std::unique_lock<std::mutex> Lock(S->M);
+          if (!R) {
+            S->Err = joinErrors(std::move(S->Err), R.takeError());
+          } else {
+            S->Result[I].reserve(R->size());
+            for (auto Addr : *R)
+              S->Result[I].push_back(Addr);
+          }
+          if (--S->Remaining)
+            return;
+          Lock.unlock();
+
+          if (S->Err)
+            return S->Complete(std::move(S->Err));
+          S->Complete(std::move(S->Result));
+        });
 }
 
 Expected<int32_t> SimpleRemoteEPC::runAsMain(ExecutorAddr MainFnAddr,
@@ -16,6 +16,9 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Type.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/LineIterator.h"
+#include "llvm/Support/MemoryBuffer.h"
 
 namespace llvm {
 
@@ -138,5 +141,98 @@ void IRSpeculationLayer::emit(std::unique_ptr<MaterializationResponsibility> R,
   NextLayer.emit(std::move(R), std::move(TSM));
 }
 
+Expected<std::unique_ptr<SpeculationTraceRecorder>>
+SpeculationTraceRecorder::Create(ExecutionSession &ES, IRLayer &BaseLayer,
+                                 StringRef TracePath) {
+  std::error_code EC;
+  auto OS = std::make_unique<raw_fd_ostream>(TracePath, EC,
+                                             sys::fs::OF_Text);
+  if (EC)
+    return createFileError(TracePath, EC);
+  return std::unique_ptr<SpeculationTraceRecorder>(
+      new SpeculationTraceRecorder(ES, BaseLayer, std::move(OS)));
+}
+
+/// CompileOnDemandLayer materializes functions in an implementation dylib
+/// named after the user's dylib, which only exists once the CODLayer has seen
+/// the module. Returns the name of the user's dylib for \p JD.
+static StringRef getUserVisibleDylibName(ExecutionSession &ES,
+                                         JITDylib &JD) {
+  StringRef Name = JD.getName();
+  StringRef UserName = Name;
+  if (UserName.consume_back(".impl") && ES.getJITDylibByName(UserName))
+    return UserName;
+  return Name;
+}
+
+void SpeculationTraceRecorder::emit(
+    std::unique_ptr<MaterializationResponsibility> R, ThreadSafeModule TSM) {
+  // Sort the names so that the trace doesn't depend on hash table order.
+  SmallVector<StringRef, 4> Names;
+  for (auto &KV : R->getSymbols())
+    if (KV.second.isCallable())
+      Names.push_back(*KV.first);
+  llvm::sort(Names);
+
+  if (!Names.empty()) {
+    StringRef JDName =
+        getUserVisibleDylibName(getExecutionSession(), R->getTargetJITDylib());
+    std::lock_guard<std::mutex> Lock(TraceMutex);
+    for (StringRef Name : Names)
+      *OS << JDName << '\t' << Name << '\n';
+    // Keep the trace useful if the process doesn't shut down cleanly.
+    OS->flush();
+  }
+
+  NextLayer.emit(std::move(R), std::move(TSM));
+}
+
+Error replaySpeculationTrace(ExecutionSession &ES, StringRef TracePath) {
+  auto Trace = MemoryBuffer::getFile(TracePath, /*IsText=*/true);
+  if (!Trace)
+    return createFileError(TracePath, Trace.getError());
+
+  for (line_iterator I(**Trace, /*SkipBlanks=*/true); !I.is_at_eof(); ++I) {
+    auto [JDName, Name] = I->split('\t');
+    auto *JD = ES.getJITDylibByName(JDName);
+    if (!JD || Name.empty())
+      continue;
+
+    // Looking the symbol up in the user's dylib hands the module to the
+    // CompileOnDemandLayer, if any, which only installs a lazy stub. Follow up
+    // with a lookup in the implementation dylib to compile the function.
+    auto Sym = ES.intern(Name);
+    ES.lookup(
+        LookupKind::Static,
+        makeJITDylibSearchOrder(JD, JITDylibLookupFlags::MatchAllSymbols),
+        SymbolLookupSet(Sym, SymbolLookupFlags::WeaklyReferencedSymbol),
+        SymbolState::Ready,
+        [&ES, ImplName = (JDName + ".impl").str(),
+         Sym](Expected<SymbolMap> Result) {
+          if (!Result) {
+            ES.reportError(Result.takeError());
+            return;
+          }
+          auto *ImplJD = ES.getJITDylibByName(ImplName);
+          if (!ImplJD || Result->empty())
+            return;
+          ES.lookup(
+              LookupKind::Static,
+              makeJITDylibSearchOrder(ImplJD,
+                                      JITDylibLookupFlags::MatchAllSymbols),
+              SymbolLookupSet(Sym, SymbolLookupFlags::WeaklyReferencedSymbol),
+              SymbolState::Ready,
+              [&ES](Expected<SymbolMap> Result) {
+                if (!Result)
+                  ES.reportError(Result.takeError());
+              },
+              NoDependenciesToRegister);
+        },
+        NoDependenciesToRegister);
+  }
+
+  return Error::success();
+}
+
 } // namespace orc
 } // namespace llvm
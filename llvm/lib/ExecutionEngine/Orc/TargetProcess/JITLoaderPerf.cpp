@@ -55,10 +55,18 @@ struct PerfState {
   // output data stream
   std::unique_ptr<raw_fd_ostream> Dumpstream;
 
+  // timestamp of the last flush of Dumpstream
+  uint64_t LastFlushNs = 0;
+
   // perf mmap marker
   void *MarkerAddr = NULL;
 };
 
+// Records are buffered and written out at most this often, rather than once
+// per batch, so that registering many small graphs doesn't cost a write each.
+static constexpr uint64_t FlushIntervalNs = 100 * 1000 * 1000;
+static constexpr size_t DumpBufferSize = 1 << 20;
+
 // prevent concurrent dumps from messing up the output file
 static std::mutex Mutex;
 static std::optional<PerfState> State;
@@ -197,7 +205,11 @@ static Error registerJITLoaderPerfImpl(const PerfJITRecordBatch &Batch) {
   for (const auto &CodeLoad : Batch.CodeLoadRecords)
     writeCodeRecord(CodeLoad);
 
-  State->Dumpstream->flush();
+  uint64_t Now = perf_get_timestamp();
+  if (Now - State->LastFlushNs >= FlushIntervalNs) {
+    State->Dumpstream->flush();
+    State->LastFlushNs = Now;
+  }
 
   return Error::success();
 }
@@ -357,6 +369,7 @@ static Error registerJITLoaderPerfStartImpl() {
 
   Tentative.Dumpstream =
       std::make_unique<raw_fd_ostream>(Tentative.DumpFd, true);
+  Tentative.Dumpstream->SetBufferSize(DumpBufferSize);
 
   auto Header = FillMachine(Tentative);
   if (!Header)
@@ -368,6 +381,8 @@ static Error registerJITLoaderPerfStartImpl() {
 
   Tentative.Dumpstream->write(reinterpret_cast<const char *>(&Header.get()),
                               sizeof(*Header));
+  Tentative.Dumpstream->flush();
+  Tentative.LastFlushNs = perf_get_timestamp();
 
   // Everything initialized, can do profiling now.
   if (Tentative.Dumpstream->has_error())
@@ -389,6 +404,7 @@ static Error registerJITLoaderPerfEndImpl() {
   Close.Timestamp = perf_get_timestamp();
   State->Dumpstream->write(reinterpret_cast<const char *>(&Close),
                            sizeof(Close));
+  State->Dumpstream->flush();
   if (State->MarkerAddr)
     CloseMarker(*State);
 
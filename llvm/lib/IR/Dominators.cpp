@@ -14,6 +14,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/IR/Dominators.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/IR/CFG.h"
@@ -37,6 +38,11 @@ class Value;
 } // namespace llvm
 using namespace llvm;
 
+#define DEBUG_TYPE "domtree"
+
+STATISTIC(NumDomTreeComputations,
+          "Number of dominator trees computed from scratch by a pass manager");
+
 bool llvm::VerifyDomInfo = false;
 static cl::opt<bool, true>
     VerifyDomInfoX("verify-dom-info", cl::location(VerifyDomInfo), cl::Hidden,
@@ -370,6 +376,7 @@ Instruction *DominatorTree::findNearestCommonDominator(Instruction *I1,
 
 DominatorTree DominatorTreeAnalysis::run(Function &F,
                                          FunctionAnalysisManager &) {
+  ++NumDomTreeComputations;
   DominatorTree DT;
   DT.recalculate(F);
   return DT;
@@ -414,6 +421,7 @@ INITIALIZE_PASS(DominatorTreeWrapperPass, "domtree",
                 "Dominator Tree Construction", true, true)
 
 bool DominatorTreeWrapperPass::runOnFunction(Function &F) {
+  ++NumDomTreeComputations;
   DT.recalculate(F);
   return false;
 }
@@ -7,10 +7,18 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/IR/User.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/IR/Constant.h"
 #include "llvm/IR/GlobalValue.h"
 #include "llvm/IR/IntrinsicInst.h"
 
+#define DEBUG_TYPE "ir"
+STATISTIC(NumFixedOperandUsers, "Number of users with co-allocated operands");
+STATISTIC(NumHungOffUsers, "Number of users allocated with hung-off operands");
+STATISTIC(NumHungOffUseAllocs, "Number of hung-off operand list allocations");
+STATISTIC(NumHungOffUseGrows, "Number of hung-off operand list reallocations");
+STATISTIC(NumUserBytes, "Number of bytes allocated for users and their uses");
+
 namespace llvm {
 class BasicBlock;
 
@@ -57,6 +65,8 @@ void User::allocHungoffUses(unsigned N, bool IsPhi) {
   size_t size = N * sizeof(Use);
   if (IsPhi)
     size += N * sizeof(BasicBlock *);
+  ++NumHungOffUseAllocs;
+  NumUserBytes += size;
   Use *Begin = static_cast<Use*>(::operator new(size));
   Use *End = Begin + N;
   setOperandList(Begin);
@@ -73,6 +83,7 @@ void User::growHungoffUses(unsigned NewNumUses, bool IsPhi) {
   // space to copy the old uses in to the new space.
   assert(NewNumUses > OldNumUses && "realloc must grow num uses");
 
+  ++NumHungOffUseGrows;
   Use *OldOps = getOperandList();
   allocHungoffUses(NewNumUses, IsPhi);
   Use *NewOps = getOperandList();
@@ -131,8 +142,10 @@ void *User::allocateFixedOperandUser(size_t Size, unsigned Us,
   assert(DescBytesToAllocate % sizeof(void *) == 0 &&
          "We need this to satisfy alignment constraints for Uses");
 
-  uint8_t *Storage = static_cast<uint8_t *>(
-      ::operator new(Size + sizeof(Use) * Us + DescBytesToAllocate));
+  size_t Bytes = Size + sizeof(Use) * Us + DescBytesToAllocate;
+  ++NumFixedOperandUsers;
+  NumUserBytes += Bytes;
+  uint8_t *Storage = static_cast<uint8_t *>(::operator new(Bytes));
   Use *Start = reinterpret_cast<Use *>(Storage + DescBytesToAllocate);
   Use *End = Start + Us;
   User *Obj = reinterpret_cast<User*>(End);
@@ -160,6 +173,8 @@ void *User::operator new(size_t Size, unsigned Us, unsigned DescBytes) {
 
 void *User::operator new(size_t Size) {
   // Allocate space for a single Use*
+  ++NumHungOffUsers;
+  NumUserBytes += Size + sizeof(Use *);
   void *Storage = ::operator new(Size + sizeof(Use *));
   Use **HungOffOperandList = static_cast<Use **>(Storage);
   User *Obj = reinterpret_cast<User *>(HungOffOperandList + 1);
@@ -56,6 +56,7 @@
 #include "llvm/Transforms/Utils/FunctionImportUtils.h"
 #include "llvm/Transforms/Utils/SplitModule.h"
 
+#include <condition_variable>
 #include <optional>
 #include <set>
 
@@ -1436,8 +1437,45 @@ class InProcessThinBackend : public ThinBackendProc {
   std::optional<Error> Err;
   std::mutex ErrMu;
 
+  // Estimated memory of the running backends, for Conf.ThinLTOMemoryBudget.
+  uint64_t MemoryInUse = 0;
+  std::mutex MemoryMu;
+  std::condition_variable MemoryCV;
+
   bool ShouldEmitIndexFiles;
 
+  // Estimate the peak memory of a backend from what the summary index tells
+  // about it: the size of the module's bitcode and the number of globals it
+  // defines or imports. The factors are rough; the estimate only has to be
+  // good enough to keep several huge backends from running at once.
+  static uint64_t
+  estimateBackendMemory(const BitcodeModule &BM,
+                        const GVSummaryMapTy &DefinedGlobals,
+                        const FunctionImporter::ImportMapTy &ImportList) {
+    uint64_t NumImports = 0;
+    for (const auto &Entry : ImportList)
+      NumImports += Entry.second.size();
+    return BM.getBuffer().size() * 16 +
+           (DefinedGlobals.size() + NumImports) * 4096;
+  }
+
+  void acquireMemory(uint64_t Bytes) {
+    std::unique_lock<std::mutex> L(MemoryMu);
+    MemoryCV.wait(L, [&] {
+      return MemoryInUse == 0 ||
+             MemoryInUse + Bytes <= Conf.ThinLTOMemoryBudget;
+    });
+    MemoryInUse += Bytes;
+  }
+
+  void releaseMemory(uint64_t Bytes) {
+    {
+      std::lock_guard<std::mutex> L(MemoryMu);
+      MemoryInUse -= Bytes;
+    }
+    MemoryCV.notify_all();
+  }
+
 public:
   InProcessThinBackend(
       const Config &Conf, ModuleSummaryIndex &CombinedIndex,
@@ -1514,6 +1552,8 @@ public:
     assert(ModuleToDefinedGVSummaries.count(ModulePath));
     const GVSummaryMapTy &DefinedGlobals =
         ModuleToDefinedGVSummaries.find(ModulePath)->second;
+    uint64_t EstimatedMemory =
+        estimateBackendMemory(BM, DefinedGlobals, ImportList);
     BackendThreadPool.async(
         [=](BitcodeModule BM, ModuleSummaryIndex &CombinedIndex,
             const FunctionImporter::ImportMapTy &ImportList,
@@ -1525,9 +1565,23 @@ public:
           if (LLVM_ENABLE_THREADS && Conf.TimeTraceEnabled)
             timeTraceProfilerInitialize(Conf.TimeTraceGranularity,
                                         "thin backend");
-          Error E = runThinLTOBackendThread(
-              AddStream, Cache, Task, BM, CombinedIndex, ImportList, ExportList,
-              ResolvedODR, DefinedGlobals, ModuleMap);
+          if (Conf.ThinLTOMemoryBudget) {
+            TimeTraceScope TimeScope("Wait for memory budget",
+                                     BM.getModuleIdentifier());
+            acquireMemory(EstimatedMemory);
+          }
+          Error E = [&] {
+            TimeTraceScope TimeScope("Thin backend", [&] {
+              return (BM.getModuleIdentifier() + " (estimated " +
+                      Twine(EstimatedMemory >> 20) + " MiB)")
+                  .str();
+            });
+            return runThinLTOBackendThread(
+                AddStream, Cache, Task, BM, CombinedIndex, ImportList,
+                ExportList, ResolvedODR, DefinedGlobals, ModuleMap);
+          }();
+          if (Conf.ThinLTOMemoryBudget)
+            releaseMemory(EstimatedMemory);
           if (E) {
             std::unique_lock<std::mutex> L(ErrMu);
             if (Err)
@@ -1800,8 +1854,9 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
   GlobalResolutions.reset();
 
   if (Conf.OptLevel > 0)
-    ComputeCrossModuleImport(ThinLTO.CombinedIndex, ModuleToDefinedGVSummaries,
-                             isPrevailing, ImportLists, ExportLists);
+    ComputeCrossModuleImportCached(
+        Conf.ThinLTOImportCacheDir, ThinLTO.CombinedIndex,
+        ModuleToDefinedGVSummaries, isPrevailing, ImportLists, ExportLists);
 
   // Any functions referenced by the jump table in the regular LTO object must
   // be exported.
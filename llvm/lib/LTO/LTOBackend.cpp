@@ -233,7 +233,8 @@ createTargetMachine(const Config &Conf, const Target *TheTarget, Module &M) {
 static void runNewPMPasses(const Config &Conf, Module &Mod, TargetMachine *TM,
                            unsigned OptLevel, bool IsThinLTO,
                            ModuleSummaryIndex *ExportSummary,
-                           const ModuleSummaryIndex *ImportSummary) {
+                           const ModuleSummaryIndex *ImportSummary,
+                           StringRef OptPipeline) {
   auto FS = vfs::getRealFileSystem();
   std::optional<PGOOptions> PGOOpt;
   if (!Conf.SampleProfile.empty())
@@ -321,10 +322,10 @@ static void runNewPMPasses(const Config &Conf, Module &Mod, TargetMachine *TM,
   }
 
   // Parse a custom pipeline if asked to.
-  if (!Conf.OptPipeline.empty()) {
-    if (auto Err = PB.parsePassPipeline(MPM, Conf.OptPipeline)) {
+  if (!OptPipeline.empty()) {
+    if (auto Err = PB.parsePassPipeline(MPM, OptPipeline)) {
       report_fatal_error(Twine("unable to parse pass pipeline description '") +
-                         Conf.OptPipeline + "': " + toString(std::move(Err)));
+                         OptPipeline + "': " + toString(std::move(Err)));
     }
   } else if (IsThinLTO) {
     MPM.addPass(PB.buildThinLTODefaultPipeline(OL, ImportSummary));
@@ -361,7 +362,7 @@ bool lto::opt(const Config &Conf, TargetMachine *TM, unsigned Task, Module &Mod,
   }
   // FIXME: Plumb the combined index into the new pass manager.
   runNewPMPasses(Conf, Mod, TM, Conf.OptLevel, IsThinLTO, ExportSummary,
-                 ImportSummary);
+                 ImportSummary, Conf.OptPipeline);
   return !Conf.PostOptModuleHook || Conf.PostOptModuleHook(Task, Mod);
 }
 
@@ -457,6 +458,12 @@ static void splitCodeGen(const Config &C, TargetMachine *TM,
               std::unique_ptr<TargetMachine> TM =
                   createTargetMachine(C, T, *MPartInCtx);
 
+              if (!C.PartitionOptPipeline.empty())
+                runNewPMPasses(C, *MPartInCtx, TM.get(), C.OptLevel,
+                               /*IsThinLTO=*/false, /*ExportSummary=*/nullptr,
+                               /*ImportSummary=*/nullptr,
+                               C.PartitionOptPipeline);
+
               codegen(C, TM.get(), AddStream, ThreadId, *MPartInCtx,
                       CombinedIndex);
             },
@@ -48,6 +48,7 @@
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/SMLoc.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Host.h"
 #include <algorithm>
@@ -140,6 +141,10 @@ struct ELFWriter {
   std::vector<const MCSectionELF *> SectionTable;
   unsigned addToSectionTable(const MCSectionELF *Sec);
 
+  // Compresses large debug sections in parallel. Created for the first such
+  // section and shared by the rest of the object file.
+  std::unique_ptr<DefaultThreadPool> CompressionPool;
+
   // TargetObjectWriter wrappers.
   bool is64Bit() const;
 
@@ -857,6 +862,9 @@ bool ELFWriter::maybeWriteCompression(
   return true;
 }
 
+// Debug sections larger than this are compressed as several zstd frames.
+static constexpr size_t ZstdShardSize = 1 << 20;
+
 void ELFWriter::writeSectionData(const MCAssembler &Asm, MCSection &Sec) {
   MCSectionELF &Section = static_cast<MCSectionELF &>(Sec);
   StringRef SectionName = Section.getName();
@@ -889,8 +897,32 @@ void ELFWriter::writeSectionData(const MCAssembler &Asm, MCSection &Sec) {
     ChType = ELF::ELFCOMPRESS_ZSTD;
     break;
   }
-  compression::compress(compression::Params(CompressionType), Uncompressed,
-                        Compressed);
+  unsigned Threads = Ctx.getTargetOptions()->CompressDebugSectionsThreads;
+  if (CompressionType == DebugCompressionType::Zstd && Threads > 1 &&
+      Uncompressed.size() > ZstdShardSize) {
+    // Compress large sections as a sequence of independent zstd frames in
+    // parallel, as lld does. Decompressors handle concatenated frames, and
+    // the fixed shard size keeps the output independent of the number of
+    // threads.
+    size_t NumShards = divideCeil(Uncompressed.size(), ZstdShardSize);
+    SmallVector<SmallVector<uint8_t, 0>, 0> ShardsOut(NumShards);
+    if (!CompressionPool)
+      CompressionPool =
+          std::make_unique<DefaultThreadPool>(hardware_concurrency(Threads));
+    for (size_t I = 0; I != NumShards; ++I)
+      CompressionPool->async([&, I] {
+        compression::compress(
+            compression::Params(CompressionType),
+            Uncompressed.slice(I * ZstdShardSize).take_front(ZstdShardSize),
+            ShardsOut[I]);
+      });
+    CompressionPool->wait();
+    for (const SmallVector<uint8_t, 0> &Out : ShardsOut)
+      Compressed.append(Out.begin(), Out.end());
+  } else {
+    compression::compress(compression::Params(CompressionType), Uncompressed,
+                          Compressed);
+  }
   if (!maybeWriteCompression(ChType, UncompressedData.size(), Compressed,
                              Sec.getAlign())) {
     W.OS << UncompressedData;
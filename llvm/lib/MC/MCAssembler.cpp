@@ -68,6 +68,8 @@ STATISTIC(EmittedOrgFragments, "Number of emitted assembler fragments - org");
 STATISTIC(evaluateFixup, "Number of evaluated fixups");
 STATISTIC(ObjectBytes, "Number of emitted object file bytes");
 STATISTIC(RelaxationSteps, "Number of assembler layout and relaxation steps");
+STATISTIC(SectionRelaxationSteps,
+          "Number of single-section relaxation steps");
 STATISTIC(RelaxedInstructions, "Number of relaxed instructions");
 
 } // end namespace stats
@@ -1371,14 +1373,35 @@ bool MCAssembler::relaxFragment(MCFragment &F) {
   }
 }
 
+bool MCAssembler::layoutSection(MCSection &Sec) {
+  ++stats::SectionRelaxationSteps;
+
+  bool Changed = false;
+  for (MCFragment &Frag : Sec)
+    if (relaxFragment(Frag))
+      Changed = true;
+  // Later fragments in this section may have moved. Recompute the offsets
+  // before the next pass over it.
+  if (Changed)
+    Sec.setHasLayout(false);
+  return Changed;
+}
+
 bool MCAssembler::layoutOnce() {
   ++stats::RelaxationSteps;
 
+  // Most relaxations only depend on offsets within their own section, so
+  // bring each section to a fixed point before moving on. This keeps a
+  // late-converging section from forcing extra passes over every other
+  // section; layout() still re-runs everything if anything changed.
   bool Changed = false;
   for (MCSection &Sec : *this)
-    for (MCFragment &Frag : Sec)
-      if (relaxFragment(Frag))
-        Changed = true;
+    while (layoutSection(Sec)) {
+      Changed = true;
+      // Let layout() see the error rather than iterating on bad input.
+      if (getContext().hadError())
+        return true;
+    }
   return Changed;
 }
 
@@ -31,6 +31,7 @@
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -39,9 +40,11 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 using namespace llvm;
 using namespace llvm::ELF;
@@ -220,6 +223,11 @@ Error Object::compressOrDecompressSections(const CommonConfig &Config) {
   // because it would mutate the sections array.
   SmallVector<std::pair<SectionBase *, std::function<SectionBase *()>>, 0>
       ToReplace;
+  // Compression is independent per section and dominates the run time for
+  // large debug sections, so it is done up front in parallel.
+  SmallVector<std::pair<const SectionBase *, DebugCompressionType>, 0>
+      ToCompress;
+  std::vector<std::optional<CompressedSection>> Compressed;
   for (SectionBase &Sec : sections()) {
     std::optional<DebugCompressionType> CType;
     for (auto &[Matcher, T] : Config.compressSections)
@@ -247,13 +255,19 @@ Error Object::compressOrDecompressSections(const CommonConfig &Config) {
         ToReplace.emplace_back(
             &Sec, [=] { return &addSection<DecompressedSection>(*CS); });
     } else if (*CType != DebugCompressionType::None) {
-      ToReplace.emplace_back(&Sec, [=, S = &Sec] {
-        return &addSection<CompressedSection>(
-            CompressedSection(*S, *CType, Is64Bits));
+      ToReplace.emplace_back(&Sec, [&, I = ToCompress.size()] {
+        return &addSection<CompressedSection>(std::move(*Compressed[I]));
       });
+      ToCompress.emplace_back(&Sec, *CType);
     }
   }
 
+  Compressed.resize(ToCompress.size());
+  parallelFor(0, ToCompress.size(), [&](size_t I) {
+    Compressed[I].emplace(*ToCompress[I].first, ToCompress[I].second,
+                          Is64Bits);
+  });
+
   DenseMap<SectionBase *, SectionBase *> FromTo;
   for (auto [S, Func] : ToReplace)
     FromTo[S] = Func();
@@ -31,12 +31,14 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <cerrno>
 #include <map>
+#include <mutex>
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
 #include <unistd.h>
@@ -818,13 +820,45 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
   std::vector<std::unique_ptr<SymbolicFile>> SymFiles;
 
   if (NeedSymbols != SymtabWritingMode::NoSymtab || isAIXBigArchive(Kind)) {
-    for (const NewArchiveMember &M : NewMembers) {
+    SymFiles.resize(NewMembers.size());
+
+    // Report the error for the first failing member, as a serial scan would.
+    std::mutex ErrMutex;
+    size_t ErrIndex = NewMembers.size();
+    Error Err = Error::success();
+    auto ReadMember = [&](size_t I) {
       Expected<std::unique_ptr<SymbolicFile>> SymFileOrErr =
-          getSymbolicFile(M.Buf->getMemBufferRef(), Context);
-      if (!SymFileOrErr)
-        return createFileError(M.MemberName, SymFileOrErr.takeError());
-      SymFiles.push_back(std::move(*SymFileOrErr));
-    }
+          getSymbolicFile(NewMembers[I].Buf->getMemBufferRef(), Context);
+      if (SymFileOrErr) {
+        SymFiles[I] = std::move(*SymFileOrErr);
+        return;
+      }
+      std::lock_guard<std::mutex> Lock(ErrMutex);
+      if (I < ErrIndex) {
+        consumeError(std::move(Err));
+        Err = SymFileOrErr.takeError();
+        ErrIndex = I;
+      } else {
+        consumeError(SymFileOrErr.takeError());
+      }
+    };
+    auto IsBitcode = [&](size_t I) {
+      return identify_magic(NewMembers[I].Buf->getBuffer()) ==
+             file_magic::bitcode;
+    };
+
+    // Bitcode members are read into the shared LLVMContext, which is not
+    // thread-safe, so only the other members are read in parallel.
+    parallelFor(0, NewMembers.size(), [&](size_t I) {
+      if (!IsBitcode(I))
+        ReadMember(I);
+    });
+    for (size_t I = 0; I < ErrIndex; ++I)
+      if (IsBitcode(I))
+        ReadMember(I);
+
+    if (Err)
+      return createFileError(NewMembers[ErrIndex].MemberName, std::move(Err));
   }
 
   if (SymMap) {
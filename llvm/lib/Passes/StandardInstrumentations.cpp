@@ -23,6 +23,8 @@
 #include "llvm/CodeGen/MachineFunction.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
 #include "llvm/IR/Constants.h"
+#include "llvm/IR/DiagnosticHandler.h"
+#include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/PassInstrumentation.h"
@@ -116,6 +118,11 @@ static cl::opt<std::string> OptBisectPrintIRPath(
     "opt-bisect-print-ir-path",
     cl::desc("Print IR to path when opt-bisect-limit is reached"), cl::Hidden);
 
+static cl::opt<unsigned> OptFunctionSizeBudget(
+    "opt-function-size-budget", cl::init(0), cl::Hidden,
+    cl::desc("Skip optional function and loop passes on functions with more "
+             "than this many instructions (0 means no limit)"));
+
 static cl::opt<bool> PrintPassNumbers(
     "print-pass-numbers", cl::init(false), cl::Hidden,
     cl::desc("Print pass names and their ordinals"));
@@ -1053,6 +1060,103 @@ bool OptNoneInstrumentation::shouldRun(StringRef PassID, Any IR) {
   return ShouldRun;
 }
 
+static const Function *getFunctionOfIR(Any IR) {
+  if (const auto *F = unwrapIR<Function>(IR))
+    return F;
+  if (const auto *L = unwrapIR<Loop>(IR))
+    return L->getHeader()->getParent();
+  return nullptr;
+}
+
+static bool isSizeDeltaRemarkEnabled(const Function &F) {
+  const LLVMContext &Ctx = F.getContext();
+  return Ctx.getLLVMRemarkStreamer() ||
+         Ctx.getDiagHandlerPtr()->isAnalysisRemarkEnabled("size-budget");
+}
+
+void FunctionSizeBudgetInstrumentation::registerCallbacks(
+    PassInstrumentationCallbacks &PIC) {
+  if (!OptFunctionSizeBudget)
+    return;
+  PIC.registerShouldRunOptionalPassCallback(
+      [this](StringRef P, Any IR) { return this->shouldRun(P, IR); });
+  PIC.registerBeforeNonSkippedPassCallback(
+      [this](StringRef, Any IR) { this->runBeforePass(IR); });
+  PIC.registerAfterPassCallback(
+      [this](StringRef P, Any IR, const PreservedAnalyses &PA) {
+        this->runAfterPass(P, IR, PA);
+      });
+  // The IR unit is gone, and so may be the functions it covered.
+  PIC.registerAfterPassInvalidatedCallback(
+      [this](StringRef, const PreservedAnalyses &) { InstCounts.clear(); });
+}
+
+unsigned
+FunctionSizeBudgetInstrumentation::getInstructionCount(const Function &F) {
+  auto [It, Inserted] = InstCounts.try_emplace(&F, 0);
+  if (Inserted)
+    It->second = F.getInstructionCount();
+  return It->second;
+}
+
+bool FunctionSizeBudgetInstrumentation::shouldRun(StringRef PassID, Any IR) {
+  const Function *F = getFunctionOfIR(IR);
+  if (!F || isIgnored(PassID))
+    return true;
+  unsigned NumInsts = getInstructionCount(*F);
+  if (NumInsts <= OptFunctionSizeBudget)
+    return true;
+
+  using ore::NV;
+  F->getContext().diagnose(
+      OptimizationRemarkMissed("size-budget", "PassSkipped", F)
+      << "skipped " << NV("Pass", PassID) << " on function with "
+      << NV("NumInstructions", NumInsts) << " instructions (budget "
+      << NV("Budget", OptFunctionSizeBudget.getValue()) << ")");
+  return false;
+}
+
+void FunctionSizeBudgetInstrumentation::runBeforePass(Any IR) {
+  // Required passes don't ask shouldRun, so count here when a delta is going
+  // to be reported.
+  const Function *F = getFunctionOfIR(IR);
+  if (F && isSizeDeltaRemarkEnabled(*F))
+    getInstructionCount(*F);
+}
+
+void FunctionSizeBudgetInstrumentation::runAfterPass(
+    StringRef PassID, Any IR, const PreservedAnalyses &PA) {
+  // Pass managers and adaptors changed nothing their nested passes did not
+  // already report.
+  if (isIgnored(PassID) || PA.areAllPreserved())
+    return;
+  const Function *F = getFunctionOfIR(IR);
+  if (!F) {
+    // Module and CGSCC passes may change or delete any function.
+    InstCounts.clear();
+    return;
+  }
+
+  auto It = InstCounts.find(F);
+  if (It == InstCounts.end())
+    return;
+  unsigned Before = It->second;
+  InstCounts.erase(It);
+  if (!isSizeDeltaRemarkEnabled(*F))
+    return;
+  unsigned After = getInstructionCount(*F);
+  if (After == Before)
+    return;
+
+  using ore::NV;
+  F->getContext().diagnose(
+      OptimizationRemarkAnalysis("size-budget", "InstructionCountDelta", F)
+      << NV("Pass", PassID) << " changed the function from "
+      << NV("Before", Before) << " to " << NV("After", After)
+      << " instructions (delta " << NV("Delta", int64_t(After) - Before)
+      << ")");
+}
+
 bool OptPassGateInstrumentation::shouldRun(StringRef PassName, Any IR) {
   if (isIgnored(PassName))
     return true;
@@ -2511,6 +2615,7 @@ void StandardInstrumentations::registerCallbacks(
   TimePasses.registerCallbacks(PIC);
   OptNone.registerCallbacks(PIC);
   OptPassGate.registerCallbacks(PIC);
+  FunctionSizeBudget.registerCallbacks(PIC);
   PrintChangedIR.registerCallbacks(PIC);
   PseudoProbeVerification.registerCallbacks(PIC);
   if (VerifyEach)
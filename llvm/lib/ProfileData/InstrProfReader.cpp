@@ -1418,28 +1418,23 @@ Error IndexedInstrProfReader::readHeader() {
     // Expect at least two 64 bit fields: NumTraces, and TraceStreamSize
     if (Ptr + 2 * sizeof(uint64_t) > PtrEnd)
       return error(instrprof_error::truncated);
-    const uint64_t NumTraces =
+    NumTemporalProfTraces =
         support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
     TemporalProfTraceStreamSize =
         support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
-    for (unsigned i = 0; i < NumTraces; i++) {
+    TemporalProfTracesPtr = Ptr;
+    // Only check the bounds here; the traces are decoded on demand.
+    for (uint64_t I = 0; I < NumTemporalProfTraces; I++) {
       // Expect at least two 64 bit fields: Weight and NumFunctions
       if (Ptr + 2 * sizeof(uint64_t) > PtrEnd)
         return error(instrprof_error::truncated);
-      TemporalProfTraceTy Trace;
-      Trace.Weight =
-          support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
+      Ptr += sizeof(uint64_t);
       const uint64_t NumFunctions =
           support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
       // Expect at least NumFunctions 64 bit fields
       if (Ptr + NumFunctions * sizeof(uint64_t) > PtrEnd)
         return error(instrprof_error::truncated);
-      for (unsigned j = 0; j < NumFunctions; j++) {
-        const uint64_t NameRef =
-            support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
-        Trace.FunctionNameRefs.push_back(NameRef);
-      }
-      TemporalProfTraces.push_back(std::move(Trace));
+      Ptr += NumFunctions * sizeof(uint64_t);
     }
   }
 
@@ -1458,6 +1453,26 @@ Error IndexedInstrProfReader::readHeader() {
   return success();
 }
 
+SmallVector<TemporalProfTraceTy> &
+IndexedInstrProfReader::getTemporalProfTraces(std::optional<uint64_t> Weight) {
+  // The bounds were checked in readHeader.
+  const unsigned char *Ptr = TemporalProfTracesPtr;
+  for (; NumTemporalProfTraces; --NumTemporalProfTraces) {
+    TemporalProfTraceTy Trace;
+    Trace.Weight =
+        support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
+    const uint64_t NumFunctions =
+        support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr);
+    Trace.FunctionNameRefs.reserve(NumFunctions);
+    for (uint64_t J = 0; J < NumFunctions; J++)
+      Trace.FunctionNameRefs.push_back(
+          support::endian::readNext<uint64_t, llvm::endianness::little>(Ptr));
+    TemporalProfTraces.push_back(std::move(Trace));
+  }
+  TemporalProfTracesPtr = Ptr;
+  return TemporalProfTraces;
+}
+
 InstrProfSymtab &IndexedInstrProfReader::getSymtab() {
   if (Symtab)
     return *Symtab;
@@ -1164,6 +1164,10 @@ std::error_code SampleProfileReaderExtBinaryBase::readCSNameTableSec() {
     auto ContextSize = readNumber<uint32_t>();
     if (std::error_code EC = ContextSize.getError())
       return EC;
+    // Each frame takes at least three bytes, which bounds the reservation
+    // for corrupt sizes.
+    CSNameTable.back().reserve(
+        std::min<size_t>(*ContextSize, (End - Data) / 3));
     for (uint32_t J = 0; J < *ContextSize; ++J) {
       auto FName(readStringFromTable());
       if (std::error_code EC = FName.getError())
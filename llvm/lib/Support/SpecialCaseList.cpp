@@ -14,6 +14,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/SpecialCaseList.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/LineIterator.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/VirtualFileSystem.h"
@@ -53,6 +54,24 @@ Error SpecialCaseList::Matcher::insert(StringRef Pattern, unsigned LineNumber,
     return Error::success();
   }
 
+  // Index the globs that need no GlobPattern so that match() doesn't have to
+  // try them one by one.
+  constexpr StringLiteral MetaChars = "*?[]{}\\";
+  size_t FirstMeta = Pattern.find_first_of(MetaChars);
+  if (FirstMeta == StringRef::npos) {
+    Literals.try_emplace(Pattern, LineNumber);
+    return Error::success();
+  }
+  if (FirstMeta == Pattern.size() - 1 && Pattern.back() == '*') {
+    StringRef Prefix = Pattern.drop_back();
+    if (Prefixes.try_emplace(Prefix, LineNumber).second) {
+      auto I = llvm::lower_bound(PrefixLengths, Prefix.size());
+      if (I == PrefixLengths.end() || *I != Prefix.size())
+        PrefixLengths.insert(I, Prefix.size());
+    }
+    return Error::success();
+  }
+
   auto [It, DidEmplace] = Globs.try_emplace(Pattern);
   if (DidEmplace) {
     // We must be sure to use the string in the map rather than the provided
@@ -68,6 +87,16 @@ Error SpecialCaseList::Matcher::insert(StringRef Pattern, unsigned LineNumber,
 }
 
 unsigned SpecialCaseList::Matcher::match(StringRef Query) const {
+  auto L = Literals.find(Query);
+  if (L != Literals.end())
+    return L->second;
+  for (size_t Length : PrefixLengths) {
+    if (Length > Query.size())
+      break;
+    auto P = Prefixes.find(Query.take_front(Length));
+    if (P != Prefixes.end())
+      return P->second;
+  }
   for (const auto &[Pattern, Pair] : Globs)
     if (Pair.first.match(Query))
       return Pair.second;
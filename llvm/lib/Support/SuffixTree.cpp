@@ -58,6 +58,7 @@ SuffixTree::SuffixTree(const ArrayRef<unsigned> &Str,
 SuffixTreeNode *SuffixTree::insertLeaf(SuffixTreeInternalNode &Parent,
                                        unsigned StartIdx, unsigned Edge) {
   assert(StartIdx <= LeafEndIdx && "String can't start after it ends!");
+  ++NumLeafNodes;
   auto *N = new (LeafNodeAllocator.Allocate())
       SuffixTreeLeafNode(StartIdx, &LeafEndIdx);
   Parent.Children[Edge] = N;
@@ -71,6 +72,7 @@ SuffixTree::insertInternalNode(SuffixTreeInternalNode *Parent,
   assert(StartIdx <= EndIdx && "String can't start after it ends!");
   assert(!(!Parent && StartIdx != SuffixTreeNode::EmptyIdx) &&
          "Non-root internal nodes must have parents!");
+  ++NumInternalNodes;
   auto *N = new (InternalNodeAllocator.Allocate())
       SuffixTreeInternalNode(StartIdx, EndIdx, Root);
   if (Parent)
@@ -20,6 +20,11 @@ unsigned SuffixTreeNode::getStartIdx() const { return StartIdx; }
 void SuffixTreeNode::incrementStartIdx(unsigned Inc) { StartIdx += Inc; }
 void SuffixTreeNode::setConcatLen(unsigned Len) { ConcatLen = Len; }
 unsigned SuffixTreeNode::getConcatLen() const { return ConcatLen; }
+unsigned SuffixTreeNode::getEndIdx() const {
+  if (const auto *Leaf = dyn_cast<SuffixTreeLeafNode>(this))
+    return Leaf->getEndIdx();
+  return cast<SuffixTreeInternalNode>(this)->getEndIdx();
+}
 
 bool SuffixTreeInternalNode::isRoot() const {
   return getStartIdx() == EmptyIdx;
@@ -72,8 +72,8 @@ using NameAndCountAndDurationType =
 struct llvm::TimeTraceProfilerEntry {
   const TimePointType Start;
   TimePointType End;
-  const std::string Name;
-  const std::string Detail;
+  std::string Name;
+  std::string Detail;
   const bool AsyncEvent = false;
   TimeTraceProfilerEntry(TimePointType &&S, TimePointType &&E, std::string &&N,
                          std::string &&Dt, bool Ae)
@@ -125,10 +125,6 @@ struct llvm::TimeTraceProfiler {
     // Calculate duration at full precision for overall counts.
     DurationType Duration = E.End - E.Start;
 
-    // Only include sections longer or equal to TimeTraceGranularity msec.
-    if (duration_cast<microseconds>(Duration).count() >= TimeTraceGranularity)
-      Entries.emplace_back(E);
-
     // Track total time taken by each "name", but only the topmost levels of
     // them; e.g. if there's a template instantiation that instantiates other
     // templates from within, we only want to add the topmost one. "topmost"
@@ -143,6 +139,16 @@ struct llvm::TimeTraceProfiler {
       CountAndTotal.second += Duration;
     };
 
+    // Only include sections longer or equal to TimeTraceGranularity msec. The
+    // entry is about to be destroyed, so its strings can be moved.
+    if (duration_cast<microseconds>(Duration).count() >= TimeTraceGranularity)
+      Entries.emplace_back(std::move(E));
+
+    // Entries are usually ended in the reverse order of their beginning.
+    if (Stack.back().get() == &E) {
+      Stack.pop_back();
+      return;
+    }
     llvm::erase_if(Stack,
                    [&](const std::unique_ptr<TimeTraceProfilerEntry> &Val) {
                      return Val.get() == &E;
@@ -1733,12 +1733,21 @@ public:
       }
     } else { // Advance to the next component
       auto *DE = dyn_cast<RedirectingFileSystem::DirectoryEntry>(ParentEntry);
-      for (std::unique_ptr<RedirectingFileSystem::Entry> &Content :
-           llvm::make_range(DE->contents_begin(), DE->contents_end())) {
-        auto *DirContent =
-            dyn_cast<RedirectingFileSystem::DirectoryEntry>(Content.get());
-        if (DirContent && Name == Content->getName())
-          return DirContent;
+      if (DE->isIndexed()) {
+        for (RedirectingFileSystem::Entry *Content : DE->lookupContent(Name)) {
+          auto *DirContent =
+              dyn_cast<RedirectingFileSystem::DirectoryEntry>(Content);
+          if (DirContent && Name == Content->getName())
+            return DirContent;
+        }
+      } else {
+        for (std::unique_ptr<RedirectingFileSystem::Entry> &Content :
+             llvm::make_range(DE->contents_begin(), DE->contents_end())) {
+          auto *DirContent =
+              dyn_cast<RedirectingFileSystem::DirectoryEntry>(Content.get());
+          if (DirContent && Name == Content->getName())
+            return DirContent;
+        }
       }
     }
 
@@ -2349,16 +2358,31 @@ RedirectingFileSystem::lookupPathImpl(
     return LookupResult(From, Start, End);
 
   auto *DE = cast<RedirectingFileSystem::DirectoryEntry>(From);
-  for (const std::unique_ptr<RedirectingFileSystem::Entry> &DirEntry :
-       llvm::make_range(DE->contents_begin(), DE->contents_end())) {
+  auto LookupIn = [&](RedirectingFileSystem::Entry *DirEntry)
+      -> std::optional<ErrorOr<RedirectingFileSystem::LookupResult>> {
     Entries.push_back(From);
     ErrorOr<RedirectingFileSystem::LookupResult> Result =
-        lookupPathImpl(Start, End, DirEntry.get(), Entries);
+        lookupPathImpl(Start, End, DirEntry, Entries);
     if (Result || Result.getError() != llvm::errc::no_such_file_or_directory)
       return Result;
     Entries.pop_back();
+    return std::nullopt;
+  };
+
+  // Only the entries with the same name, ignoring case, can match the next
+  // component.
+  if (DE->isIndexed()) {
+    for (RedirectingFileSystem::Entry *DirEntry : DE->lookupContent(*Start))
+      if (auto Result = LookupIn(DirEntry))
+        return std::move(*Result);
+    return make_error_code(llvm::errc::no_such_file_or_directory);
   }
 
+  for (const std::unique_ptr<RedirectingFileSystem::Entry> &DirEntry :
+       llvm::make_range(DE->contents_begin(), DE->contents_end()))
+    if (auto Result = LookupIn(DirEntry.get()))
+      return std::move(*Result);
+
   return make_error_code(llvm::errc::no_such_file_or_directory);
 }
 
@@ -16,7 +16,9 @@
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/bit.h"
 #include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/IR/AutoUpgrade.h"
 #include "llvm/IR/Constants.h"
@@ -32,12 +34,17 @@
 #include "llvm/Linker/IRMover.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/DataExtractor.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO/Internalize.h"
@@ -1172,6 +1179,249 @@ void llvm::ComputeCrossModuleImport(
 #endif
 }
 
+/// Compute the key under which the result of ComputeCrossModuleImport for
+/// \p Index is persisted, or return an empty string if no stable key exists.
+static std::string
+computeCrossModuleImportKey(const ModuleSummaryIndex &Index,
+                            function_ref<bool(GlobalValue::GUID,
+                                              const GlobalValueSummary *)>
+                                isPrevailing) {
+  // Workload-based importing depends on a file we don't hash, and users
+  // asking for import printing expect the import computation to run.
+  if (!WorkloadDefinitions.empty() || PrintImports || PrintImportFailures)
+    return "";
+
+  SHA1 Hasher;
+  auto AddUnsigned = [&](unsigned I) {
+    uint8_t Data[4];
+    support::endian::write32le(Data, I);
+    Hasher.update(Data);
+  };
+  auto AddUint64 = [&](uint64_t I) {
+    uint8_t Data[8];
+    support::endian::write64le(Data, I);
+    Hasher.update(Data);
+  };
+  auto AddUint8 = [&](const uint8_t I) {
+    Hasher.update(ArrayRef<uint8_t>((const uint8_t *)&I, 1));
+  };
+  auto AddString = [&](StringRef Str) {
+    Hasher.update(Str);
+    AddUint8(0);
+  };
+
+  // Bump this whenever the serialized format or the import heuristics change.
+  AddString("LLVM-CrossModuleImport-1");
+  AddUnsigned(ImportInstrLimit);
+  AddUnsigned(ImportCutoff);
+  AddUint8(ForceImportAll);
+  AddUint8(ImportDeclaration);
+  AddUnsigned(bit_cast<uint32_t>(float(ImportInstrFactor)));
+  AddUnsigned(bit_cast<uint32_t>(float(ImportHotInstrFactor)));
+  AddUnsigned(bit_cast<uint32_t>(float(ImportHotMultiplier)));
+  AddUnsigned(bit_cast<uint32_t>(float(ImportCriticalMultiplier)));
+  AddUnsigned(bit_cast<uint32_t>(float(ImportColdMultiplier)));
+  AddUint8(Index.withAttributePropagation());
+  AddUint8(Index.withDSOLocalPropagation());
+  AddUint8(Index.withWholeProgramVisibility());
+
+  // The module hashes cover the per-module summaries (call edges, refs,
+  // instruction counts). The module paths are hashed in sorted order so that
+  // the key doesn't depend on StringMap iteration order.
+  std::vector<StringRef> ModulePaths;
+  for (const auto &MPSE : Index.modulePaths())
+    ModulePaths.push_back(MPSE.getKey());
+  llvm::sort(ModulePaths);
+  for (StringRef Path : ModulePaths) {
+    const ModuleHash &Hash = Index.getModuleHash(Path);
+    if (all_of(Hash, [](uint32_t W) { return W == 0; }))
+      return "";
+    AddString(Path);
+    for (uint32_t W : Hash)
+      AddUnsigned(W);
+  }
+
+  // The rest of the summary state consumed by the import computation is
+  // decided at link time by symbol resolution and the index-wide analyses.
+  for (const auto &Entry : Index) {
+    AddUint64(Entry.first);
+    for (const auto &S : Entry.second.SummaryList) {
+      AddString(S->modulePath());
+      AddUint8(S->linkage());
+      AddUint8(S->notEligibleToImport());
+      AddUint8(S->isLive());
+      AddUint8(S->isDSOLocal());
+      AddUint8(S->canAutoHide());
+      AddUint8(S->importType());
+      AddUint8(isPrevailing(Entry.first, S.get()));
+      if (auto *GVS = dyn_cast<GlobalVarSummary>(S.get())) {
+        AddUint8(GVS->maybeReadOnly());
+        AddUint8(GVS->maybeWriteOnly());
+      } else if (auto *FS = dyn_cast<FunctionSummary>(S.get())) {
+        AddUint64(FS->entryCount());
+      }
+    }
+  }
+
+  return toHex(Hasher.result());
+}
+
+static void
+writeCrossModuleImport(raw_ostream &OS,
+                       const DenseMap<StringRef, FunctionImporter::ImportMapTy>
+                           &ImportLists,
+                       const DenseMap<StringRef, FunctionImporter::ExportSetTy>
+                           &ExportLists) {
+  support::endian::Writer W(OS, llvm::endianness::little);
+  auto WriteString = [&](StringRef Str) { OS << Str << '\0'; };
+
+  W.write<uint32_t>(ImportLists.size());
+  for (const auto &[ModPath, ImportList] : ImportLists) {
+    WriteString(ModPath);
+    W.write<uint32_t>(ImportList.size());
+    for (const auto &[SrcModPath, Functions] : ImportList) {
+      WriteString(SrcModPath);
+      W.write<uint32_t>(Functions.size());
+      for (const auto &[GUID, Kind] : Functions) {
+        W.write<uint64_t>(GUID);
+        W.write<uint8_t>(Kind);
+      }
+    }
+  }
+
+  W.write<uint32_t>(ExportLists.size());
+  for (const auto &[ModPath, ExportList] : ExportLists) {
+    WriteString(ModPath);
+    W.write<uint32_t>(ExportList.size());
+    for (const auto &[VI, Kind] : ExportList) {
+      W.write<uint64_t>(VI.getGUID());
+      W.write<uint8_t>(Kind);
+    }
+  }
+}
+
+static Error
+readCrossModuleImport(StringRef Data, const ModuleSummaryIndex &Index,
+                      DenseMap<StringRef, FunctionImporter::ImportMapTy>
+                          &ImportLists,
+                      DenseMap<StringRef, FunctionImporter::ExportSetTy>
+                          &ExportLists) {
+  DataExtractor DE(Data, /*IsLittleEndian=*/true, /*AddressSize=*/8);
+  DataExtractor::Cursor C(0);
+  bool Malformed = false;
+
+  // Map a serialized module path back to the copy owned by the index, which
+  // is what the keys of the import and export lists must point to.
+  auto ReadModulePath = [&]() -> StringRef {
+    StringRef Path = DE.getCStrRef(C);
+    auto It = Index.modulePaths().find(Path);
+    if (!C || It == Index.modulePaths().end()) {
+      Malformed = true;
+      return StringRef();
+    }
+    return It->getKey();
+  };
+  auto ReadKind = [&]() {
+    uint8_t Kind = DE.getU8(C);
+    if (Kind > GlobalValueSummary::Declaration)
+      Malformed = true;
+    return static_cast<GlobalValueSummary::ImportKind>(Kind);
+  };
+
+  for (uint32_t I = 0, E = DE.getU32(C); C && !Malformed && I != E; ++I) {
+    auto &ImportList = ImportLists[ReadModulePath()];
+    for (uint32_t J = 0, F = DE.getU32(C); C && !Malformed && J != F; ++J) {
+      auto &Functions = ImportList[ReadModulePath()];
+      for (uint32_t K = 0, G = DE.getU32(C); C && !Malformed && K != G; ++K) {
+        GlobalValue::GUID GUID = DE.getU64(C);
+        Functions[GUID] = ReadKind();
+      }
+    }
+  }
+
+  for (uint32_t I = 0, E = DE.getU32(C); C && !Malformed && I != E; ++I) {
+    auto &ExportList = ExportLists[ReadModulePath()];
+    for (uint32_t J = 0, F = DE.getU32(C); C && !Malformed && J != F; ++J) {
+      ValueInfo VI = Index.getValueInfo(DE.getU64(C));
+      GlobalValueSummary::ImportKind Kind = ReadKind();
+      if (!VI)
+        Malformed = true;
+      else
+        ExportList[VI] = Kind;
+    }
+  }
+
+  if (Error Err = C.takeError())
+    return Err;
+  if (Malformed || !DE.eof(C))
+    return createStringError(inconvertibleErrorCode(),
+                             "malformed cross-module import cache entry");
+  return Error::success();
+}
+
+void llvm::ComputeCrossModuleImportCached(
+    StringRef CacheDir, const ModuleSummaryIndex &Index,
+    const DenseMap<StringRef, GVSummaryMapTy> &ModuleToDefinedGVSummaries,
+    function_ref<bool(GlobalValue::GUID, const GlobalValueSummary *)>
+        isPrevailing,
+    DenseMap<StringRef, FunctionImporter::ImportMapTy> &ImportLists,
+    DenseMap<StringRef, FunctionImporter::ExportSetTy> &ExportLists) {
+  auto Compute = [&]() {
+    ComputeCrossModuleImport(Index, ModuleToDefinedGVSummaries, isPrevailing,
+                             ImportLists, ExportLists);
+  };
+  if (CacheDir.empty())
+    return Compute();
+  std::string Key = computeCrossModuleImportKey(Index, isPrevailing);
+  if (Key.empty())
+    return Compute();
+
+  // Use the "llvmcache-" prefix so that the entries are subject to the same
+  // pruning policy as the cached backend outputs in this directory.
+  SmallString<128> EntryPath;
+  sys::path::append(EntryPath, CacheDir, "llvmcache-imports-" + Key);
+
+  if (ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
+          MemoryBuffer::getFile(EntryPath)) {
+    Error Err = readCrossModuleImport((*MBOrErr)->getBuffer(), Index,
+                                      ImportLists, ExportLists);
+    if (!Err) {
+      LLVM_DEBUG(dbgs() << "Reusing cross-module import lists from "
+                        << EntryPath << "\n");
+      assert(checkVariableImport(Index, ImportLists, ExportLists));
+      return;
+    }
+    // A corrupt entry is no worse than a missing one; recompute and
+    // overwrite it below.
+    consumeError(std::move(Err));
+    ImportLists.clear();
+    ExportLists.clear();
+  }
+
+  Compute();
+
+  if (std::error_code EC = sys::fs::create_directories(CacheDir)) {
+    LLVM_DEBUG(dbgs() << "Cannot create cache directory " << CacheDir << ": "
+                      << EC.message() << "\n");
+    return;
+  }
+  Expected<sys::fs::TempFile> Temp =
+      sys::fs::TempFile::create(Twine(EntryPath) + ".tmp%%%%%%%");
+  if (!Temp) {
+    consumeError(Temp.takeError());
+    return;
+  }
+  {
+    raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+    writeCrossModuleImport(OS, ImportLists, ExportLists);
+  }
+  // Failing to persist the lists only costs the next link a recomputation.
+  if (Error Err = Temp->keep(EntryPath)) {
+    consumeError(std::move(Err));
+    consumeError(Temp->discard());
+  }
+}
+
 #ifndef NDEBUG
 static void dumpImportListForModule(const ModuleSummaryIndex &Index,
                                     StringRef ModulePath,
@@ -1738,6 +1988,16 @@ Expected<bool> FunctionImporter::importFunctions(
     // Get the module for the import
     const auto &FunctionsToImportPerModule = ImportList.find(Name);
     assert(FunctionsToImportPerModule != ImportList.end());
+    auto &ImportGUIDs = FunctionsToImportPerModule->second;
+
+    // Only definitions are linked into the destination module. If this module
+    // only provides declarations, don't pay for loading it and materializing
+    // its metadata.
+    if (none_of(ImportGUIDs, [](const auto &GUIDAndImportType) {
+          return GUIDAndImportType.second == GlobalValueSummary::Definition;
+        }))
+      continue;
+
     Expected<std::unique_ptr<Module>> SrcModuleOrErr = ModuleLoader(Name);
     if (!SrcModuleOrErr)
       return SrcModuleOrErr.takeError();
@@ -1750,8 +2010,6 @@ Expected<bool> FunctionImporter::importFunctions(
     if (Error Err = SrcModule->materializeMetadata())
       return std::move(Err);
 
-    auto &ImportGUIDs = FunctionsToImportPerModule->second;
-
     // Find the globals to import
     SetVector<GlobalValue *> GlobalsToImport;
     for (Function &F : *SrcModule) {
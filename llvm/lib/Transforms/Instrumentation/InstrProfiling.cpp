@@ -132,6 +132,25 @@ cl::opt<bool> AtomicFirstCounter(
              "the entry counter)"),
     cl::init(false));
 
+cl::opt<bool> SampledInstr(
+    "sampled-instrumentation",
+    cl::desc("Only update profile counters during a burst of executions at "
+             "the start of every sampling period. Each thread keeps its own "
+             "position in the period."),
+    cl::init(false));
+
+cl::opt<unsigned> SampledInstrPeriod(
+    "sampled-instr-period",
+    cl::desc("The number of counter update sites executed per sampling "
+             "period"),
+    cl::init(65536));
+
+cl::opt<unsigned> SampledInstrBurstDuration(
+    "sampled-instr-burst-duration",
+    cl::desc("The number of counter update sites executed with counting "
+             "enabled at the start of each sampling period"),
+    cl::init(200));
+
 // If the option is not specified, the default behavior about whether
 // counter promotion is done depends on how instrumentaiton lowering
 // pipeline is setup, i.e., the default value of true of this option
@@ -245,6 +264,10 @@ private:
   // vector of counter load/store pairs to be register promoted.
   std::vector<LoadStorePair> PromotionCandidates;
 
+  // The first and last instructions of each counter update in the current
+  // function, to be guarded by the sampling condition.
+  std::vector<std::pair<Instruction *, Instruction *>> SampledUpdates;
+
   int64_t TotalCountersPromoted = 0;
 
   /// Lower instrumentation intrinsics in the function. Returns true if there
@@ -260,6 +283,17 @@ private:
   /// Returns true if profile counter update register promotion is enabled.
   bool isCounterPromotionEnabled() const;
 
+  /// Returns true if counter updates are guarded by sampling.
+  bool isSamplingEnabled() const;
+
+  /// Get the per-thread position in the sampling period, creating it if it
+  /// hasn't been seen.
+  GlobalVariable *getOrCreateSamplingVar();
+
+  /// Make the counter update from \p First to \p Last conditional on the
+  /// current thread being in the burst part of its sampling period.
+  void doSampling(Instruction *First, Instruction *Last);
+
   /// Count the number of instrumented value sites for the function.
   void computeNumValueSiteCounts(InstrProfValueProfileInst *Ins);
 
@@ -638,6 +672,7 @@ PreservedAnalyses InstrProfilingLoweringPass::run(Module &M,
 bool InstrLowerer::lowerIntrinsics(Function *F) {
   bool MadeChange = false;
   PromotionCandidates.clear();
+  SampledUpdates.clear();
   for (BasicBlock &BB : *F) {
     for (Instruction &Instr : llvm::make_early_inc_range(BB)) {
       if (auto *IPIS = dyn_cast<InstrProfIncrementInstStep>(&Instr)) {
@@ -668,6 +703,11 @@ bool InstrLowerer::lowerIntrinsics(Function *F) {
   if (!MadeChange)
     return false;
 
+  // Splitting blocks while walking them above would invalidate the
+  // iteration, so the updates are guarded afterwards.
+  for (auto [First, Last] : SampledUpdates)
+    doSampling(First, Last);
+
   promoteCounterLoadStores(F);
   return true;
 }
@@ -685,12 +725,80 @@ bool InstrLowerer::isRuntimeCounterRelocationEnabled() const {
 }
 
 bool InstrLowerer::isCounterPromotionEnabled() const {
+  // Promoted counters are updated outside of the sampled regions.
+  if (isSamplingEnabled())
+    return false;
+
   if (DoCounterPromotion.getNumOccurrences() > 0)
     return DoCounterPromotion;
 
   return Options.DoCounterPromotion;
 }
 
+bool InstrLowerer::isSamplingEnabled() const {
+  // With a burst covering the whole period every update would be counted.
+  return SampledInstr && SampledInstrBurstDuration < SampledInstrPeriod;
+}
+
+/// Returns true if thread-local variables can be lowered for \p TT.
+static bool supportsThreadLocalStorage(const Triple &TT) {
+  return !(TT.isAMDGPU() || TT.isNVPTX() || TT.isSPIRV() || TT.isBPF());
+}
+
+GlobalVariable *InstrLowerer::getOrCreateSamplingVar() {
+  StringRef VarName = "__llvm_profile_sampling";
+  GlobalVariable *SamplingVar = M.getGlobalVariable(VarName);
+  if (SamplingVar)
+    return SamplingVar;
+
+  // Keeping the position per thread avoids sharing a written cache line
+  // between threads, which is the cost sampling is meant to remove. Targets
+  // without TLS share a single position; the racy updates only make the
+  // sampled fraction approximate.
+  Type *Int32Ty = Type::getInt32Ty(M.getContext());
+  SamplingVar = new GlobalVariable(
+      M, Int32Ty, false, GlobalValue::LinkOnceODRLinkage,
+      Constant::getNullValue(Int32Ty), VarName, nullptr,
+      supportsThreadLocalStorage(TT) ? GlobalValue::GeneralDynamicTLSModel
+                                     : GlobalValue::NotThreadLocal);
+  SamplingVar->setVisibility(GlobalVariable::HiddenVisibility);
+  if (TT.supportsCOMDAT())
+    SamplingVar->setComdat(M.getOrInsertComdat(VarName));
+
+  return SamplingVar;
+}
+
+void InstrLowerer::doSampling(Instruction *First, Instruction *Last) {
+  GlobalVariable *SamplingVar = getOrCreateSamplingVar();
+  Type *Ty = SamplingVar->getValueType();
+
+  // Advance the position in the period, wrapping around at its end.
+  IRBuilder<> Builder(First);
+  Value *Pos = Builder.CreateLoad(Ty, SamplingVar, "pgosampling");
+  Value *Next = Builder.CreateAdd(Pos, ConstantInt::get(Ty, 1));
+  Value *Wrap =
+      Builder.CreateICmpUGE(Next, ConstantInt::get(Ty, SampledInstrPeriod));
+  Next = Builder.CreateSelect(Wrap, ConstantInt::get(Ty, 0), Next);
+  Builder.CreateStore(Next, SamplingVar);
+
+  Value *InBurst = Builder.CreateICmpULT(
+      Pos, ConstantInt::get(Ty, SampledInstrBurstDuration));
+  MDNode *Weights = MDBuilder(M.getContext())
+                        .createBranchWeights(SampledInstrBurstDuration,
+                                             SampledInstrPeriod -
+                                                 SampledInstrBurstDuration);
+  Instruction *ThenTerm =
+      SplitBlockAndInsertIfThen(InBurst, First, /*Unreachable=*/false, Weights);
+
+  // Move the counter update into the guarded block.
+  Instruction *End = Last->getNextNode();
+  for (Instruction *I = First; I != End;) {
+    Instruction *NextI = I->getNextNode();
+    I->moveBefore(ThenTerm);
+    I = NextI;
+  }
+}
+
 void InstrLowerer::promoteCounterLoadStores(Function *F) {
   if (!isCounterPromotionEnabled())
     return;
@@ -1055,10 +1163,12 @@ void InstrLowerer::lowerIncrement(InstrProfIncrementInst *Inc) {
   auto *Addr = getCounterAddress(Inc);
 
   IRBuilder<> Builder(Inc);
+  Instruction *First, *Last;
   if (Options.Atomic || AtomicCounterUpdateAll ||
       (Inc->getIndex()->isZeroValue() && AtomicFirstCounter)) {
-    Builder.CreateAtomicRMW(AtomicRMWInst::Add, Addr, Inc->getStep(),
-                            MaybeAlign(), AtomicOrdering::Monotonic);
+    First = Last = Builder.CreateAtomicRMW(AtomicRMWInst::Add, Addr,
+                                           Inc->getStep(), MaybeAlign(),
+                                           AtomicOrdering::Monotonic);
   } else {
     Value *IncStep = Inc->getStep();
     Value *Load = Builder.CreateLoad(IncStep->getType(), Addr, "pgocount");
@@ -1066,7 +1176,11 @@ void InstrLowerer::lowerIncrement(InstrProfIncrementInst *Inc) {
     auto *Store = Builder.CreateStore(Count, Addr);
     if (isCounterPromotionEnabled())
       PromotionCandidates.emplace_back(cast<Instruction>(Load), Store);
+    First = cast<Instruction>(Load);
+    Last = Store;
   }
+  if (isSamplingEnabled())
+    SampledUpdates.emplace_back(First, Last);
   Inc->eraseFromParent();
 }
 
@@ -0,0 +1,34 @@
+; REQUIRES: asserts
+; RUN: llc < %s -mtriple=x86_64-- -debug-only=machine-scheduler -o /dev/null 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=DEFAULT
+; RUN: llc < %s -mtriple=x86_64-- -misched-max-region-size=4 \
+; RUN:   -debug-only=machine-scheduler -o /dev/null 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=LIMIT
+
+;; The block is one scheduling region by default. With
+;; -misched-max-region-size=4 it is cut into regions of at most four
+;; instructions.
+
+; DEFAULT-NOT: Splitting scheduling region
+; DEFAULT:     ********** MI Scheduling **********
+; DEFAULT:     RegionInstrs: {{[1-9][0-9]}}{{$}}
+
+; LIMIT:     Splitting scheduling region of %bb.0
+; LIMIT-NOT: RegionInstrs: {{[5-9]|[1-9][0-9]}}{{$}}
+; LIMIT:     ********** MI Scheduling **********
+; LIMIT-NOT: RegionInstrs: {{[5-9]|[1-9][0-9]}}{{$}}
+; LIMIT:     RegionInstrs: 4{{$}}
+; LIMIT-NOT: RegionInstrs: {{[5-9]|[1-9][0-9]}}{{$}}
+
+define i64 @f(i64 %a0, i64 %a1, i64 %a2, i64 %a3, i64 %a4, i64 %a5) {
+  %m0 = mul i64 %a0, %a1
+  %m1 = mul i64 %a2, %a3
+  %m2 = mul i64 %a4, %a5
+  %m3 = mul i64 %a0, %a3
+  %m4 = mul i64 %a1, %a4
+  %s0 = add i64 %m0, %m1
+  %s1 = add i64 %s0, %m2
+  %s2 = add i64 %s1, %m3
+  %s3 = add i64 %s2, %m4
+  ret i64 %s3
+}
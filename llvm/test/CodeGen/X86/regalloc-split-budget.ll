@@ -0,0 +1,49 @@
+; REQUIRES: asserts
+; RUN: llc < %s -mtriple=x86_64-- -stats -o /dev/null 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=DEFAULT
+; RUN: llc < %s -mtriple=x86_64-- -regalloc-split-budget=1 -stats -o /dev/null 2>&1 | \
+; RUN:   FileCheck %s --check-prefix=BUDGET
+
+;; Every value that is live across the call in %cold is split around it by
+;; default. With -regalloc-split-budget=1 only the first split attempt runs,
+;; and the remaining ranges are spilled whole.
+
+; DEFAULT:     regalloc - Number of split global live ranges
+; DEFAULT-NOT: regalloc - Number of live ranges spilled because the split budget ran out
+
+; BUDGET: regalloc - Number of live ranges spilled because the split budget ran out
+
+declare void @g()
+
+define i64 @f(i64 %a0, i64 %a1, i64 %a2, i64 %a3, i64 %a4, i64 %a5, ptr %p) {
+entry:
+  %v0 = load volatile i64, ptr %p
+  %v1 = load volatile i64, ptr %p
+  %v2 = load volatile i64, ptr %p
+  %v3 = load volatile i64, ptr %p
+  %v4 = load volatile i64, ptr %p
+  %v5 = load volatile i64, ptr %p
+  %v6 = load volatile i64, ptr %p
+  %v7 = load volatile i64, ptr %p
+  %c = icmp eq i64 %a0, 0
+  br i1 %c, label %cold, label %hot
+
+cold:
+  call void @g()
+  br label %hot
+
+hot:
+  %s0 = add i64 %v0, %v1
+  %s1 = add i64 %s0, %v2
+  %s2 = add i64 %s1, %v3
+  %s3 = add i64 %s2, %v4
+  %s4 = add i64 %s3, %v5
+  %s5 = add i64 %s4, %v6
+  %s6 = add i64 %s5, %v7
+  %s7 = add i64 %s6, %a1
+  %s8 = add i64 %s7, %a2
+  %s9 = add i64 %s8, %a3
+  %s10 = add i64 %s9, %a4
+  %s11 = add i64 %s10, %a5
+  ret i64 %s11
+}
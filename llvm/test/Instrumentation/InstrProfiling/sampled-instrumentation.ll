@@ -0,0 +1,67 @@
+;; With -sampled-instrumentation, counter updates only happen during the first
+;; burst-duration updates out of every period.
+
+; RUN: opt < %s -passes=instrprof -sampled-instrumentation -S | FileCheck %s --check-prefixes=CHECK,TLS
+; RUN: opt < %s -passes=instrprof -sampled-instrumentation -do-counter-promotion -S | \
+; RUN:   FileCheck %s --check-prefixes=CHECK,TLS
+; RUN: opt < %s -mtriple=amdgcn-amd-amdhsa -passes=instrprof -sampled-instrumentation -S | \
+; RUN:   FileCheck %s --check-prefixes=CHECK,NOTLS
+
+;; A burst covering the whole period disables sampling.
+; RUN: opt < %s -passes=instrprof -sampled-instrumentation -sampled-instr-burst-duration=65536 -S | \
+; RUN:   FileCheck %s --check-prefix=NOSAMPLE
+
+target triple = "x86_64-unknown-linux-gnu"
+
+@__profn_foo = private constant [3 x i8] c"foo"
+
+; TLS:   @__llvm_profile_sampling = linkonce_odr hidden thread_local global i32 0, comdat
+; NOTLS: @__llvm_profile_sampling = linkonce_odr hidden global i32 0, comdat
+; NOSAMPLE-NOT: __llvm_profile_sampling
+
+;; The counter update stays guarded in the loop body; counter promotion would
+;; move it to the loop exit and bypass the sampling.
+; CHECK-LABEL: define void @foo(
+; CHECK:       loop:
+; CHECK-NEXT:    %[[POS:.*]] = load i32, ptr @__llvm_profile_sampling
+; CHECK-NEXT:    %[[NEXT:.*]] = add i32 %[[POS]], 1
+; CHECK-NEXT:    %[[WRAP:.*]] = icmp uge i32 %[[NEXT]], 65536
+; CHECK-NEXT:    %[[SEL:.*]] = select i1 %[[WRAP]], i32 0, i32 %[[NEXT]]
+; CHECK-NEXT:    store i32 %[[SEL]], ptr @__llvm_profile_sampling
+; CHECK-NEXT:    %[[BURST:.*]] = icmp ult i32 %[[POS]], 200
+; CHECK-NEXT:    br i1 %[[BURST]], label %[[THEN:.*]], label %[[CONT:.*]], !prof ![[PROF:[0-9]+]]
+; CHECK:       [[THEN]]:
+; CHECK-NEXT:    %[[C:.*]] = load i64, ptr @__profc_foo
+; CHECK-NEXT:    %[[INC:.*]] = add i64 %[[C]], 1
+; CHECK-NEXT:    store i64 %[[INC]], ptr @__profc_foo
+; CHECK-NEXT:    br label %[[CONT]]
+; CHECK:       [[CONT]]:
+; CHECK:         br i1 %{{.*}}, label %loop, label %exit
+; CHECK:       exit:
+; CHECK-NOT:     @__profc_foo
+; CHECK:         ret void
+
+; CHECK: ![[PROF]] = !{!"branch_weights", i32 200, i32 65336}
+
+;; Without sampling the update is plain.
+; NOSAMPLE-LABEL: define void @foo(
+; NOSAMPLE:       loop:
+; NOSAMPLE-NEXT:    %{{.*}} = load i64, ptr @__profc_foo
+; NOSAMPLE-NOT:     !prof
+
+define void @foo(i32 %n) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  call void @llvm.instrprof.increment(ptr @__profn_foo, i64 0, i32 1, i32 0)
+  %i.next = add i32 %i, 1
+  %done = icmp eq i32 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+declare void @llvm.instrprof.increment(ptr, i64, i32, i32)
@@ -0,0 +1,26 @@
+# REQUIRES: zstd, x86-registered-target
+## With --compress-debug-sections-threads=, a zstd-compressed debug section
+## larger than 1 MiB is compressed as several frames in parallel. The result
+## decompresses to the original contents and doesn't depend on the number of
+## threads.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.plain
+# RUN: llvm-mc -filetype=obj -triple=x86_64 --compress-debug-sections=zstd \
+# RUN:   --compress-debug-sections-threads=2 %s -o %t.2
+# RUN: llvm-mc -filetype=obj -triple=x86_64 --compress-debug-sections=zstd \
+# RUN:   --compress-debug-sections-threads=8 %s -o %t.8
+# RUN: cmp %t.2 %t.8
+# RUN: llvm-readelf -S %t.2 | FileCheck %s
+
+# CHECK: .debug_str PROGBITS {{.*}} MSC
+
+# RUN: llvm-objcopy --decompress-debug-sections %t.2 %t.dec
+# RUN: llvm-objcopy --dump-section=.debug_str=%t.dec.bin %t.dec
+# RUN: llvm-objcopy --dump-section=.debug_str=%t.plain.bin %t.plain
+# RUN: cmp %t.dec.bin %t.plain.bin
+
+.section .debug_str,"MS",@progbits,1
+.rept 0x28000
+.ascii "abcdefgh"
+.endr
+.byte 0
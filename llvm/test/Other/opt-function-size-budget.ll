@@ -0,0 +1,53 @@
+;; -opt-function-size-budget skips optional function passes on functions with
+;; more instructions than the budget, and reports each skip as a missed remark.
+;; It also reports the instruction count delta of each pass that changes a
+;; function as an analysis remark.
+
+; RUN: opt -S -passes=instcombine -opt-function-size-budget=3 %s | FileCheck %s
+; RUN: opt -disable-output -passes=instcombine -opt-function-size-budget=3 \
+; RUN:   -pass-remarks-missed=size-budget %s 2>&1 | FileCheck %s --check-prefix=REMARK
+
+;; Within the budget, every change is reported once per (pass, function).
+; RUN: opt -disable-output -passes=instcombine,simplifycfg -opt-function-size-budget=10 \
+; RUN:   -pass-remarks-analysis=size-budget %s 2>&1 | FileCheck %s --check-prefix=DELTA
+
+;; Without a budget every function is optimized.
+; RUN: opt -S -passes=instcombine %s | FileCheck %s --check-prefix=NOBUDGET
+; RUN: opt -disable-output -passes=instcombine -pass-remarks-missed=size-budget %s 2>&1 | \
+; RUN:   FileCheck %s --allow-empty --check-prefix=NOREMARK
+
+; CHECK-LABEL: define i32 @small(
+; CHECK-NEXT:    ret i32 %x
+; CHECK-LABEL: define i32 @big(
+; CHECK-NEXT:    %a = add i32 %x, 0
+; CHECK-NEXT:    %b = mul i32 %a, 1
+; CHECK-NEXT:    %c = add i32 %b, 0
+; CHECK-NEXT:    %d = mul i32 %c, 1
+; CHECK-NEXT:    ret i32 %d
+
+; REMARK:     remark: {{.*}} skipped InstCombinePass on function with 5 instructions (budget 3)
+; REMARK-NOT: remark:
+
+; NOBUDGET-LABEL: define i32 @small(
+; NOBUDGET-NEXT:    ret i32 %x
+; NOBUDGET-LABEL: define i32 @big(
+; NOBUDGET-NEXT:    ret i32 %x
+
+; NOREMARK-NOT: remark:
+
+; DELTA:     remark: {{.*}} InstCombinePass changed the function from 2 to 1 instructions (delta -1)
+; DELTA:     remark: {{.*}} InstCombinePass changed the function from 5 to 1 instructions (delta -4)
+; DELTA-NOT: remark:
+
+define i32 @small(i32 %x) {
+  %a = add i32 %x, 0
+  ret i32 %a
+}
+
+define i32 @big(i32 %x) {
+  %a = add i32 %x, 0
+  %b = mul i32 %a, 1
+  %c = add i32 %b, 0
+  %d = mul i32 %c, 1
+  ret i32 %d
+}
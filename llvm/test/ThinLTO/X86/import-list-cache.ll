@@ -0,0 +1,62 @@
+;; The cross-module import lists are persisted in the cache directory, reused
+;; by an identical link, and recomputed when an input changes.
+
+; REQUIRES: asserts
+; RUN: rm -rf %t && split-file %s %t && cd %t
+; RUN: opt -module-hash -module-summary main.ll -o main.bc
+; RUN: opt -module-hash -module-summary foo.ll -o foo.bc
+; RUN: opt -module-hash -module-summary foo-noinline.ll -o foo-noinline.bc
+
+;; The first link computes the lists and writes them.
+; RUN: llvm-lto2 run main.bc foo.bc -o out -cache-dir cache -save-temps \
+; RUN:   -debug-only=function-import -r=main.bc,main,px -r=main.bc,foo, \
+; RUN:   -r=foo.bc,foo,px 2>&1 | FileCheck %s --check-prefix=MISS
+; RUN: ls cache/llvmcache-imports-* | count 1
+; RUN: llvm-dis out.1.3.import.bc -o - | FileCheck %s --check-prefix=IMPORTED
+; MISS-NOT: Reusing cross-module import lists
+; MISS: Computing import for Module 'main.bc'
+; IMPORTED: define available_externally {{.*}} @foo(
+
+;; An identical link reads them back instead.
+; RUN: llvm-lto2 run main.bc foo.bc -o out -cache-dir cache -save-temps \
+; RUN:   -debug-only=function-import -r=main.bc,main,px -r=main.bc,foo, \
+; RUN:   -r=foo.bc,foo,px 2>&1 | FileCheck %s --check-prefix=HIT
+; HIT: Reusing cross-module import lists from cache{{[/\\]}}llvmcache-imports-
+; HIT-NOT: Computing import for Module
+
+;; Making foo noinline changes its summary. The stale lists, which import foo,
+;; must not be reused.
+; RUN: rm out.1.3.import.bc
+; RUN: llvm-lto2 run main.bc foo-noinline.bc -o out -cache-dir cache -save-temps \
+; RUN:   -debug-only=function-import -r=main.bc,main,px -r=main.bc,foo, \
+; RUN:   -r=foo-noinline.bc,foo,px 2>&1 | FileCheck %s --check-prefix=MISS
+; RUN: ls cache/llvmcache-imports-* | count 2
+; RUN: llvm-dis out.1.3.import.bc -o - | FileCheck %s --check-prefix=NOTIMPORTED
+; NOTIMPORTED: declare {{.*}} @foo(
+
+;--- main.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @main() {
+  %r = call i32 @foo()
+  ret i32 %r
+}
+
+declare i32 @foo()
+
+;--- foo.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @foo() {
+  ret i32 1
+}
+
+;--- foo-noinline.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @foo() noinline {
+  ret i32 1
+}
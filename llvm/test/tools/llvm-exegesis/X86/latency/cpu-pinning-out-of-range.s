@@ -0,0 +1,14 @@
+# REQUIRES: x86_64-linux
+
+## --benchmark-process-cpu= rejects CPUs that do not fit in a cpu_set_t before
+## anything is assembled or measured.
+
+# RUN: not llvm-exegesis -mtriple=x86_64-unknown-unknown -mode=latency -opcode-name=ADD64rr \
+# RUN:   -execution-mode=subprocess -benchmark-phase=assemble-measured-code \
+# RUN:   --benchmark-process-cpu=-2 2>&1 | FileCheck %s --check-prefix=NEGATIVE
+# NEGATIVE: llvm-exegesis error: --benchmark-process-cpu: CPU -2 is out of range [0, {{[0-9]+}})
+
+# RUN: not llvm-exegesis -mtriple=x86_64-unknown-unknown -mode=latency -opcode-name=ADD64rr \
+# RUN:   -execution-mode=subprocess -benchmark-phase=assemble-measured-code \
+# RUN:   --benchmark-process-cpu=1048576 2>&1 | FileCheck %s --check-prefix=TOO-LARGE
+# TOO-LARGE: llvm-exegesis error: --benchmark-process-cpu: CPU 1048576 is out of range [0, {{[0-9]+}})
@@ -41,6 +41,7 @@
 
 #include "CoverageExporterLcov.h"
 #include "CoverageReport.h"
+#include "llvm/Support/ThreadPool.h"
 
 using namespace llvm;
 
@@ -198,11 +199,41 @@ void renderFile(raw_ostream &OS, const coverage::CoverageMapping &Coverage,
 void renderFiles(raw_ostream &OS, const coverage::CoverageMapping &Coverage,
                  ArrayRef<std::string> SourceFiles,
                  ArrayRef<FileCoverageSummary> FileReports,
-                 bool ExportSummaryOnly, bool SkipFunctions,
-                 bool SkipBranches) {
-  for (unsigned I = 0, E = SourceFiles.size(); I < E; ++I)
-    renderFile(OS, Coverage, SourceFiles[I], FileReports[I], ExportSummaryOnly,
-               SkipFunctions, SkipBranches);
+                 const CoverageViewOptions &Options) {
+  ThreadPoolStrategy S = hardware_concurrency(Options.NumThreads);
+  if (Options.NumThreads == 0) {
+    // If NumThreads is not specified, create one thread for each input, up to
+    // the number of hardware cores.
+    S = heavyweight_hardware_concurrency(SourceFiles.size());
+    S.Limit = true;
+  }
+
+  if (S.compute_thread_count() <= 1) {
+    for (unsigned I = 0, E = SourceFiles.size(); I < E; ++I)
+      renderFile(OS, Coverage, SourceFiles[I], FileReports[I],
+                 Options.ExportSummaryOnly, Options.SkipFunctions,
+                 Options.SkipBranches);
+    return;
+  }
+
+  // Render each file into its own buffer in parallel, then write them out in
+  // input order so that the output doesn't depend on scheduling.
+  std::vector<std::string> Rendered(SourceFiles.size());
+  DefaultThreadPool Pool(S);
+  for (unsigned I = 0, E = SourceFiles.size(); I < E; ++I) {
+    Pool.async([&, I] {
+      raw_string_ostream FileOS(Rendered[I]);
+      renderFile(FileOS, Coverage, SourceFiles[I], FileReports[I],
+                 Options.ExportSummaryOnly, Options.SkipFunctions,
+                 Options.SkipBranches);
+    });
+  }
+  Pool.wait();
+
+  for (std::string &File : Rendered) {
+    OS << File;
+    std::string().swap(File);
+  }
 }
 
 } // end anonymous namespace
@@ -220,6 +251,5 @@ void CoverageExporterLcov::renderRoot(ArrayRef<std::string> SourceFiles) {
   FileCoverageSummary Totals = FileCoverageSummary("Totals");
   auto FileReports = CoverageReport::prepareFileReports(Coverage, Totals,
                                                         SourceFiles, Options);
-  renderFiles(OS, Coverage, SourceFiles, FileReports, Options.ExportSummaryOnly,
-              Options.SkipFunctions, Options.SkipBranches);
+  renderFiles(OS, Coverage, SourceFiles, FileReports, Options);
 }
@@ -11,7 +11,8 @@
 /// queries the debuginfod servers in the DEBUGINFOD_URLS environment
 /// variable (delimited by space (" ")) for the executable,
 /// debuginfo, or specified source file of the binary matching the
-/// given build-id.
+/// given build-id. Debug binaries for several build-ids are fetched
+/// concurrently.
 ///
 //===----------------------------------------------------------------------===//
 
@@ -26,9 +27,9 @@ using namespace llvm;
 
 cl::OptionCategory DebuginfodFindCategory("llvm-debuginfod-find Options");
 
-cl::opt<std::string> InputBuildID(cl::Positional, cl::Required,
-                                  cl::desc("<input build_id>"), cl::init("-"),
-                                  cl::cat(DebuginfodFindCategory));
+cl::list<std::string> InputBuildIDs(cl::Positional, cl::OneOrMore,
+                                    cl::desc("<input build_id>..."),
+                                    cl::cat(DebuginfodFindCategory));
 
 static cl::opt<bool>
     FetchExecutable("executable", cl::init(false),
@@ -87,34 +88,54 @@ int main(int argc, char **argv) {
 
   if (FetchExecutable + FetchDebuginfo + (FetchSource != "") != 1)
     helpExit();
-
-  std::string IDString;
-  if (!tryGetFromHex(InputBuildID, IDString)) {
-    errs() << "Build ID " << InputBuildID << " is not a hex string.\n";
+  if (InputBuildIDs.size() > 1 && !FetchDebuginfo) {
+    errs() << "Only --debuginfo accepts more than one build ID.\n";
     exit(1);
   }
-  object::BuildID ID(IDString.begin(), IDString.end());
-
-  std::string Path;
-  if (FetchSource != "")
-    Path = ExitOnErr(getCachedOrDownloadSource(ID, FetchSource));
-  else if (FetchExecutable)
-    Path = ExitOnErr(getCachedOrDownloadExecutable(ID));
-  else if (FetchDebuginfo)
-    Path = fetchDebugInfo(ID);
-  else
-    llvm_unreachable("We have already checked that exactly one of the above "
-                     "conditions is true.");
-
-  if (DumpToStdout) {
-    // Print the contents of the artifact.
-    ErrorOr<std::unique_ptr<MemoryBuffer>> Buf = MemoryBuffer::getFile(
-        Path, /*IsText=*/false, /*RequiresNullTerminator=*/false);
-    ExitOnErr(errorCodeToError(Buf.getError()));
-    outs() << Buf.get()->getBuffer();
-  } else
-    // Print the path to the cached artifact file.
-    outs() << Path << "\n";
+
+  std::vector<object::BuildID> IDs;
+  for (const std::string &InputBuildID : InputBuildIDs) {
+    std::string IDString;
+    if (!tryGetFromHex(InputBuildID, IDString)) {
+      errs() << "Build ID " << InputBuildID << " is not a hex string.\n";
+      exit(1);
+    }
+    IDs.emplace_back(IDString.begin(), IDString.end());
+  }
+
+  // Download the debug binaries that are not available locally all at once,
+  // so that the lookups below are answered from the cache.
+  if (IDs.size() > 1 && canUseDebuginfod()) {
+    object::BuildIDFetcher LocalFetcher(DebugFileDirectory);
+    std::vector<object::BuildID> Missing;
+    for (const object::BuildID &ID : IDs)
+      if (!LocalFetcher.fetch(ID))
+        Missing.push_back(ID);
+    prefetchDebuginfo(Missing);
+  }
+
+  for (const object::BuildID &ID : IDs) {
+    std::string Path;
+    if (FetchSource != "")
+      Path = ExitOnErr(getCachedOrDownloadSource(ID, FetchSource));
+    else if (FetchExecutable)
+      Path = ExitOnErr(getCachedOrDownloadExecutable(ID));
+    else if (FetchDebuginfo)
+      Path = fetchDebugInfo(ID);
+    else
+      llvm_unreachable("We have already checked that exactly one of the above "
+                       "conditions is true.");
+
+    if (DumpToStdout) {
+      // Print the contents of the artifact.
+      ErrorOr<std::unique_ptr<MemoryBuffer>> Buf = MemoryBuffer::getFile(
+          Path, /*IsText=*/false, /*RequiresNullTerminator=*/false);
+      ExitOnErr(errorCodeToError(Buf.getError()));
+      outs() << Buf.get()->getBuffer();
+    } else
+      // Print the path to the cached artifact file.
+      outs() << Path << "\n";
+  }
 }
 
 // Find a debug file in local build ID directories and via debuginfod.
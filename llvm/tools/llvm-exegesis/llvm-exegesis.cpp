@@ -47,6 +47,10 @@
 #include <algorithm>
 #include <string>
 
+#ifdef __linux__
+#include <sched.h>
+#endif // __linux__
+
 namespace llvm {
 namespace exegesis {
 
@@ -269,6 +273,14 @@ static cl::list<ValidationEvent> ValidationCounters(
         "counter to validate benchmarking assumptions"),
     cl::CommaSeparated, cl::cat(BenchmarkOptions), ValidationEventOptions());
 
+static cl::opt<int> BenchmarkProcessCPU(
+    "benchmark-process-cpu",
+    cl::desc("The CPU number that the benchmarking process should execute on "
+             "(subprocess execution mode only). Separate llvm-exegesis "
+             "instances pinned to different isolated cores can then measure "
+             "disjoint sets of opcodes concurrently"),
+    cl::cat(BenchmarkOptions), cl::init(-1));
+
 static ExitOnError ExitOnErr("llvm-exegesis error: ");
 
 // Helper function that logs the error(s) and exits.
@@ -418,8 +430,11 @@ static void runBenchmarkConfigurations(
         std::optional<StringRef> DumpFile;
         if (DumpObjectToDisk.getNumOccurrences())
           DumpFile = DumpObjectToDisk;
+        std::optional<int> BenchmarkCPU = std::nullopt;
+        if (BenchmarkProcessCPU != -1)
+          BenchmarkCPU = BenchmarkProcessCPU;
         auto [Err, BenchmarkResult] =
-            Runner.runConfiguration(std::move(RC), DumpFile);
+            Runner.runConfiguration(std::move(RC), DumpFile, BenchmarkCPU);
         if (Err) {
           // Errors from executing the snippets are fine.
           // All other errors are a framework issue and should fail.
@@ -489,6 +504,22 @@ void benchmarkMain() {
     ExitWithError("Dummy perf counters are not supported in the subprocess "
                   "execution mode.");
 
+  if (BenchmarkProcessCPU.getNumOccurrences() &&
+      ExecutionMode != BenchmarkRunner::ExecutionModeE::SubProcess)
+    ExitWithError("The --benchmark-process-cpu flag is only supported in the "
+                  "subprocess execution mode.");
+
+#ifdef __linux__
+  // CPU_SET does not check its argument, so reject CPUs that do not fit in a
+  // cpu_set_t. Whether the CPU can be used is reported by the benchmarking
+  // process when it fails to pin itself.
+  if (BenchmarkProcessCPU.getNumOccurrences() &&
+      (BenchmarkProcessCPU < 0 || BenchmarkProcessCPU >= CPU_SETSIZE))
+    ExitWithError("--benchmark-process-cpu: CPU " +
+                  Twine(BenchmarkProcessCPU.getValue()) +
+                  " is out of range [0, " + Twine(CPU_SETSIZE) + ")");
+#endif // __linux__
+
   const std::unique_ptr<BenchmarkRunner> Runner =
       ExitOnErr(State.getExegesisTarget().createBenchmarkRunner(
           BenchmarkMode, State, BenchmarkPhaseSelector, ExecutionMode,
@@ -103,6 +103,12 @@ static cl::opt<bool>
 // to use all hardware threads or cores in the system.
 static cl::opt<std::string> Threads("thinlto-threads");
 
+static cl::opt<uint64_t> ThinLTOMemoryBudget(
+    "thinlto-memory-budget",
+    cl::desc("Limit the estimated memory of concurrently running ThinLTO "
+             "backends to this many bytes"),
+    cl::init(0));
+
 static cl::list<std::string> SymbolResolutions(
     "r",
     cl::desc("Specify a symbol resolution: filename,symbolname,resolution\n"
@@ -343,6 +349,8 @@ static int run(int argc, char **argv) {
   Conf.StatsFile = StatsFile;
   Conf.PTO.LoopVectorization = Conf.OptLevel > 1;
   Conf.PTO.SLPVectorization = Conf.OptLevel > 1;
+  Conf.ThinLTOImportCacheDir = CacheDir;
+  Conf.ThinLTOMemoryBudget = ThinLTOMemoryBudget;
 
   ThinBackend Backend;
   if (ThinLTODistributedIndexes)
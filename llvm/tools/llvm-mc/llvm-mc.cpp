@@ -75,6 +75,12 @@ static cl::opt<DebugCompressionType> CompressDebugSections(
                clEnumValN(DebugCompressionType::Zstd, "zstd", "Use zstd")),
     cl::cat(MCCategory));
 
+static cl::opt<unsigned> CompressDebugSectionsThreads(
+    "compress-debug-sections-threads", cl::init(1),
+    cl::desc("Number of threads used to compress large debug sections with "
+             "zstd"),
+    cl::cat(MCCategory));
+
 static cl::opt<bool>
     ShowInst("show-inst", cl::desc("Show internal instruction representation"),
              cl::cat(MCCategory));
@@ -356,6 +362,7 @@ int main(int argc, char **argv) {
   cl::ParseCommandLineOptions(argc, argv, "llvm machine code playground\n");
   MCTargetOptions MCOptions = mc::InitMCTargetOptionsFromFlags();
   MCOptions.CompressDebugSections = CompressDebugSections.getValue();
+  MCOptions.CompressDebugSectionsThreads = CompressDebugSectionsThreads;
 
   setDwarfDebugFlags(argc, argv);
   setDwarfDebugProducer();
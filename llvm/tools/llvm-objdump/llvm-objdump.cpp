@@ -723,11 +723,9 @@ public:
       OS << " <unknown>";
       return;
     }
-    std::string Buffer;
-    {
-      raw_string_ostream TempStream(Buffer);
-      IP.printInst(MI, Address.Address, "", STI, TempStream);
-    }
+    SmallString<64> Buffer;
+    raw_svector_ostream TempStream(Buffer);
+    IP.printInst(MI, Address.Address, "", STI, TempStream);
     StringRef Contents(Buffer);
     // Split off bundle attributes
     auto PacketBundle = Contents.rsplit('\n');
@@ -2350,7 +2348,7 @@ disassembleObject(ObjectFile &Obj, const ObjectFile &DbgObj,
               //
               // N.B. Except for XCOFF, we don't walk the relocations in the
               // relocatable case yet.
-              std::vector<const SectionSymbolsTy *> TargetSectionSymbols;
+              SmallVector<const SectionSymbolsTy *, 4> TargetSectionSymbols;
               if (!Obj.isRelocatableObject()) {
                 auto It = llvm::partition_point(
                     SectionAddresses,
@@ -2403,8 +2401,14 @@ disassembleObject(ObjectFile &Obj, const ObjectFile &DbgObj,
               if (TargetSym != nullptr) {
                 uint64_t TargetAddress = TargetSym->Addr;
                 uint64_t Disp = Target - TargetAddress;
-                std::string TargetName = Demangle ? demangle(TargetSym->Name)
-                                                  : TargetSym->Name.str();
+                // Only demangling needs a copy of the name; this runs for
+                // every branch, so avoid allocating otherwise.
+                std::string DemangledName;
+                StringRef TargetName = TargetSym->Name;
+                if (Demangle) {
+                  DemangledName = demangle(TargetSym->Name);
+                  TargetName = DemangledName;
+                }
                 bool RelFixedUp = false;
                 SmallString<32> Val;
 
@@ -981,6 +981,10 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
                    Contexts[End - 1].get());
         Pool.wait();
       }
+      // The merged-from writers still hold their function maps and any
+      // records that failed to merge; free them before the next round so
+      // that peak memory shrinks as the merge proceeds.
+      Contexts.truncate(Mid);
       End = Mid;
       Mid /= 2;
     } while (Mid > 0);
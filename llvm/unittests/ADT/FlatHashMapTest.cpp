@@ -0,0 +1,239 @@
+//===- llvm/unittest/ADT/FlatHashMapTest.cpp - FlatHashMap unit tests -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/FlatHashMap.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <random>
+#include <string>
+
+using namespace llvm;
+
+namespace {
+
+TEST(FlatHashMapTest, EmptyMap) {
+  FlatHashMap<int, int> M;
+  EXPECT_TRUE(M.empty());
+  EXPECT_EQ(0u, M.size());
+  EXPECT_TRUE(M.begin() == M.end());
+  EXPECT_FALSE(M.contains(0));
+  EXPECT_EQ(0u, M.count(0));
+  EXPECT_TRUE(M.find(0) == M.end());
+  EXPECT_EQ(0, M.lookup(0));
+  EXPECT_FALSE(M.erase(0));
+  EXPECT_EQ(0u, M.getMemorySize());
+}
+
+TEST(FlatHashMapTest, InsertFindErase) {
+  FlatHashMap<int, int> M;
+  auto [It, Inserted] = M.insert({1, 10});
+  EXPECT_TRUE(Inserted);
+  EXPECT_EQ(1, It->first);
+  EXPECT_EQ(10, It->second);
+
+  std::tie(It, Inserted) = M.insert({1, 20});
+  EXPECT_FALSE(Inserted);
+  EXPECT_EQ(10, It->second);
+
+  EXPECT_EQ(1u, M.size());
+  EXPECT_EQ(10, M.lookup(1));
+  EXPECT_EQ(10, M.at(1));
+  EXPECT_EQ(10, M[1]);
+  EXPECT_TRUE(M.find(1) == M.begin());
+
+  EXPECT_TRUE(M.erase(1));
+  EXPECT_FALSE(M.erase(1));
+  EXPECT_TRUE(M.empty());
+  EXPECT_TRUE(M.find(1) == M.end());
+  EXPECT_TRUE(M.begin() == M.end());
+}
+
+// Keys that DenseMap reserves as sentinels are ordinary keys here.
+TEST(FlatHashMapTest, SentinelKeys) {
+  FlatHashMap<int, int> M;
+  int Empty = DenseMapInfo<int>::getEmptyKey();
+  int Tombstone = DenseMapInfo<int>::getTombstoneKey();
+  M[Empty] = 1;
+  M[Tombstone] = 2;
+  EXPECT_EQ(2u, M.size());
+  EXPECT_EQ(1, M.lookup(Empty));
+  EXPECT_EQ(2, M.lookup(Tombstone));
+  M.erase(Empty);
+  EXPECT_FALSE(M.contains(Empty));
+  EXPECT_TRUE(M.contains(Tombstone));
+}
+
+TEST(FlatHashMapTest, ManyEntries) {
+  FlatHashMap<unsigned, unsigned> M;
+  DenseMap<unsigned, unsigned> Ref;
+  std::mt19937 Rng(42);
+  for (unsigned I = 0; I != 100000; ++I) {
+    unsigned Key = Rng() % 20000;
+    switch (Rng() % 3) {
+    case 0:
+    case 1:
+      M[Key] = I;
+      Ref[Key] = I;
+      break;
+    case 2:
+      EXPECT_EQ(Ref.erase(Key), M.erase(Key));
+      break;
+    }
+    ASSERT_EQ(Ref.size(), M.size());
+  }
+  for (const auto &[K, V] : Ref)
+    EXPECT_EQ(V, M.lookup(K));
+  unsigned Visited = 0;
+  for (const auto &[K, V] : M) {
+    EXPECT_EQ(Ref.lookup(K), V);
+    ++Visited;
+  }
+  EXPECT_EQ(Ref.size(), Visited);
+}
+
+// Erasing everything and re-inserting must not grow the table without bound.
+TEST(FlatHashMapTest, ChurnDoesNotGrow) {
+  FlatHashMap<unsigned, unsigned> M;
+  for (unsigned I = 0; I != 1000; ++I)
+    M[I] = I;
+  size_t Size = M.getMemorySize();
+  for (unsigned Round = 1; Round != 50; ++Round) {
+    for (unsigned I = 0; I != 1000; ++I)
+      EXPECT_TRUE(M.erase((Round - 1) * 1000 + I));
+    for (unsigned I = 0; I != 1000; ++I)
+      M[Round * 1000 + I] = I;
+    ASSERT_EQ(1000u, M.size());
+  }
+  EXPECT_EQ(Size, M.getMemorySize());
+}
+
+TEST(FlatHashMapTest, EraseIterator) {
+  FlatHashMap<int, int> M;
+  for (int I = 0; I != 100; ++I)
+    M[I] = I;
+  for (auto It = M.begin(), E = M.end(); It != E;) {
+    auto Cur = It++;
+    if (Cur->first % 2)
+      M.erase(Cur);
+  }
+  EXPECT_EQ(50u, M.size());
+  for (int I = 0; I != 100; ++I)
+    EXPECT_EQ(I % 2 == 0, M.contains(I));
+}
+
+TEST(FlatHashMapTest, ReserveTest) {
+  FlatHashMap<int, int> M;
+  M.reserve(1000);
+  size_t Size = M.getMemorySize();
+  EXPECT_NE(0u, Size);
+  for (int I = 0; I != 1000; ++I)
+    M[I] = I;
+  EXPECT_EQ(Size, M.getMemorySize());
+
+  FlatHashMap<int, int> M2(1000);
+  EXPECT_EQ(Size, M2.getMemorySize());
+}
+
+TEST(FlatHashMapTest, ClearTest) {
+  FlatHashMap<int, std::string> M;
+  for (int I = 0; I != 100; ++I)
+    M[I] = std::to_string(I);
+  M.clear();
+  EXPECT_TRUE(M.empty());
+  EXPECT_TRUE(M.begin() == M.end());
+  EXPECT_FALSE(M.contains(5));
+  M[5] = "five";
+  EXPECT_EQ("five", M.lookup(5));
+}
+
+TEST(FlatHashMapTest, CopyAndMove) {
+  FlatHashMap<int, std::string> M;
+  for (int I = 0; I != 100; ++I)
+    M[I] = std::to_string(I);
+
+  FlatHashMap<int, std::string> Copy(M);
+  EXPECT_EQ(100u, Copy.size());
+  EXPECT_EQ("42", Copy.lookup(42));
+  Copy[42] = "x";
+  EXPECT_EQ("42", M.lookup(42));
+
+  FlatHashMap<int, std::string> Moved(std::move(Copy));
+  EXPECT_EQ(100u, Moved.size());
+  EXPECT_EQ("x", Moved.lookup(42));
+
+  FlatHashMap<int, std::string> Assigned;
+  Assigned[1000] = "y";
+  Assigned = M;
+  EXPECT_EQ(100u, Assigned.size());
+  EXPECT_FALSE(Assigned.contains(1000));
+
+  Assigned = std::move(Moved);
+  EXPECT_EQ("x", Assigned.lookup(42));
+
+  swap(Assigned, M);
+  EXPECT_EQ("42", Assigned.lookup(42));
+  EXPECT_EQ("x", M.lookup(42));
+}
+
+TEST(FlatHashMapTest, InitializerListAndRange) {
+  FlatHashMap<int, int> M = {{1, 2}, {3, 4}};
+  EXPECT_EQ(2u, M.size());
+  EXPECT_EQ(4, M.lookup(3));
+
+  std::vector<std::pair<int, int>> Values = {{5, 6}, {7, 8}, {5, 9}};
+  FlatHashMap<int, int> M2(Values.begin(), Values.end());
+  EXPECT_EQ(2u, M2.size());
+  EXPECT_EQ(6, M2.lookup(5));
+}
+
+TEST(FlatHashMapTest, TryEmplaceAndInsertOrAssign) {
+  FlatHashMap<int, std::unique_ptr<int>> M;
+  auto Try1 = M.try_emplace(0, new int(1));
+  EXPECT_TRUE(Try1.second);
+  auto Try2 = M.try_emplace(0, nullptr);
+  EXPECT_FALSE(Try2.second);
+  EXPECT_EQ(Try1.first, Try2.first);
+  EXPECT_EQ(1, *Try2.first->second);
+
+  FlatHashMap<int, int> M2;
+  EXPECT_TRUE(M2.insert_or_assign(1, 2).second);
+  EXPECT_FALSE(M2.insert_or_assign(1, 3).second);
+  EXPECT_EQ(3, M2.lookup(1));
+}
+
+TEST(FlatHashMapTest, StringRefKeys) {
+  FlatHashMap<StringRef, int> M;
+  M["a"] = 1;
+  M[""] = 2;
+  M["abc"] = 3;
+  EXPECT_EQ(3u, M.size());
+  EXPECT_EQ(1, M.lookup("a"));
+  EXPECT_EQ(2, M.lookup(""));
+  EXPECT_EQ(3, M.lookup("abc"));
+  EXPECT_FALSE(M.contains("ab"));
+}
+
+TEST(FlatHashMapTest, ConstIteration) {
+  FlatHashMap<int, int> M;
+  for (int I = 0; I != 10; ++I)
+    M[I] = I * 2;
+  const auto &CM = M;
+  FlatHashMap<int, int>::const_iterator It = M.begin();
+  EXPECT_TRUE(It == CM.begin());
+  int Sum = 0;
+  for (const auto &KV : CM)
+    Sum += KV.second;
+  EXPECT_EQ(90, Sum);
+  EXPECT_TRUE(CM.find(3) != CM.end());
+  EXPECT_EQ(6, CM.find(3)->second);
+}
+
+} // namespace
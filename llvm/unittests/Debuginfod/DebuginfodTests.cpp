@@ -7,11 +7,16 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Debuginfod/Debuginfod.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Debuginfod/HTTPClient.h"
+#include "llvm/Debuginfod/HTTPServer.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Testing/Support/Error.h"
 #include "gtest/gtest.h"
+#include <atomic>
 
 #ifdef _WIN32
 #define setenv(name, var, ignore) _putenv_s(name, var)
@@ -67,3 +72,69 @@ TEST(DebuginfodClient, CacheMiss) {
   // A cache miss with no possible URLs should not create the cache directory.
   EXPECT_FALSE(sys::fs::exists(CacheDir));
 }
+
+// Check that prefetching swallows lookup failures and, like a single cache
+// miss, leaves no cache directory behind when there are no URLs to query.
+TEST(DebuginfodClient, PrefetchMisses) {
+  SmallString<32> CacheDir;
+  ASSERT_NO_ERROR(
+      sys::fs::createUniqueDirectory("debuginfod-unittest", CacheDir));
+  sys::path::append(CacheDir, "cachedir");
+  setenv("DEBUGINFOD_CACHE_PATH", CacheDir.c_str(),
+         /*replace=*/1);
+  setenv("DEBUGINFOD_URLS", "", /*replace=*/1);
+  HTTPClient::initialize();
+  SmallVector<object::BuildID> IDs = {object::parseBuildID("aabbcc"),
+                                      object::parseBuildID("ddeeff")};
+  prefetchDebuginfo(IDs);
+  EXPECT_FALSE(sys::fs::exists(CacheDir));
+}
+
+#if defined(LLVM_ENABLE_HTTPLIB) && defined(LLVM_ENABLE_CURL)
+// Check that prefetched debug binaries land in the cache, so that later
+// lookups are answered without asking the server again.
+TEST(DebuginfodClient, PrefetchHits) {
+  std::atomic<unsigned> NumRequests = 0;
+  HTTPServer Server;
+  EXPECT_THAT_ERROR(Server.get(R"(/buildid/(.*)/debuginfo)",
+                               [&](HTTPServerRequest &Request) {
+                                 ++NumRequests;
+                                 std::string Body =
+                                     "debuginfo " + Request.UrlPathMatches[0];
+                                 Request.setResponse(
+                                     {200u, "application/octet-stream", Body});
+                               }),
+                    Succeeded());
+  Expected<unsigned> PortOrErr = Server.bind();
+  ASSERT_THAT_EXPECTED(PortOrErr, Succeeded());
+  DefaultThreadPool Pool(hardware_concurrency(1));
+  Pool.async([&]() { EXPECT_THAT_ERROR(Server.listen(), Succeeded()); });
+
+  SmallString<32> CacheDir;
+  ASSERT_NO_ERROR(
+      sys::fs::createUniqueDirectory("debuginfod-unittest", CacheDir));
+  setenv("DEBUGINFOD_CACHE_PATH", CacheDir.c_str(),
+         /*replace=*/1);
+  std::string Url = "http://localhost:" + utostr(*PortOrErr);
+  setDefaultDebuginfodUrls({Url});
+  HTTPClient::initialize();
+
+  SmallVector<object::BuildID> IDs = {object::parseBuildID("aabbcc"),
+                                      object::parseBuildID("ddeeff")};
+  prefetchDebuginfo(IDs);
+  EXPECT_EQ(NumRequests, 2u);
+  for (const object::BuildID &ID : IDs) {
+    Expected<std::string> PathOrErr = getCachedOrDownloadDebuginfo(ID);
+    ASSERT_THAT_EXPECTED(PathOrErr, Succeeded());
+    ErrorOr<std::unique_ptr<MemoryBuffer>> BufOrErr =
+        MemoryBuffer::getFile(*PathOrErr);
+    ASSERT_TRUE(BufOrErr);
+    EXPECT_EQ((*BufOrErr)->getBuffer(),
+              "debuginfo " + toHex(ID, /*LowerCase=*/true));
+  }
+  EXPECT_EQ(NumRequests, 2u);
+
+  setDefaultDebuginfodUrls({});
+  Server.stop();
+}
+#endif
@@ -0,0 +1,112 @@
+//===-- llvm/unittest/Debuginfod/RemoteCacheTests.cpp - unit tests --------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Debuginfod/RemoteCache.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Debuginfod/HTTPClient.h"
+#include "llvm/Debuginfod/HTTPServer.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+#if defined(LLVM_ENABLE_HTTPLIB) && defined(LLVM_ENABLE_CURL)
+
+class RemoteCacheTest : public ::testing::Test {
+protected:
+  void SetUp() override { HTTPClient::initialize(); }
+  void TearDown() override { HTTPClient::cleanup(); }
+};
+
+TEST_F(RemoteCacheTest, RemoteHitIsWrittenThrough) {
+  HTTPServer Server;
+  EXPECT_THAT_ERROR(Server.get(R"(/(.*))",
+                               [](HTTPServerRequest &Request) {
+                                 if (Request.UrlPathMatches[0] == "abc")
+                                   Request.setResponse(
+                                       {200u, "application/octet-stream",
+                                        "cached object"});
+                                 else
+                                   Request.setResponse(
+                                       {404u, "text/plain", "missing"});
+                               }),
+                    Succeeded());
+  Expected<unsigned> PortOrErr = Server.bind();
+  ASSERT_THAT_EXPECTED(PortOrErr, Succeeded());
+  DefaultThreadPool Pool(hardware_concurrency(1));
+  Pool.async([&]() { EXPECT_THAT_ERROR(Server.listen(), Succeeded()); });
+
+  unittest::TempDir Dir("remote-cache-test", /*Unique=*/true);
+  std::string Added;
+  RemoteCacheUploader Uploader;
+  Expected<FileCache> CacheOrErr = remoteCache(
+      "Test", "Test", Dir.path(), "http://localhost:" + utostr(*PortOrErr),
+      Uploader,
+      [&](size_t Task, const Twine &ModuleName,
+          std::unique_ptr<MemoryBuffer> MB) { Added = MB->getBuffer().str(); });
+  ASSERT_THAT_EXPECTED(CacheOrErr, Succeeded());
+
+  // A remote hit is added to the client and to the local cache.
+  Expected<AddStreamFn> AddStreamOrErr = (*CacheOrErr)(0, "abc", "module");
+  ASSERT_THAT_EXPECTED(AddStreamOrErr, Succeeded());
+  EXPECT_FALSE(*AddStreamOrErr);
+  EXPECT_EQ(Added, "cached object");
+  SmallString<128> EntryPath(Dir.path());
+  sys::path::append(EntryPath, "llvmcache-abc");
+  EXPECT_TRUE(sys::fs::exists(EntryPath));
+
+  // A remote miss asks the client to produce the entry.
+  AddStreamOrErr = (*CacheOrErr)(0, "def", "module");
+  ASSERT_THAT_EXPECTED(AddStreamOrErr, Succeeded());
+  EXPECT_TRUE(*AddStreamOrErr);
+  Server.stop();
+}
+
+TEST_F(RemoteCacheTest, FailedUploadIsReported) {
+  // The server only answers GET requests, so publishing an entry fails.
+  HTTPServer Server;
+  EXPECT_THAT_ERROR(Server.get(R"(/(.*))",
+                               [](HTTPServerRequest &Request) {
+                                 Request.setResponse(
+                                     {404u, "text/plain", "missing"});
+                               }),
+                    Succeeded());
+  Expected<unsigned> PortOrErr = Server.bind();
+  ASSERT_THAT_EXPECTED(PortOrErr, Succeeded());
+  DefaultThreadPool Pool(hardware_concurrency(1));
+  Pool.async([&]() { EXPECT_THAT_ERROR(Server.listen(), Succeeded()); });
+
+  unittest::TempDir Dir("remote-cache-test", /*Unique=*/true);
+  RemoteCacheUploader Uploader;
+  Expected<FileCache> CacheOrErr =
+      remoteCache("Test", "Test", Dir.path(),
+                  "http://localhost:" + utostr(*PortOrErr), Uploader);
+  ASSERT_THAT_EXPECTED(CacheOrErr, Succeeded());
+
+  Expected<AddStreamFn> AddStreamOrErr = (*CacheOrErr)(0, "abc", "module");
+  ASSERT_THAT_EXPECTED(AddStreamOrErr, Succeeded());
+  ASSERT_TRUE(*AddStreamOrErr);
+  Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+      (*AddStreamOrErr)(0, "module");
+  ASSERT_THAT_EXPECTED(StreamOrErr, Succeeded());
+  *(*StreamOrErr)->OS << "new object";
+  StreamOrErr->reset();
+
+  // The entry is committed locally even though the upload failed.
+  SmallString<128> EntryPath(Dir.path());
+  sys::path::append(EntryPath, "llvmcache-abc");
+  EXPECT_TRUE(sys::fs::exists(EntryPath));
+  EXPECT_THAT_ERROR(Uploader.wait(), Failed());
+  Server.stop();
+}
+
+#endif
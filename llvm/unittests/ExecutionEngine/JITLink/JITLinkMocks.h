@@ -165,6 +165,10 @@ public:
     return true;
   }
 
+  bool shouldApplyFixupsInParallel() const override {
+    return ApplyFixupsInParallel;
+  }
+
   llvm::jitlink::LinkGraphPassFunction
   getMarkLivePass(const llvm::Triple &TT) const override {
     return MarkLivePass ? llvm::jitlink::LinkGraphPassFunction(
@@ -201,6 +205,7 @@ public:
   llvm::unique_function<llvm::Error(llvm::jitlink::LinkGraph &,
                                     llvm::jitlink::PassConfiguration &)>
       ModifyPassConfig;
+  bool ApplyFixupsInParallel = false;
 
   std::vector<llvm::jitlink::JITLinkMemoryManager::FinalizedAlloc>
       FinalizedAllocs;
@@ -0,0 +1,76 @@
+//===------- ParallelFixupTests.cpp - Test parallel fixup application -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "JITLinkMocks.h"
+#include "llvm/ExecutionEngine/JITLink/MachO_x86_64.h"
+#include "llvm/ExecutionEngine/JITLink/x86_64.h"
+#include "llvm/Support/Endian.h"
+
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+using namespace llvm::jitlink;
+
+// Larger than the threshold above which JITLink fixes up blocks in parallel.
+static constexpr size_t NumBlocks = 5000;
+
+// Links a graph of NumBlocks pointer-sized blocks, each pointing at the next
+// one, and returns the number of blocks whose fixup is wrong.
+static size_t linkPointerChain(bool ApplyFixupsInParallel) {
+  auto G = std::make_unique<LinkGraph>("foo", Triple("x86_64-apple-darwin"), 8,
+                                       llvm::endianness::little,
+                                       getGenericEdgeKindName);
+  static const char Zeros[8] = {};
+  auto &Sec =
+      G->createSection("__data", orc::MemProt::Read | orc::MemProt::Write);
+  std::vector<Symbol *> Syms;
+  for (size_t I = 0; I != NumBlocks; ++I) {
+    auto &B = G->createContentBlock(Sec, ArrayRef<char>(Zeros, 8),
+                                    orc::ExecutorAddr(0x10000 + 8 * I), 8, 0);
+    Syms.push_back(&G->addAnonymousSymbol(B, 0, 8, /*IsCallable=*/false,
+                                          /*IsLive=*/true));
+  }
+  for (size_t I = 0; I != NumBlocks; ++I)
+    Syms[I]->getBlock().addEdge(x86_64::Pointer64, 0,
+                                *Syms[(I + 1) % NumBlocks], 0);
+
+  size_t NumWrong = NumBlocks;
+  Error Err = Error::success();
+  auto Ctx = makeMockContext(
+      JoinErrorsInto(Err), defaultMemMgrSetup, [&](MockJITLinkContext &Ctx) {
+        Ctx.ApplyFixupsInParallel = ApplyFixupsInParallel;
+        Ctx.ModifyPassConfig = [&](LinkGraph &G, PassConfiguration &Config) {
+          Config.PostFixupPasses.push_back([&](LinkGraph &G) {
+            NumWrong = 0;
+            for (size_t I = 0; I != NumBlocks; ++I) {
+              uint64_t Value = support::endian::read64le(
+                  Syms[I]->getBlock().getContent().data());
+              if (Value != Syms[(I + 1) % NumBlocks]->getAddress().getValue())
+                ++NumWrong;
+            }
+            return Error::success();
+          });
+          return Error::success();
+        };
+      });
+
+  link_MachO_x86_64(std::move(G), std::move(Ctx));
+
+  EXPECT_THAT_ERROR(std::move(Err), Succeeded());
+  return NumWrong;
+}
+
+TEST(ParallelFixupTest, SerialByDefault) {
+  EXPECT_EQ(linkPointerChain(/*ApplyFixupsInParallel=*/false), 0u);
+}
+
+TEST(ParallelFixupTest, LargeGraphInParallel) {
+  EXPECT_EQ(linkPointerChain(/*ApplyFixupsInParallel=*/true), 0u);
+}
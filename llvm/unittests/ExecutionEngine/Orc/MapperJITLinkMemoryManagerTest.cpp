@@ -173,4 +173,47 @@ TEST(MapperJITLinkMemoryManagerTest, Coalescing) {
   EXPECT_THAT_ERROR(std::move(Err4), Succeeded());
 }
 
+TEST(MapperJITLinkMemoryManagerTest, Stats) {
+  auto Mapper = cantFail(InProcessMemoryMapper::Create());
+  size_t PageSize = Mapper->getPageSize();
+  size_t Reservation = 16 * 1024 * 1024;
+  auto MemMgr = std::make_unique<MapperJITLinkMemoryManager>(
+      Reservation, std::move(Mapper));
+
+  auto S = MemMgr->getStats();
+  EXPECT_EQ(S.AllocatedBytes, 0U);
+  EXPECT_EQ(S.AvailableBytes, 0U);
+
+  auto SSA1 = jitlink::SimpleSegmentAlloc::Create(
+      *MemMgr, nullptr, {{MemProt::Read, {1024, Align(1)}}});
+  EXPECT_THAT_EXPECTED(SSA1, Succeeded());
+  auto FA1 = SSA1->finalize();
+  EXPECT_THAT_EXPECTED(FA1, Succeeded());
+
+  auto SSA2 = jitlink::SimpleSegmentAlloc::Create(
+      *MemMgr, nullptr, {{MemProt::Read, {1024, Align(1)}}});
+  EXPECT_THAT_EXPECTED(SSA2, Succeeded());
+  auto FA2 = SSA2->finalize();
+  EXPECT_THAT_EXPECTED(FA2, Succeeded());
+
+  S = MemMgr->getStats();
+  EXPECT_EQ(S.AllocatedBytes, 2 * PageSize);
+  EXPECT_EQ(S.AvailableBytes, Reservation - 2 * PageSize);
+  EXPECT_EQ(S.NumAvailableRanges, 1U);
+  EXPECT_EQ(S.LargestAvailableRange, S.AvailableBytes);
+
+  // Freeing the first allocation leaves a hole in front of the second.
+  EXPECT_THAT_ERROR(MemMgr->deallocate(std::move(*FA1)), Succeeded());
+  S = MemMgr->getStats();
+  EXPECT_EQ(S.AllocatedBytes, PageSize);
+  EXPECT_EQ(S.AvailableBytes, Reservation - PageSize);
+  EXPECT_EQ(S.NumAvailableRanges, 2U);
+  EXPECT_EQ(S.LargestAvailableRange, Reservation - 2 * PageSize);
+
+  EXPECT_THAT_ERROR(MemMgr->deallocate(std::move(*FA2)), Succeeded());
+  S = MemMgr->getStats();
+  EXPECT_EQ(S.AllocatedBytes, 0U);
+  EXPECT_EQ(S.NumAvailableRanges, 1U);
+}
+
 } // namespace
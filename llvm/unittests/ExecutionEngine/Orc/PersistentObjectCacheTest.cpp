@@ -0,0 +1,97 @@
+//===- PersistentObjectCacheTest.cpp - Tests for PersistentObjectCache ---===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/PersistentObjectCache.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+std::unique_ptr<Module> makeModule(LLVMContext &Ctx, int RetVal) {
+  auto M = std::make_unique<Module>("M", Ctx);
+  auto *FTy = FunctionType::get(Type::getInt32Ty(Ctx), false);
+  auto *F = Function::Create(FTy, GlobalValue::ExternalLinkage, "f", *M);
+  IRBuilder<> B(BasicBlock::Create(Ctx, "entry", F));
+  B.CreateRet(B.getInt32(RetVal));
+  return M;
+}
+
+TEST(PersistentObjectCacheTest, StoreAndLoad) {
+  unittest::TempDir Dir("orc-object-cache", /*Unique=*/true);
+  LLVMContext Ctx;
+  auto M = makeModule(Ctx, 1);
+
+  auto Cache = PersistentObjectCache::Create(Dir.path());
+  ASSERT_THAT_EXPECTED(Cache, Succeeded());
+  EXPECT_EQ(nullptr, (*Cache)->getObject(M.get()));
+  EXPECT_EQ(0u, (*Cache)->getNumHits());
+  EXPECT_EQ(1u, (*Cache)->getNumMisses());
+
+  auto Obj = MemoryBuffer::getMemBuffer("fake object", "obj");
+  (*Cache)->notifyObjectCompiled(M.get(), Obj->getMemBufferRef());
+
+  auto Loaded = (*Cache)->getObject(M.get());
+  ASSERT_NE(nullptr, Loaded);
+  EXPECT_EQ("fake object", Loaded->getBuffer());
+  EXPECT_EQ(1u, (*Cache)->getNumHits());
+
+  // A new cache on the same directory sees the entry, as after a restart.
+  auto Cache2 = PersistentObjectCache::Create(Dir.path());
+  ASSERT_THAT_EXPECTED(Cache2, Succeeded());
+  EXPECT_NE(nullptr, (*Cache2)->getObject(M.get()));
+}
+
+TEST(PersistentObjectCacheTest, KeyCoversIRAndExtraKey) {
+  unittest::TempDir Dir("orc-object-cache", /*Unique=*/true);
+  LLVMContext Ctx;
+  auto M1 = makeModule(Ctx, 1);
+  auto M2 = makeModule(Ctx, 2);
+
+  auto Cache = PersistentObjectCache::Create(Dir.path(), "cpu=a");
+  ASSERT_THAT_EXPECTED(Cache, Succeeded());
+  EXPECT_EQ(nullptr, (*Cache)->getObject(M1.get()));
+  auto Obj = MemoryBuffer::getMemBuffer("object for M1", "obj");
+  (*Cache)->notifyObjectCompiled(M1.get(), Obj->getMemBufferRef());
+
+  EXPECT_NE(nullptr, (*Cache)->getObject(M1.get()));
+  EXPECT_EQ(nullptr, (*Cache)->getObject(M2.get()));
+
+  auto OtherTarget = PersistentObjectCache::Create(Dir.path(), "cpu=b");
+  ASSERT_THAT_EXPECTED(OtherTarget, Succeeded());
+  EXPECT_EQ(nullptr, (*OtherTarget)->getObject(M1.get()));
+}
+
+// The entry is stored under the key computed at lookup, even if the module
+// was changed in between, as codegen passes do.
+TEST(PersistentObjectCacheTest, KeyComputedBeforeCodegen) {
+  unittest::TempDir Dir("orc-object-cache", /*Unique=*/true);
+  LLVMContext Ctx;
+  auto M = makeModule(Ctx, 1);
+
+  auto Cache = PersistentObjectCache::Create(Dir.path());
+  ASSERT_THAT_EXPECTED(Cache, Succeeded());
+  EXPECT_EQ(nullptr, (*Cache)->getObject(M.get()));
+
+  auto *F = M->getFunction("f");
+  F->addFnAttr(Attribute::NoUnwind);
+  auto Obj = MemoryBuffer::getMemBuffer("object", "obj");
+  (*Cache)->notifyObjectCompiled(M.get(), Obj->getMemBufferRef());
+
+  auto Fresh = makeModule(Ctx, 1);
+  EXPECT_NE(nullptr, (*Cache)->getObject(Fresh.get()));
+}
+
+} // end anonymous namespace
@@ -0,0 +1,150 @@
+//===- SpeculationTraceTest.cpp - Tests for speculation trace replay ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h"
+#include "llvm/ExecutionEngine/Orc/IndirectionUtils.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/ExecutionEngine/Orc/LazyReexports.h"
+#include "llvm/ExecutionEngine/Orc/Speculation.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+/// Stands in for codegen: records the functions it is asked to emit and
+/// resolves them to fake addresses.
+class RecordingIRLayer : public IRLayer {
+public:
+  RecordingIRLayer(ExecutionSession &ES) : IRLayer(ES, ManglingOpts) {}
+
+  void emit(std::unique_ptr<MaterializationResponsibility> R,
+            ThreadSafeModule TSM) override {
+    SymbolMap Symbols;
+    for (auto &KV : R->getSymbols()) {
+      if (KV.second.isCallable())
+        Emitted.push_back((*KV.first).str());
+      Symbols[KV.first] = {NextAddr, KV.second};
+      NextAddr += 0x10;
+    }
+    cantFail(R->notifyResolved(Symbols));
+    cantFail(R->notifyEmitted({}));
+  }
+
+  std::vector<std::string> Emitted;
+
+private:
+  IRSymbolMapper::ManglingOptions ManglingOpts;
+  ExecutorAddr NextAddr{0x1000};
+};
+
+ThreadSafeModule makeModule() {
+  auto Ctx = std::make_unique<LLVMContext>();
+  auto M = std::make_unique<Module>("M", *Ctx);
+  auto *FTy = FunctionType::get(Type::getInt32Ty(*Ctx), false);
+  for (StringRef Name : {"f", "g"}) {
+    auto *F = Function::Create(FTy, GlobalValue::ExternalLinkage, Name, *M);
+    IRBuilder<> B(BasicBlock::Create(*Ctx, "entry", F));
+    B.CreateRet(B.getInt32(0));
+  }
+  return ThreadSafeModule(std::move(M), std::move(Ctx));
+}
+
+/// One run of a program: a session whose "main" dylib is compiled lazily by a
+/// CompileOnDemandLayer on top of a RecordingIRLayer.
+struct LazySession {
+  ExecutionSession ES{std::make_unique<UnsupportedExecutorProcessControl>()};
+  RecordingIRLayer BaseLayer{ES};
+  std::unique_ptr<LazyCallThroughManager> LCTM;
+  std::unique_ptr<SpeculationTraceRecorder> Recorder;
+  std::unique_ptr<CompileOnDemandLayer> CODLayer;
+  JITDylib &JD = ES.createBareJITDylib("main");
+
+  ~LazySession() { cantFail(ES.endSession()); }
+
+  /// Returns false if lazy compilation isn't supported on the host.
+  bool init(const Triple &TT, StringRef TracePath) {
+    auto LCTMOrErr = createLocalLazyCallThroughManager(TT, ES, ExecutorAddr());
+    if (!LCTMOrErr) {
+      consumeError(LCTMOrErr.takeError());
+      return false;
+    }
+    LCTM = std::move(*LCTMOrErr);
+
+    IRLayer *Layer = &BaseLayer;
+    if (!TracePath.empty()) {
+      auto RecorderOrErr =
+          SpeculationTraceRecorder::Create(ES, BaseLayer, TracePath);
+      if (!RecorderOrErr) {
+        ADD_FAILURE() << toString(RecorderOrErr.takeError());
+        return false;
+      }
+      Recorder = std::move(*RecorderOrErr);
+      Layer = Recorder.get();
+    }
+    CODLayer = std::make_unique<CompileOnDemandLayer>(
+        ES, *Layer, *LCTM, createLocalIndirectStubsManagerBuilder(TT));
+    CODLayer->setPartitionFunction(CompileOnDemandLayer::compileRequested);
+    cantFail(CODLayer->add(JD, makeModule()));
+    return true;
+  }
+
+  /// Does what a call through the lazy stub for \p Name would do.
+  void compile(StringRef Name) {
+    cantFail(ES.lookup({&JD}, Name));
+    auto *ImplJD = ES.getJITDylibByName("main.impl");
+    ASSERT_NE(ImplJD, nullptr);
+    cantFail(ES.lookup({ImplJD}, Name));
+  }
+};
+
+TEST(SpeculationTraceTest, RecordAndReplayThroughCODLayer) {
+  auto JTMB = JITTargetMachineBuilder::detectHost();
+  if (!JTMB) {
+    consumeError(JTMB.takeError());
+    GTEST_SKIP();
+  }
+  const Triple &TT = JTMB->getTargetTriple();
+
+  unittest::TempDir Dir("orc-speculation-trace", /*Unique=*/true);
+  SmallString<128> TracePath(Dir.path());
+  sys::path::append(TracePath, "trace");
+
+  {
+    LazySession Record;
+    if (!Record.init(TT, TracePath))
+      GTEST_SKIP();
+    Record.compile("g");
+    Record.compile("f");
+    EXPECT_EQ(Record.BaseLayer.Emitted, (std::vector<std::string>{"g", "f"}));
+  }
+
+  // The trace names the user's dylib, which exists on the next start.
+  auto Trace = MemoryBuffer::getFile(TracePath, /*IsText=*/true);
+  ASSERT_TRUE(!!Trace);
+  EXPECT_EQ((*Trace)->getBuffer(), "main\tg\nmain\tf\n");
+
+  // After a restart, replaying compiles the functions in trace order without
+  // anything calling them.
+  LazySession Replay;
+  if (!Replay.init(TT, ""))
+    GTEST_SKIP();
+  EXPECT_TRUE(Replay.BaseLayer.Emitted.empty());
+  EXPECT_THAT_ERROR(replaySpeculationTrace(Replay.ES, TracePath), Succeeded());
+  EXPECT_EQ(Replay.BaseLayer.Emitted, (std::vector<std::string>{"g", "f"}));
+}
+
+} // namespace
@@ -306,4 +306,24 @@ TEST_F(SpecialCaseListTest, Version2) {
   EXPECT_TRUE(SCL->inSection("sect2", "fun", "bar"));
   EXPECT_FALSE(SCL->inSection("sect3", "fun", "bar"));
 }
+
+TEST_F(SpecialCaseListTest, LiteralsAndPrefixes) {
+  std::unique_ptr<SpecialCaseList> SCL = makeSpecialCaseList("fun:foo\n"
+                                                             "fun:foobar*\n"
+                                                             "fun:ba*\n"
+                                                             "fun:baz?\n"
+                                                             "fun:qu\\*x\n"
+                                                             "fun:foo\n");
+  EXPECT_EQ(1u, SCL->inSectionBlame("", "fun", "foo"));
+  EXPECT_EQ(0u, SCL->inSectionBlame("", "fun", "fo"));
+  EXPECT_EQ(0u, SCL->inSectionBlame("", "fun", "fooba"));
+  EXPECT_EQ(2u, SCL->inSectionBlame("", "fun", "foobar"));
+  EXPECT_EQ(2u, SCL->inSectionBlame("", "fun", "foobarbaz"));
+  EXPECT_EQ(3u, SCL->inSectionBlame("", "fun", "ba"));
+  EXPECT_EQ(3u, SCL->inSectionBlame("", "fun", "bat"));
+  EXPECT_TRUE(SCL->inSection("", "fun", "bazz"));
+  EXPECT_EQ(0u, SCL->inSectionBlame("", "fun", "b"));
+  EXPECT_EQ(5u, SCL->inSectionBlame("", "fun", "qu*x"));
+  EXPECT_EQ(0u, SCL->inSectionBlame("", "fun", "quux"));
+}
 }
@@ -274,4 +274,17 @@ TEST(SuffixTreeTest, TestSubstringRepeatsWithLeafDescendants) {
   }
 }
 
+// Node memory is reported for every node in the tree, including the root.
+TEST(SuffixTreeTest, NodeMemorySize) {
+  std::vector<unsigned> Small = {1, 2, 3};
+  std::vector<unsigned> Large;
+  for (unsigned I = 0; I != 1000; ++I)
+    Large.push_back(I % 7);
+  SuffixTree SmallST(Small);
+  SuffixTree LargeST(Large);
+  EXPECT_GE(SmallST.getNodeMemorySize(),
+            sizeof(SuffixTreeInternalNode) + 3 * sizeof(SuffixTreeLeafNode));
+  EXPECT_GT(LargeST.getNodeMemorySize(), SmallST.getNodeMemorySize());
+}
+
 } // namespace
@@ -2125,6 +2125,48 @@ TEST_F(VFSFromYAMLTest, CaseSensitive) {
   EXPECT_EQ(0, NumDiagnostics);
 }
 
+TEST_F(VFSFromYAMLTest, LargeDirectory) {
+  IntrusiveRefCntPtr<DummyFileSystem> Lower(new DummyFileSystem());
+  Lower->addRegularFile("//root/foo/bar/a");
+  Lower->addRegularFile("//root/foo/bar/b");
+  // Enough entries for the directory to be looked up by name, including two
+  // that only differ in case.
+  std::string Contents;
+  for (unsigned I = 0; I != 100; ++I)
+    Contents += "{ 'type': 'file', 'name': 'f" + std::to_string(I) +
+                "', 'external-contents': '//root/foo/bar/a' },\n";
+  IntrusiveRefCntPtr<vfs::FileSystem> FS = getFromYAMLString(
+      "{ 'case-sensitive': 'false',\n"
+      "  'roots': [\n"
+      "{\n"
+      "  'type': 'directory',\n"
+      "  'name': '//root/',\n"
+      "  'contents': [ " +
+          Contents +
+          "                { 'type': 'file', 'name': 'XX',\n"
+          "                  'external-contents': '//root/foo/bar/b' },\n"
+          "                { 'type': 'file', 'name': 'xx',\n"
+          "                  'external-contents': '//root/foo/bar/a' }\n"
+          "              ]\n"
+          "}]}",
+      Lower);
+  ASSERT_NE(FS.get(), nullptr);
+
+  ErrorOr<vfs::Status> S = FS->status("//root/f42");
+  ASSERT_FALSE(S.getError());
+  EXPECT_EQ("//root/foo/bar/a", S->getName());
+  S = FS->status("//root/F99");
+  ASSERT_FALSE(S.getError());
+  EXPECT_EQ(FS->status("//root/f100").getError(),
+            llvm::errc::no_such_file_or_directory);
+
+  // The first entry that matches wins.
+  S = FS->status("//root/xx");
+  ASSERT_FALSE(S.getError());
+  EXPECT_EQ("//root/foo/bar/b", S->getName());
+  EXPECT_EQ(0, NumDiagnostics);
+}
+
 TEST_F(VFSFromYAMLTest, IllegalVFSFile) {
   IntrusiveRefCntPtr<DummyFileSystem> Lower(new DummyFileSystem());
 
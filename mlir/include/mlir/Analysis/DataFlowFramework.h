@@ -18,6 +18,7 @@
 
 #include "mlir/IR/Operation.h"
 #include "mlir/Support/StorageUniquer.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/TypeName.h"
@@ -264,8 +265,12 @@ public:
   /// Each item is processed by invoking the child analysis at the program
   /// point.
   using WorkItem = std::pair<ProgramPoint, DataFlowAnalysis *>;
-  /// Push a work item onto the worklist.
-  void enqueue(WorkItem item) { worklist.push(std::move(item)); }
+  /// Push a work item onto the worklist, unless it is already waiting to be
+  /// processed: visiting it once reads the latest states anyway.
+  void enqueue(WorkItem item) {
+    if (pendingItems.insert(item).second)
+      worklist.push(std::move(item));
+  }
 
   /// Get the state associated with the given program point. If it does not
   /// exist, create an uninitialized state.
@@ -288,6 +293,10 @@ private:
   /// quickly degenerate to quadratic due to propagation of state updates.
   std::queue<WorkItem> worklist;
 
+  /// The work items currently on the worklist. Dependents of frequently
+  /// updated states would otherwise be queued many times over.
+  DenseSet<WorkItem> pendingItems;
+
   /// Type-erased instances of the children analyses.
   SmallVector<std::unique_ptr<DataFlowAnalysis>> childAnalyses;
 
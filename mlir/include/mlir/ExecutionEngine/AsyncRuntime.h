@@ -155,6 +155,14 @@ mlirAsyncRuntimeAwaitAllInGroupAndExecute(AsyncGroup *, CoroHandle, CoroResume);
 extern "C" MLIR_ASYNC_RUNTIME_EXPORT int64_t
 mlirAsyncRuntimGetNumWorkerThreads();
 
+// Returns the number of tasks submitted to the threadpool so far.
+extern "C" MLIR_ASYNC_RUNTIME_EXPORT int64_t
+mlirAsyncRuntimeGetNumTasksSpawned();
+
+// Returns the number of awaits that blocked the caller thread so far.
+extern "C" MLIR_ASYNC_RUNTIME_EXPORT int64_t
+mlirAsyncRuntimeGetNumBlockingAwaits();
+
 //===----------------------------------------------------------------------===//
 // Small async runtime support library for testing.
 //===----------------------------------------------------------------------===//
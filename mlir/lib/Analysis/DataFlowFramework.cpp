@@ -100,6 +100,8 @@ LogicalResult DataFlowSolver::initializeAndRun(Operation *top) {
     while (!worklist.empty()) {
       auto [point, analysis] = worklist.front();
       worklist.pop();
+      // Updates made while visiting may need the item to be visited again.
+      pendingItems.erase({point, analysis});
 
       DATAFLOW_DEBUG(llvm::dbgs() << "Invoking '" << analysis->debugName
                                   << "' on: " << point << "\n");
@@ -59,6 +59,22 @@ public:
 
   llvm::ThreadPoolInterface &getThreadPool() { return threadPool; }
 
+  // Runtime counters: the number of tasks submitted to the thread pool, and
+  // the number of awaits that had to block the caller thread.
+  int64_t getNumTasksSpawned() {
+    return numTasksSpawned.load(std::memory_order_relaxed);
+  }
+  void addNumTasksSpawned() {
+    numTasksSpawned.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  int64_t getNumBlockingAwaits() {
+    return numBlockingAwaits.load(std::memory_order_relaxed);
+  }
+  void addNumBlockingAwaits() {
+    numBlockingAwaits.fetch_add(1, std::memory_order_relaxed);
+  }
+
 private:
   friend class RefCounted;
 
@@ -72,6 +88,8 @@ private:
   }
 
   std::atomic<int64_t> numRefCountedObjects;
+  std::atomic<int64_t> numTasksSpawned{0};
+  std::atomic<int64_t> numBlockingAwaits{0};
   llvm::DefaultThreadPool threadPool;
 };
 
@@ -368,22 +386,28 @@ extern "C" bool mlirAsyncRuntimeIsGroupError(AsyncGroup *group) {
 
 extern "C" void mlirAsyncRuntimeAwaitToken(AsyncToken *token) {
   std::unique_lock<std::mutex> lock(token->mu);
-  if (!State(token->state).isAvailableOrError())
+  if (!State(token->state).isAvailableOrError()) {
+    getDefaultAsyncRuntime()->addNumBlockingAwaits();
     token->cv.wait(
         lock, [token] { return State(token->state).isAvailableOrError(); });
+  }
 }
 
 extern "C" void mlirAsyncRuntimeAwaitValue(AsyncValue *value) {
   std::unique_lock<std::mutex> lock(value->mu);
-  if (!State(value->state).isAvailableOrError())
+  if (!State(value->state).isAvailableOrError()) {
+    getDefaultAsyncRuntime()->addNumBlockingAwaits();
     value->cv.wait(
         lock, [value] { return State(value->state).isAvailableOrError(); });
+  }
 }
 
 extern "C" void mlirAsyncRuntimeAwaitAllInGroup(AsyncGroup *group) {
   std::unique_lock<std::mutex> lock(group->mu);
-  if (group->pendingTokens != 0)
+  if (group->pendingTokens != 0) {
+    getDefaultAsyncRuntime()->addNumBlockingAwaits();
     group->cv.wait(lock, [group] { return group->pendingTokens == 0; });
+  }
 }
 
 // Returns a pointer to the storage owned by the async value.
@@ -394,6 +418,7 @@ extern "C" ValueStorage mlirAsyncRuntimeGetValueStorage(AsyncValue *value) {
 
 extern "C" void mlirAsyncRuntimeExecute(CoroHandle handle, CoroResume resume) {
   auto *runtime = getDefaultAsyncRuntime();
+  runtime->addNumTasksSpawned();
   runtime->getThreadPool().async([handle, resume]() { (*resume)(handle); });
 }
 
@@ -440,6 +465,14 @@ extern "C" int64_t mlirAsyncRuntimGetNumWorkerThreads() {
   return getDefaultAsyncRuntime()->getThreadPool().getMaxConcurrency();
 }
 
+extern "C" int64_t mlirAsyncRuntimeGetNumTasksSpawned() {
+  return getDefaultAsyncRuntime()->getNumTasksSpawned();
+}
+
+extern "C" int64_t mlirAsyncRuntimeGetNumBlockingAwaits() {
+  return getDefaultAsyncRuntime()->getNumBlockingAwaits();
+}
+
 //===----------------------------------------------------------------------===//
 // Small async runtime support library for testing.
 //===----------------------------------------------------------------------===//
@@ -513,6 +546,10 @@ void __mlir_execution_engine_init(llvm::StringMap<void *> &exportSymbols) {
                &mlir::runtime::mlirAsyncRuntimeAwaitAllInGroupAndExecute);
   exportSymbol("mlirAsyncRuntimGetNumWorkerThreads",
                &mlir::runtime::mlirAsyncRuntimGetNumWorkerThreads);
+  exportSymbol("mlirAsyncRuntimeGetNumTasksSpawned",
+               &mlir::runtime::mlirAsyncRuntimeGetNumTasksSpawned);
+  exportSymbol("mlirAsyncRuntimeGetNumBlockingAwaits",
+               &mlir::runtime::mlirAsyncRuntimeGetNumBlockingAwaits);
   exportSymbol("mlirAsyncRuntimePrintCurrentThreadId",
                &mlir::runtime::mlirAsyncRuntimePrintCurrentThreadId);
 }
@@ -15,6 +15,10 @@
 
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include <chrono>
 
 namespace mlir {
 #define GEN_PASS_DEF_CANONICALIZER
@@ -24,6 +28,53 @@ namespace mlir {
 using namespace mlir;
 
 namespace {
+/// A listener that records how often each pattern was attempted, how often it
+/// succeeded, and the time spent in it.
+struct PatternProfileListener : public RewriterBase::Listener {
+  struct Entry {
+    uint64_t numAttempts = 0;
+    uint64_t numSuccesses = 0;
+    std::chrono::steady_clock::duration time{};
+  };
+
+  void notifyPatternBegin(const Pattern &pattern, Operation *op) override {
+    start = std::chrono::steady_clock::now();
+  }
+
+  void notifyPatternEnd(const Pattern &pattern,
+                        LogicalResult status) override {
+    StringRef name = pattern.getDebugName();
+    if (name.empty())
+      name = "<unnamed>";
+    Entry &entry = entries[name];
+    ++entry.numAttempts;
+    if (succeeded(status))
+      ++entry.numSuccesses;
+    entry.time += std::chrono::steady_clock::now() - start;
+  }
+
+  /// Print the profile, most expensive patterns first.
+  void print(raw_ostream &os, StringRef opName) {
+    auto sorted = entries.takeVector();
+    llvm::stable_sort(sorted, [](const auto &lhs, const auto &rhs) {
+      return lhs.second.time > rhs.second.time;
+    });
+    os << "===- Canonicalizer pattern profile: " << opName << " -===\n";
+    os << "   Time (ms)  Attempts  Successes  Pattern\n";
+    for (const auto &[name, entry] : sorted) {
+      double ms =
+          std::chrono::duration<double, std::milli>(entry.time).count();
+      os << llvm::format("%12.3f  %8llu  %9llu  ", ms,
+                         (unsigned long long)entry.numAttempts,
+                         (unsigned long long)entry.numSuccesses)
+         << name << "\n";
+    }
+  }
+
+  llvm::MapVector<StringRef, Entry> entries;
+  std::chrono::steady_clock::time_point start;
+};
+
 /// Canonicalize operations in nested regions.
 struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
   Canonicalizer() = default;
@@ -59,8 +110,22 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     return success();
   }
   void runOnOperation() override {
+    GreedyRewriteConfig runConfig = config;
+    PatternProfileListener profile;
+    // The profile takes the listener slot, so it is not collected when the
+    // client configured a listener of its own.
+    bool profiling = printPatternProfile && !runConfig.listener;
+    if (profiling)
+      runConfig.listener = &profile;
     LogicalResult converged =
-        applyPatternsAndFoldGreedily(getOperation(), *patterns, config);
+        applyPatternsAndFoldGreedily(getOperation(), *patterns, runConfig);
+    if (profiling) {
+      // Print in one write: pass instances may run on several threads.
+      std::string str;
+      llvm::raw_string_ostream os(str);
+      profile.print(os, getOperation()->getName().getStringRef());
+      llvm::errs() << os.str();
+    }
     // Canonicalization is best-effort. Non-convergence is not a pass failure.
     if (testConvergence && failed(converged))
       signalPassFailure();
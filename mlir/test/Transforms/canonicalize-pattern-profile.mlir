@@ -0,0 +1,25 @@
+// RUN: mlir-opt %s --canonicalize="print-pattern-profile" -o /dev/null 2>&1 | FileCheck %s
+// RUN: mlir-opt %s --canonicalize="print-pattern-profile" 2>/dev/null | FileCheck %s --check-prefix=IR
+// RUN: mlir-opt %s --canonicalize 2>&1 | FileCheck %s --check-prefix=NOPROFILE
+
+// The profile has one table per operation the pass ran on; every pattern that
+// was attempted has a row with its time, attempts and successes.
+
+// CHECK:      ===- Canonicalizer pattern profile: builtin.module -===
+// CHECK-NEXT:    Time (ms)  Attempts  Successes  Pattern
+// CHECK:      {{^ *[0-9]+\.[0-9]{3} +[1-9][0-9]* +[1-9][0-9]*  .*AddIAddConstant$}}
+
+// NOPROFILE-NOT: Canonicalizer pattern profile
+
+// The profile does not change the rewrites.
+// IR-LABEL: func @add_add_constant
+// IR:         %[[C:.*]] = arith.constant 3 : i32
+// IR-NEXT:    %[[R:.*]] = arith.addi %{{.*}}, %[[C]] : i32
+// IR-NEXT:    return %[[R]]
+func.func @add_add_constant(%arg0: i32) -> i32 {
+  %c1 = arith.constant 1 : i32
+  %c2 = arith.constant 2 : i32
+  %0 = arith.addi %arg0, %c1 : i32
+  %1 = arith.addi %0, %c2 : i32
+  return %1 : i32
+}
@@ -70,6 +70,19 @@ private:
   getOrCreateObjFile(const __tgt_device_image &Image, LLVMContext &Ctx,
                      const std::string &ComputeUnitKind);
 
+  /// Return the key under which the JITed version of \p Image for
+  /// \p ComputeUnitKind is kept in the on-disk cache, or an empty string if
+  /// the cache is disabled.
+  std::string getCacheKey(const __tgt_device_image &Image,
+                          const std::string &ComputeUnitKind);
+
+  /// Read the device image stored under \p Key from the on-disk cache, if any.
+  std::unique_ptr<MemoryBuffer> lookupCache(StringRef Key);
+
+  /// Store the device image \p ImageMB under \p Key in the on-disk cache and
+  /// prune the cache according to its policy. Failures are ignored.
+  void storeInCache(StringRef Key, const MemoryBuffer &ImageMB);
+
   /// Run backend, which contains optimization and code generation.
   Expected<std::unique_ptr<MemoryBuffer>>
   backend(Module &M, const std::string &ComputeUnitKind, unsigned OptLevel);
@@ -112,6 +125,8 @@ private:
       StringEnvar("LIBOMPTARGET_JIT_POST_OPT_IR_MODULE");
   UInt32Envar JITOptLevel = UInt32Envar("LIBOMPTARGET_JIT_OPT_LEVEL", 3);
   BoolEnvar JITSkipOpt = BoolEnvar("LIBOMPTARGET_JIT_SKIP_OPT", false);
+  StringEnvar JITCacheDir = StringEnvar("LIBOMPTARGET_JIT_CACHE_DIR");
+  StringEnvar JITCachePolicy = StringEnvar("LIBOMPTARGET_JIT_CACHE_POLICY");
 };
 
 } // namespace target
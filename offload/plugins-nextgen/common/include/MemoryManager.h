@@ -237,16 +237,18 @@ public:
 
     NodeTy *NodePtr = nullptr;
 
-    // Try to get a node from FreeList
+    // Try to get a node from FreeList. Take the smallest node that is at least
+    // as large as the request, but not one more than twice as large: the last
+    // bucket holds every size up to the threshold.
     {
       const int B = findBucket(Size);
       FreeListTy &List = FreeLists[B];
 
       NodeTy TempNode(Size, nullptr);
       std::lock_guard<std::mutex> LG(FreeListLocks[B]);
-      const auto Itr = List.find(TempNode);
+      const auto Itr = List.lower_bound(TempNode);
 
-      if (Itr != List.end()) {
+      if (Itr != List.end() && Itr->get().Size / 2 < Size) {
         NodePtr = &Itr->get();
         List.erase(Itr);
       }
@@ -16,9 +16,12 @@
 #include "PluginInterface.h"
 #include "omptarget.h"
 
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/CodeGen/CommandFlags.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/LLVMRemarkStreamer.h"
 #include "llvm/IR/LegacyPassManager.h"
@@ -28,7 +31,11 @@
 #include "llvm/Object/IRObjectFile.h"
 #include "llvm/Passes/OptimizationLevel.h"
 #include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
@@ -38,6 +45,12 @@
 #include "llvm/Target/TargetOptions.h"
 #include "llvm/TargetParser/SubtargetFeature.h"
 
+// The header is generated in the LLVM build tree and isn't installed, so it
+// may be missing when offload is built against an installed LLVM.
+#if __has_include("llvm/Support/VCSRevision.h")
+#include "llvm/Support/VCSRevision.h"
+#endif
+
 #include <mutex>
 #include <shared_mutex>
 #include <system_error>
@@ -276,6 +289,95 @@ JITEngine::getOrCreateObjFile(const __tgt_device_image &Image, LLVMContext &Ctx,
   return backend(*Mod, ComputeUnitKind, JITOptLevel);
 }
 
+std::string JITEngine::getCacheKey(const __tgt_device_image &Image,
+                                   const std::string &ComputeUnitKind) {
+  // The replacement and IR dump options exist for debugging the JIT, so they
+  // bypass the cache.
+  if (!JITCacheDir.isPresent() || JITCacheDir.get().empty() ||
+      ReplacementObjectFileName.isPresent() ||
+      ReplacementModuleFileName.isPresent() ||
+      PreOptIRModuleFileName.isPresent() || PostOptIRModuleFileName.isPresent())
+    return "";
+
+  StringRef Binary(reinterpret_cast<const char *>(Image.ImageStart),
+                   target::getPtrDiff(Image.ImageEnd, Image.ImageStart));
+
+  // Everything besides the image that affects the generated code, separated
+  // so that the parts can't run into each other.
+  SHA1 Hasher;
+  Hasher.update(Binary);
+  // Builds of the same version from different revisions may generate
+  // different code, so include the revision when it is known.
+#ifdef LLVM_REVISION
+  StringRef Revision = LLVM_REVISION;
+#else
+  StringRef Revision = "";
+#endif
+  for (StringRef Part :
+       {StringRef(LLVM_VERSION_STRING), Revision, StringRef(TT.str()),
+        StringRef(ComputeUnitKind), StringRef(JITSkipOpt ? "noopt" : "opt")}) {
+    Hasher.update(StringRef("\0", 1));
+    Hasher.update(Part);
+  }
+  Hasher.update(StringRef("\0", 1));
+  Hasher.update(utostr(JITOptLevel.get()));
+
+  // Entries need the prefix to be considered by pruneCache.
+  return "llvmcache-" + toHex(Hasher.result());
+}
+
+std::unique_ptr<MemoryBuffer> JITEngine::lookupCache(StringRef Key) {
+  SmallString<128> Path(JITCacheDir.get());
+  sys::path::append(Path, Key);
+  auto MBOrErr = MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                       /*RequiresNullTerminator=*/false);
+  if (!MBOrErr) {
+    DP("JIT cache miss for %s\n", Path.c_str());
+    return nullptr;
+  }
+  DP("JIT cache hit for %s\n", Path.c_str());
+  return std::move(*MBOrErr);
+}
+
+void JITEngine::storeInCache(StringRef Key, const MemoryBuffer &ImageMB) {
+  const std::string &CacheDir = JITCacheDir.get();
+  if (std::error_code EC = sys::fs::create_directories(CacheDir)) {
+    DP("Could not create JIT cache directory %s: %s\n", CacheDir.c_str(),
+       EC.message().c_str());
+    return;
+  }
+
+  // Write to a temporary file and rename it into place, so that concurrent
+  // processes sharing the directory never read a partial entry.
+  SmallString<128> Path(CacheDir);
+  sys::path::append(Path, Key);
+  SmallString<128> TempPath;
+  int FD;
+  if (sys::fs::createUniqueFile(Twine(Path) + ".tmp-%%%%%%", FD, TempPath))
+    return;
+
+  raw_fd_ostream OS(FD, /*shouldClose=*/true);
+  OS << ImageMB.getBuffer();
+  OS.close();
+  if (OS.has_error()) {
+    OS.clear_error();
+    sys::fs::remove(TempPath);
+    return;
+  }
+  if (sys::fs::rename(TempPath, Path)) {
+    sys::fs::remove(TempPath);
+    return;
+  }
+
+  auto PolicyOrErr = parseCachePruningPolicy(JITCachePolicy.get());
+  if (!PolicyOrErr) {
+    DP("Invalid JIT cache policy: %s\n",
+       toString(PolicyOrErr.takeError()).c_str());
+    return;
+  }
+  pruneCache(CacheDir, *PolicyOrErr);
+}
+
 Expected<const __tgt_device_image *>
 JITEngine::compile(const __tgt_device_image &Image,
                    const std::string &ComputeUnitKind,
@@ -287,15 +389,27 @@ JITEngine::compile(const __tgt_device_image &Image,
   if (__tgt_device_image *JITedImage = CUI.TgtImageMap.lookup(&Image))
     return JITedImage;
 
-  auto ObjMBOrErr = getOrCreateObjFile(Image, CUI.Context, ComputeUnitKind);
-  if (!ObjMBOrErr)
-    return ObjMBOrErr.takeError();
+  // Check if an earlier process already JITed this image.
+  std::string CacheKey = getCacheKey(Image, ComputeUnitKind);
+  std::unique_ptr<MemoryBuffer> ImageMB;
+  if (!CacheKey.empty())
+    ImageMB = lookupCache(CacheKey);
 
-  auto ImageMBOrErr = PostProcessing(std::move(*ObjMBOrErr));
-  if (!ImageMBOrErr)
-    return ImageMBOrErr.takeError();
+  if (!ImageMB) {
+    auto ObjMBOrErr = getOrCreateObjFile(Image, CUI.Context, ComputeUnitKind);
+    if (!ObjMBOrErr)
+      return ObjMBOrErr.takeError();
+
+    auto ImageMBOrErr = PostProcessing(std::move(*ObjMBOrErr));
+    if (!ImageMBOrErr)
+      return ImageMBOrErr.takeError();
+
+    ImageMB = std::move(*ImageMBOrErr);
+    if (!CacheKey.empty())
+      storeInCache(CacheKey, *ImageMB);
+  }
 
-  CUI.JITImages.push_back(std::move(*ImageMBOrErr));
+  CUI.JITImages.push_back(std::move(ImageMB));
   __tgt_device_image *&JITedImage = CUI.TgtImageMap[&Image];
   JITedImage = new __tgt_device_image();
   *JITedImage = Image;
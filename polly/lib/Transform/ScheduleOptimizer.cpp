@@ -52,6 +52,7 @@
 #include "polly/MatmulOptimizer.h"
 #include "polly/Options.h"
 #include "polly/ScheduleTreeTransform.h"
+#include "polly/ScopDetectionDiagnostic.h"
 #include "polly/Support/ISLOStream.h"
 #include "polly/Support/ISLTools.h"
 #include "llvm/ADT/Sequence.h"
@@ -200,6 +201,8 @@ static cl::opt<bool> OptimizedScops(
 
 STATISTIC(ScopsProcessed, "Number of scops processed");
 STATISTIC(ScopsRescheduled, "Number of scops rescheduled");
+STATISTIC(ScopsOutOfQuota,
+          "Number of scops whose rescheduling exceeded the ISL quota");
 STATISTIC(ScopsOptimized, "Number of scops optimized");
 
 STATISTIC(NumAffineLoopsOptimized, "Number of affine loops optimized");
@@ -873,14 +876,25 @@ static void runIslScheduleOptimizer(
       IslMaxOperationsGuard MaxOpGuard(Ctx, ScheduleComputeOut);
       Schedule = SC.compute_schedule();
 
-      if (MaxOpGuard.hasQuotaExceeded())
+      if (MaxOpGuard.hasQuotaExceeded()) {
         POLLY_DEBUG(
             dbgs() << "Schedule optimizer calculation exceeds ISL quota\n");
+        ScopsOutOfQuota++;
+        if (ORE) {
+          DebugLoc Begin, End;
+          getDebugLocations(getBBPairForRegion(&S.getRegion()), Begin, End);
+          ORE->emit(OptimizationRemarkAnalysis(DEBUG_TYPE, "OutOfQuota", Begin,
+                                               S.getEntry())
+                    << "maximal number of operations exceeded during "
+                       "rescheduling; the original schedule is kept");
+        }
+      }
     }
 
     isl_options_set_on_error(Ctx, OnErrorStatus);
 
-    ScopsRescheduled++;
+    if (!Schedule.is_null())
+      ScopsRescheduled++;
     POLLY_DEBUG(printSchedule(dbgs(), Schedule, "After rescheduling"));
   }
 